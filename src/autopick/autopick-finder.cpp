@@ -9,6 +9,7 @@
 #include "autopick/autopick-dirty-flags.h"
 #include "autopick/autopick-entry.h"
 #include "autopick/autopick-matcher.h"
+#include "autopick/autopick-rule-index.h"
 #include "autopick/autopick-util.h"
 #include "core/show-file.h"
 #include "flavor/flavor-describer.h"
@@ -35,20 +36,7 @@
  */
 int find_autopick_list(PlayerType *player_ptr, const ItemEntity *o_ptr)
 {
-    if (o_ptr->bi_key.tval() == ItemKindType::GOLD) {
-        return -1;
-    }
-
-    auto item_name = describe_flavor(player_ptr, o_ptr, (OD_NO_FLAVOR | OD_OMIT_PREFIX | OD_NO_PLURAL));
-    str_tolower(item_name.data());
-    for (auto i = 0U; i < autopick_list.size(); i++) {
-        const auto &entry = autopick_list[i];
-        if (is_autopick_match(player_ptr, o_ptr, entry, item_name)) {
-            return i;
-        }
-    }
-
-    return -1;
+    return AutopickRuleIndex::get_instance().find(player_ptr, o_ptr);
 }
 
 /*!
@@ -29,22 +29,27 @@
 #include "system/player-type-definition.h"
 #include "util/string-processor.h"
 
-static bool check_item_features(PlayerType *player_ptr, const autopick_type &entry, const ItemEntity &item, const ItemKindType tval)
+/*!
+ * @brief 種別を表すキーワード (「武器」「防具」等) がアイテムのベースアイテム種別に一致するかを調べる
+ * @details 「得意武器」はクラス毎に異なるため、ここでは近接武器であるかのみを調べる.
+ */
+static bool check_item_features(const autopick_type &entry, const BaseitemKey &bi_key)
 {
+    const auto tval = bi_key.tval();
     if (entry.has(FLG_WEAPONS)) {
-        return item.is_weapon();
+        return bi_key.is_weapon();
     }
 
     if (entry.has(FLG_FAVORITE_WEAPONS)) {
-        return object_is_favorite(player_ptr, &item);
+        return bi_key.is_melee_weapon();
     }
 
     if (entry.has(FLG_ARMORS)) {
-        return item.is_protector();
+        return bi_key.is_protector();
     }
 
     if (entry.has(FLG_MISSILES)) {
-        return item.is_ammo();
+        return bi_key.is_ammo();
     }
 
     if (entry.has(FLG_DEVICES)) {
@@ -80,7 +85,7 @@ static bool check_item_features(PlayerType *player_ptr, const autopick_type &ent
     }
 
     if (entry.has(FLG_SPELLBOOKS)) {
-        return item.is_spell_book();
+        return bi_key.is_spell_book();
     }
 
     if (entry.has(FLG_HAFTED)) {
@@ -104,7 +109,7 @@ static bool check_item_features(PlayerType *player_ptr, const autopick_type &ent
     }
 
     if (entry.has(FLG_SUITS)) {
-        return item.is_armour();
+        return bi_key.is_armour();
     }
 
     if (entry.has(FLG_CLOAKS)) {
@@ -127,9 +132,47 @@ static bool check_item_features(PlayerType *player_ptr, const autopick_type &ent
 }
 
 /*!
- * @brief A function for Auto-picker/destroyer Examine whether the object matches to the entry
+ * @brief 自動拾い/破壊設定の行が、あるベースアイテム種別のアイテムに一致し得るかを調べる
+ * @param entry 自動拾い/破壊設定の行
+ * @param bi_key ベースアイテム種別 (svalは参照しない)
+ * @return 一致し得るか
+ * @details 行のキーワードのうち、tvalだけで判定できる条件を調べる.
+ * 偽を返したなら、そのtvalのアイテムは他の条件に関わらずその行に一致しない.
  */
-bool is_autopick_match(PlayerType *player_ptr, const ItemEntity *o_ptr, const autopick_type &entry, std::string_view item_name)
+bool is_autopick_kind_match(const autopick_type &entry, const BaseitemKey &bi_key)
+{
+    const auto tval = bi_key.tval();
+    if (entry.has(FLG_BOOSTED) && !bi_key.is_melee_weapon()) {
+        return false;
+    }
+
+    if ((entry.has(FLG_GOOD) || entry.has(FLG_NAMELESS) || entry.has(FLG_AVERAGE)) && !bi_key.is_equipement()) {
+        return false;
+    }
+
+    if (entry.has(FLG_UNIQUE) && (tval != ItemKindType::CORPSE) && (tval != ItemKindType::STATUE)) {
+        return false;
+    }
+
+    if (entry.has(FLG_HUMAN) && (tval != ItemKindType::CORPSE)) {
+        return false;
+    }
+
+    if ((entry.has(FLG_FIRST) || entry.has(FLG_SECOND) || entry.has(FLG_THIRD) || entry.has(FLG_FOURTH)) && !bi_key.is_spell_book()) {
+        return false;
+    }
+
+    return check_item_features(entry, bi_key);
+}
+
+/*!
+ * @brief アイテムが自動拾い/破壊設定の行の、名前と「収集中の」以外の条件に一致するかを調べる
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param o_ptr アイテムへの参照ポインタ
+ * @param entry 自動拾い/破壊設定の行
+ * @return 一致するか
+ */
+bool is_autopick_match_except_name(PlayerType *player_ptr, const ItemEntity *o_ptr, const autopick_type &entry)
 {
     if (entry.has(FLG_UNAWARE) && o_ptr->is_aware()) {
         return false;
@@ -337,20 +380,41 @@ bool is_autopick_match(PlayerType *player_ptr, const ItemEntity *o_ptr, const au
         return false;
     }
 
-    if (!check_item_features(player_ptr, entry, *o_ptr, tval)) {
+    if (!is_autopick_kind_match(entry, bi_key)) {
+        return false;
+    }
+
+    if (!entry.has(FLG_WEAPONS) && entry.has(FLG_FAVORITE_WEAPONS) && !object_is_favorite(player_ptr, o_ptr)) {
         return false;
     }
 
+    return true;
+}
+
+/*!
+ * @brief アイテム名が自動拾い/破壊設定の行の名前に一致するかを調べる
+ * @param entry 自動拾い/破壊設定の行
+ * @param item_name 小文字に変換したアイテム名
+ * @return 一致するか
+ */
+bool is_autopick_name_match(const autopick_type &entry, std::string_view item_name)
+{
     if (entry.name[0] == '^') {
-        if (!item_name.starts_with(std::string_view(entry.name).substr(1))) {
-            return false;
-        }
-    } else {
-        if (!str_find(std::string(item_name), entry.name)) {
-            return false;
-        }
+        return item_name.starts_with(std::string_view(entry.name).substr(1));
     }
 
+    return str_find(std::string(item_name), entry.name);
+}
+
+/*!
+ * @brief 「収集中の」の条件に一致するかを調べる
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param o_ptr アイテムへの参照ポインタ
+ * @param entry 自動拾い/破壊設定の行
+ * @return 一致するか (「収集中の」を含まない行なら常に真)
+ */
+bool is_autopick_collecting_match(PlayerType *player_ptr, const ItemEntity *o_ptr, const autopick_type &entry)
+{
     if (!entry.has(FLG_COLLECTING)) {
         return true;
     }
@@ -368,3 +432,19 @@ bool is_autopick_match(PlayerType *player_ptr, const ItemEntity *o_ptr, const au
 
     return false;
 }
+
+/*!
+ * @brief A function for Auto-picker/destroyer Examine whether the object matches to the entry
+ */
+bool is_autopick_match(PlayerType *player_ptr, const ItemEntity *o_ptr, const autopick_type &entry, std::string_view item_name)
+{
+    if (!is_autopick_match_except_name(player_ptr, o_ptr, entry)) {
+        return false;
+    }
+
+    if (!is_autopick_name_match(entry, item_name)) {
+        return false;
+    }
+
+    return is_autopick_collecting_match(player_ptr, o_ptr, entry);
+}
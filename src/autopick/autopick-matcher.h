@@ -4,6 +4,11 @@
 #include <string_view>
 
 struct autopick_type;
+class BaseitemKey;
 class ItemEntity;
 class PlayerType;
+bool is_autopick_kind_match(const autopick_type &entry, const BaseitemKey &bi_key);
+bool is_autopick_match_except_name(PlayerType *player_ptr, const ItemEntity *o_ptr, const autopick_type &entry);
+bool is_autopick_name_match(const autopick_type &entry, std::string_view item_name);
+bool is_autopick_collecting_match(PlayerType *player_ptr, const ItemEntity *o_ptr, const autopick_type &entry);
 bool is_autopick_match(PlayerType *player_ptr, const ItemEntity *o_ptr, const autopick_type &entry, std::string_view item_name);
@@ -1,5 +1,6 @@
 #include "autopick/autopick-pref-processor.h"
 #include "autopick/autopick-entry.h"
+#include "autopick/autopick-rule-index.h"
 #include "autopick/autopick-util.h"
 #include "system/angband.h"
 
@@ -34,4 +35,5 @@ void process_autopick_file_command(char *buf)
     }
 
     autopick_list.push_back(std::move(entry));
+    AutopickRuleIndex::get_instance().invalidate();
 }
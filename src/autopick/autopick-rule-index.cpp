@@ -0,0 +1,150 @@
+#include "autopick/autopick-rule-index.h"
+#include "autopick/autopick-matcher.h"
+#include "autopick/autopick-util.h"
+#include "core/show-file.h"
+#include "flavor/flavor-describer.h"
+#include "flavor/object-flavor-types.h"
+#include "object/tval-types.h"
+#include "system/angband.h"
+#include "system/item-entity.h"
+#include "util/string-processor.h"
+#include <optional>
+
+AutopickRuleIndex AutopickRuleIndex::instance{};
+
+AutopickRuleIndex &AutopickRuleIndex::get_instance()
+{
+    return instance;
+}
+
+/*!
+ * @brief 索引を破棄する
+ * @details autopick_list の行を追加・削除・変更した時に呼ぶ.
+ */
+void AutopickRuleIndex::invalidate()
+{
+    this->is_compiled = false;
+}
+
+/*!
+ * @brief 与えられたアイテムに一致する自動拾い/破壊設定の行を検索する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param o_ptr アイテムへの参照ポインタ
+ * @return 最初に一致した行の番号、なかったら-1
+ * @details autopick_list の全ての行を先頭から is_autopick_match() で調べた時と同じ行を返す.
+ */
+int AutopickRuleIndex::find(PlayerType *player_ptr, const ItemEntity *o_ptr)
+{
+    const auto tval = o_ptr->bi_key.tval();
+    if (tval == ItemKindType::GOLD) {
+        return -1;
+    }
+
+    if (!this->is_compiled) {
+        this->compile();
+    }
+
+    auto it = this->candidates.find(tval);
+    if (it == this->candidates.end()) {
+        std::vector<int> rule_indices;
+        const BaseitemKey bi_key(tval);
+        for (auto i = 0; i < std::ssize(autopick_list); i++) {
+            if (is_autopick_kind_match(autopick_list[i], bi_key)) {
+                rule_indices.push_back(i);
+            }
+        }
+
+        it = this->candidates.emplace(tval, std::move(rule_indices)).first;
+    }
+
+    std::optional<NameMatches> name_matches;
+    for (const auto i : it->second) {
+        const auto &entry = autopick_list[i];
+        const auto pattern_id = this->pattern_ids[i];
+        const auto has_name_matched = [&] {
+            const auto &matches = (entry.name[0] == '^') ? name_matches->is_prefix : name_matches->is_found;
+            return matches[pattern_id];
+        };
+
+        // アイテム名を照合済なら、他の条件より先に名前で絞り込む
+        if ((pattern_id >= 0) && name_matches && !has_name_matched()) {
+            continue;
+        }
+
+        if (!is_autopick_match_except_name(player_ptr, o_ptr, entry)) {
+            continue;
+        }
+
+        if ((pattern_id >= 0) && !name_matches) {
+            auto item_name = describe_flavor(player_ptr, o_ptr, (OD_NO_FLAVOR | OD_OMIT_PREFIX | OD_NO_PLURAL));
+            str_tolower(item_name.data());
+            name_matches = this->match_names(item_name);
+            if (!has_name_matched()) {
+                continue;
+            }
+        }
+
+        if (is_autopick_collecting_match(player_ptr, o_ptr, entry)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/*!
+ * @brief autopick_list から索引を作る
+ * @details tval毎の行の振り分けは、そのtvalのアイテムを初めて照合する時に行う.
+ */
+void AutopickRuleIndex::compile()
+{
+    this->candidates.clear();
+    this->pattern_ids.clear();
+    this->name_matcher.clear();
+    for (const auto &entry : autopick_list) {
+        std::string_view pattern(entry.name);
+        if (pattern.starts_with('^')) {
+            pattern.remove_prefix(1);
+        }
+
+        this->pattern_ids.push_back(pattern.empty() ? -1 : this->name_matcher.add(pattern));
+    }
+
+    this->name_matcher.build();
+    this->is_compiled = true;
+}
+
+/*!
+ * @brief アイテム名に一致する名前のパターンを全て求める
+ * @param item_name 小文字に変換したアイテム名
+ * @return パターン毎の照合結果
+ * @details 先頭以外での一致は、angband_strstr() と同じく全角文字の2バイト目から始まるものを除く.
+ */
+AutopickRuleIndex::NameMatches AutopickRuleIndex::match_names(std::string_view item_name) const
+{
+#ifdef JP
+    std::vector<bool> is_char_boundary(item_name.length() + 1);
+    for (auto i = 0; i < std::ssize(item_name); i++) {
+        is_char_boundary[i] = true;
+        if (iskanji(item_name[i])) {
+            i++;
+        }
+    }
+#endif
+
+    NameMatches matches{ std::vector<bool>(this->name_matcher.size()), std::vector<bool>(this->name_matcher.size()) };
+    this->name_matcher.for_each_match(item_name, [&](int pattern_id, int position) {
+        if (position == 0) {
+            matches.is_prefix[pattern_id] = true;
+        }
+
+#ifdef JP
+        if (!is_char_boundary[position]) {
+            return;
+        }
+#endif
+        matches.is_found[pattern_id] = true;
+    });
+
+    return matches;
+}
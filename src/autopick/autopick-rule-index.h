@@ -0,0 +1,49 @@
+#pragma once
+
+#include "util/aho-corasick-matcher.h"
+#include <map>
+#include <string>
+#include <vector>
+
+enum class ItemKindType : short;
+class ItemEntity;
+class PlayerType;
+
+/*!
+ * @brief 自動拾い/破壊設定のリストをアイテムとの照合用に変換した索引
+ * @details autopick_list をtval毎に一致し得る行の番号の列へ振り分け、行の名前は1つのAho-Corasickオートマトンにまとめる.
+ * アイテムの照合ではそのtvalの行だけを先頭から順に調べ、名前の条件まで辿り着いた時に初めてアイテム名を作る.
+ * autopick_list を変更した時は invalidate() を呼ぶこと. 次の照合の時に作り直す.
+ */
+class AutopickRuleIndex {
+public:
+    AutopickRuleIndex(const AutopickRuleIndex &) = delete;
+    AutopickRuleIndex(AutopickRuleIndex &&) = delete;
+    AutopickRuleIndex &operator=(const AutopickRuleIndex &) = delete;
+    AutopickRuleIndex &operator=(AutopickRuleIndex &&) = delete;
+
+    static AutopickRuleIndex &get_instance();
+    void invalidate();
+    int find(PlayerType *player_ptr, const ItemEntity *o_ptr);
+
+private:
+    AutopickRuleIndex() = default;
+
+    static AutopickRuleIndex instance;
+
+    /*!
+     * @brief 1つのアイテム名に対する名前の照合結果
+     */
+    struct NameMatches {
+        std::vector<bool> is_prefix; //!< パターン番号毎の、アイテム名の先頭に一致したか
+        std::vector<bool> is_found; //!< パターン番号毎の、アイテム名の文字の境界から始まる位置に一致したか
+    };
+
+    bool is_compiled = false;
+    std::map<ItemKindType, std::vector<int>> candidates; //!< tval毎の、一致し得る行の番号 (昇順)
+    std::vector<int> pattern_ids; //!< 行毎の名前のパターン番号 (名前を照合する必要がなければ-1)
+    AhoCorasickMatcher name_matcher;
+
+    void compile();
+    NameMatches match_names(std::string_view item_name) const;
+};
@@ -10,6 +10,7 @@
 #include "dungeon/quest.h"
 #include "floor/cave.h"
 #include "floor/floor-mode-changer.h"
+#include "floor/next-floor-preparer.h"
 #include "floor/wild.h"
 #include "game-option/birth-options.h"
 #include "game-option/input-options.h"
@@ -330,6 +331,7 @@ void do_cmd_go_down(PlayerType *player_ptr)
         return;
     }
 
+    NextFloorPreparer::get_instance().start_descent();
     if (terrain.flags.has(TerrainCharacteristics::SHAFT)) {
         prepare_change_floor_mode(player_ptr, CFM_SAVE_FLOORS | CFM_DOWN | CFM_SHAFT);
     } else {
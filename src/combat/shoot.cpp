@@ -48,6 +48,7 @@
 #include "player/player-skill.h"
 #include "player/player-status-table.h"
 #include "sv-definition/sv-bow-types.h"
+#include "system/angband-system.h"
 #include "system/artifact-type-definition.h"
 #include "system/baseitem-info.h"
 #include "system/floor-type-definition.h"
@@ -459,6 +460,7 @@ static MULTIPLY calc_shot_damage_with_slay(
  */
 void exe_fire(PlayerType *player_ptr, INVENTORY_IDX i_idx, ItemEntity *j_ptr, SPELL_IDX snipe_type)
 {
+    RngStreamSelector rng_selector(RngStream::COMBAT);
     POSITION y, x, ny, nx, ty, tx, prev_y, prev_x;
     ItemEntity forge;
     ItemEntity *q_ptr;
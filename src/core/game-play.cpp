@@ -175,7 +175,9 @@ static void init_random_seed(PlayerType *player_ptr, bool new_game)
         process_player_name(player_ptr);
     }
 
-    if (init_random_seed) {
+    if (new_game && arg_random_seed) {
+        Rand_state_init(*arg_random_seed);
+    } else if (init_random_seed) {
         Rand_state_init();
     }
 }
@@ -367,9 +369,11 @@ static void decide_arena_death(PlayerType *player_ptr)
 static void process_game_turn(PlayerType *player_ptr)
 {
     bool load_game = true;
-    auto *floor_ptr = player_ptr->current_floor_ptr;
     while (true) {
         process_dungeon(player_ptr, load_game);
+
+        // 先行生成したフロアへの差し替えで現在のフロアの実体が変わるため、毎回取得し直す
+        auto *floor_ptr = player_ptr->current_floor_ptr;
         w_ptr->character_xtra = true;
         handle_stuff(player_ptr);
         w_ptr->character_xtra = false;
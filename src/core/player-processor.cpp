@@ -9,9 +9,11 @@
 #include "floor/floor-save-util.h"
 #include "floor/floor-util.h"
 #include "floor/geometry.h"
+#include "floor/next-floor-preparer.h"
 #include "floor/wild.h"
 #include "game-option/cheat-options.h"
 #include "game-option/disturbance-options.h"
+#include "game-option/game-play-options.h"
 #include "game-option/map-screen-options.h"
 #include "grid/grid.h"
 #include "inventory/pack-overflow.h"
@@ -55,10 +57,12 @@
 #include "system/player-type-definition.h"
 #include "system/redrawing-flags-updater.h"
 #include "term/screen-processor.h"
+#include "term/z-term.h"
 #include "timed-effect/timed-effects.h"
 #include "util/bit-flags-calculator.h"
 #include "view/display-messages.h"
 #include "window/display-sub-windows.h"
+#include "world/idle-turn-counter.h"
 #include "world/world-turn-processor.h"
 
 bool load = true;
@@ -97,6 +101,29 @@ bool continuous_action_running(PlayerType *player_ptr)
     return player_ptr->running || travel.run || command_rep || (player_ptr->action == ACTION_REST) || (player_ptr->action == ACTION_FISH);
 }
 
+/*!
+ * @brief キー入力を待つ間に、足元の下り階段の先のフロアを先行生成する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @details 既に入力されたキーやキーマップの残りがある時は、すぐに次のコマンドを実行するため生成しない.
+ * 生成は途中で中断できず、その間はキー入力を受け付けないため、オプションで有効にした時だけ行う.
+ */
+static void prepare_next_floor_while_idle(PlayerType *player_ptr)
+{
+    if (!prepare_next_floor || command_new || (inkey_next && *inkey_next)) {
+        return;
+    }
+
+    char ch;
+    if (term_inkey(&ch, false, false) == 0) {
+        return;
+    }
+
+    if (NextFloorPreparer::get_instance().prepare(player_ptr)) {
+        handle_stuff(player_ptr);
+        move_cursor_relative(player_ptr->y, player_ptr->x);
+    }
+}
+
 /*!
  * @brief プレイヤーの行動処理 / Process the player
  * @note
@@ -311,6 +338,7 @@ void process_player(PlayerType *player_ptr)
             };
             rfu.set_flags(flags);
             window_stuff(player_ptr);
+            prepare_next_floor_while_idle(player_ptr);
 
             can_save = true;
             InputKeyRequestor(player_ptr, false).request_command();
@@ -459,3 +487,36 @@ void process_upkeep_with_speed(PlayerType *player_ptr)
         player_ptr->enchant_energy_need += ENERGY_NEED();
     }
 }
+
+/*!
+ * @brief プレイヤーが行動せずに経過するゲームターン数を数える
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param counter ゲームターン数を数えるカウンタ
+ * @details process_player() 及び process_upkeep_with_speed() が行動エネルギーを減らす以外に何もしない間を数える.
+ */
+void count_player_idle_turns(PlayerType *player_ptr, IdleTurnCounter &counter)
+{
+    auto is_idle = !load && !player_ptr->leaving;
+    is_idle &= !player_ptr->hack_mutation && !player_ptr->invoking_midnight_curse;
+    is_idle &= !AngbandSystem::get_instance().is_phase_out();
+    if (!is_idle) {
+        counter.limit(0);
+        return;
+    }
+
+    const auto energy_gain = speed_to_energy(player_ptr->pspeed);
+    counter.add_energy(player_ptr->energy_need, energy_gain);
+    counter.add_energy(player_ptr->enchant_energy_need, energy_gain);
+}
+
+/*!
+ * @brief プレイヤーが行動しないゲームターンを一括で経過させる
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param turns 経過させるゲームターン数 (count_player_idle_turns() で数えた数以下であること)
+ */
+void skip_player_idle_turns(PlayerType *player_ptr, int turns)
+{
+    const auto energy = turns * speed_to_energy(player_ptr->pspeed);
+    player_ptr->energy_need -= static_cast<ENERGY>(energy);
+    player_ptr->enchant_energy_need -= static_cast<ENERGY>(energy);
+}
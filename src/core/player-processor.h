@@ -3,7 +3,10 @@
 extern bool load; /*!<ロード処理中の分岐フラグ*/
 extern bool can_save;
 
+class IdleTurnCounter;
 class PlayerType;
 bool continuous_action_running(PlayerType *player_ptr);
 void process_player(PlayerType *player_ptr);
 void process_upkeep_with_speed(PlayerType *player_ptr);
+void count_player_idle_turns(PlayerType *player_ptr, IdleTurnCounter &counter);
+void skip_player_idle_turns(PlayerType *player_ptr, int turns);
@@ -12,6 +12,7 @@
 #include "floor/floor-save-util.h"
 #include "floor/floor-save.h"
 #include "game-option/cheat-options.h"
+#include "game-option/game-play-options.h"
 #include "game-option/map-screen-options.h"
 #include "game-option/play-record-options.h"
 #include "hpmp/hp-mp-regenerator.h"
@@ -40,6 +41,7 @@
 #include "target/target-checker.h"
 #include "util/bit-flags-calculator.h"
 #include "view/display-messages.h"
+#include "world/idle-turn-counter.h"
 #include "world/world-turn-processor.h"
 #include "world/world.h"
 
@@ -83,6 +85,43 @@ static void redraw_character_xtra(PlayerType *player_ptr)
     w_ptr->character_xtra = false;
 }
 
+/*!
+ * @brief 誰も行動しないゲームターンを一括で進める
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @details プレイヤーもモンスターも行動せず、ゲーム世界全体の処理も何もしないゲームターンでは、
+ * 行動エネルギーが減る以外に何も変わらない. そのようなゲームターンが続く間の処理を省き、
+ * 1ゲームターンずつ処理した場合と同じ状態 (乱数の状態を含む) まで一度に進める.
+ */
+static void skip_idle_game_turns(PlayerType *player_ptr)
+{
+    if (!skip_idle_turns || player_ptr->wild_mode || wild_regen) {
+        return;
+    }
+
+    const auto &floor = *player_ptr->current_floor_ptr;
+    auto should_compact = (floor.m_cnt + 32 > MAX_FLOOR_MONSTERS) || (floor.m_cnt + 32 < floor.m_max);
+    should_compact |= (floor.o_cnt + 32 > MAX_FLOOR_ITEMS) || (floor.o_cnt + 32 < floor.o_max);
+    if (should_compact) {
+        return;
+    }
+
+    IdleTurnCounter counter(w_ptr->game_turn_limit - w_ptr->game_turn - 1);
+    count_player_idle_turns(player_ptr, counter);
+    count_monster_idle_turns(player_ptr, counter);
+    WorldTurnProcessor(player_ptr).count_idle_turns(counter);
+    const auto turns = counter.get_turns();
+    if (turns == 0) {
+        return;
+    }
+
+    skip_player_idle_turns(player_ptr, turns);
+    skip_monster_idle_turns(player_ptr, turns);
+    w_ptr->game_turn += turns;
+    if (w_ptr->dungeon_turn < w_ptr->dungeon_turn_limit) {
+        w_ptr->dungeon_turn = std::min<GAME_TURN>(w_ptr->dungeon_turn + turns, w_ptr->dungeon_turn_limit);
+    }
+}
+
 /*!
  * process_player()、process_world() をcore.c から移設するのが先.
  * process_upkeep_with_speed() はこの関数と同じところでOK
@@ -228,6 +267,10 @@ void process_dungeon(PlayerType *player_ptr, bool load_game)
             compact_objects(player_ptr, 0);
         }
 
+        if (!is_watching) {
+            skip_idle_game_turns(player_ptr);
+        }
+
         process_player(player_ptr);
         process_upkeep_with_speed(player_ptr);
         handle_stuff(player_ptr);
@@ -37,7 +37,53 @@
 #include "target/projection-path-calculator.h"
 #include "timed-effect/timed-effects.h"
 #include "util/bit-flags-calculator.h"
+#include "util/finalizer.h"
 #include "view/display-messages.h"
+#include <deque>
+
+namespace {
+/*!
+ * @brief project() 1回分の作業領域
+ */
+struct ProjectionScratch {
+    ProjectionArea area; //!< 効果範囲
+    std::vector<int> dists; //!< 効果範囲の各グリッドにおける中心からの実効距離
+};
+
+/*!
+ * @brief project() の作業領域の置き場
+ * @details project() は反射や誘爆によって再帰的に呼ばれるため、呼び出しの深さ毎に作業領域を持つ.
+ * 一度確保したメモリは以後の呼び出しで使い回す.
+ */
+class ProjectionArena {
+public:
+    ProjectionScratch &acquire();
+    void release();
+
+private:
+    std::deque<ProjectionScratch> scratches; //!< 深い呼び出しで要素が増えても既存の要素への参照が無効にならないようdequeで持つ
+    size_t depth = 0;
+};
+
+ProjectionScratch &ProjectionArena::acquire()
+{
+    if (this->depth == this->scratches.size()) {
+        this->scratches.emplace_back();
+    }
+
+    auto &scratch = this->scratches[this->depth++];
+    scratch.area.clear();
+    scratch.dists.clear();
+    return scratch;
+}
+
+void ProjectionArena::release()
+{
+    this->depth--;
+}
+
+ProjectionArena projection_arena;
+}
 
 /*!
  * @brief 汎用的なビーム/ボルト/ボール系処理のルーチン Generic
@@ -53,6 +99,8 @@
  * @param typ 効果属性 / Type of damage to apply to monsters (and objects)
  * @param flag 効果フラグ / Extra bit flags (see PROJECT_xxxx)
  * @param monspell 効果元のモンスター魔法ID
+ * @details 効果範囲は再帰呼び出しの深さ毎に使い回す作業領域に求め、
+ * アイテムやモンスターへの効果はそれらがいるグリッドに対してのみ処理する.
  * @todo 似たような処理が山ほど並んでいる、何とかならないものか
  * @todo 引数にそのまま再代入していてカオスすぎる。直すのは簡単ではない
  */
@@ -66,10 +114,11 @@ ProjectResult project(PlayerType *player_ptr, const MONSTER_IDX src_idx, POSITIO
     bool breath = false;
     bool old_hide = false;
     int path_n = 0;
-    int grids = 0;
-    POSITION gx[1024]{};
-    POSITION gy[1024]{};
-    POSITION gm[32]{};
+    auto &scratch = projection_arena.acquire();
+    const auto finalizer = util::make_finalizer([] {
+        projection_arena.release();
+    });
+    auto &area = scratch.area;
     rakubadam_p = 0;
     rakubadam_m = 0;
     monster_target_y = player_ptr->y;
@@ -107,14 +156,8 @@ ProjectResult project(PlayerType *player_ptr, const MONSTER_IDX src_idx, POSITIO
         flag |= PROJECT_HIDE;
     }
 
-    for (auto dist = 0; dist < 32; dist++) {
-        gm[dist] = 0;
-    }
-
     if (flag & (PROJECT_BEAM)) {
-        gy[grids] = y1;
-        gx[grids] = x1;
-        grids++;
+        area.positions.emplace_back(y1, x1);
     }
 
     switch (typ) {
@@ -137,14 +180,16 @@ ProjectResult project(PlayerType *player_ptr, const MONSTER_IDX src_idx, POSITIO
     /* Calculate the projection path */
     const auto &system = AngbandSystem::get_instance();
     ProjectionPath path_g(player_ptr, (project_length ? project_length : system.get_max_range()), { y1, x1 }, { y2, x2 }, flag);
-    handle_stuff(player_ptr);
+    const auto is_blind = player_ptr->effects()->blindness().is_blind();
+    if (!is_blind && (delay_factor > 0)) {
+        handle_stuff(player_ptr);
+    }
 
     int k = 0;
     auto oy = y1;
     auto ox = x1;
     auto visual = false;
     bool see_s_msg = true;
-    const auto is_blind = player_ptr->effects()->blindness().is_blind();
     auto &floor = *player_ptr->current_floor_ptr;
     for (const auto &[ny, nx] : path_g) {
         const Pos2D pos(ny, nx);
@@ -162,9 +207,7 @@ ProjectResult project(PlayerType *player_ptr, const MONSTER_IDX src_idx, POSITIO
             }
         }
         if (flag & (PROJECT_BEAM)) {
-            gy[grids] = ny;
-            gx[grids] = nx;
-            grids++;
+            area.positions.push_back(pos);
         }
 
         if (delay_factor > 0) {
@@ -202,15 +245,14 @@ ProjectResult project(PlayerType *player_ptr, const MONSTER_IDX src_idx, POSITIO
         }
     }
 
-    gm[0] = 0;
-    gm[1] = grids;
+    area.set_boundary(0);
     project_length = 0;
 
     POSITION gm_rad = rad;
     /* If we found a "target", explode there */
     if (path_n <= system.get_max_range()) {
-        if ((flag & (PROJECT_BEAM)) && (grids > 0)) {
-            grids--;
+        if ((flag & (PROJECT_BEAM)) && !area.positions.empty()) {
+            area.positions.pop_back();
         }
 
         /*
@@ -224,57 +266,34 @@ ProjectResult project(PlayerType *player_ptr, const MONSTER_IDX src_idx, POSITIO
          */
         if (breath) {
             flag &= ~(PROJECT_HIDE);
-            breath_shape(player_ptr, path_g, path_n, &grids, gx, gy, gm, &gm_rad, rad, y1, x1, by, bx, typ);
+            gm_rad = breath_shape(player_ptr, path_g, path_n, area, rad, y1, x1, by, bx, typ);
         } else {
-            for (auto dist = 0; dist <= rad; dist++) {
-                for (auto y = by - dist; y <= by + dist; y++) {
-                    for (auto x = bx - dist; x <= bx + dist; x++) {
-                        if (!in_bounds2(player_ptr->current_floor_ptr, y, x)) {
-                            continue;
-                        }
-                        if (distance(by, bx, y, x) != dist) {
-                            continue;
-                        }
-
-                        switch (typ) {
-                        case AttributeType::LITE:
-                        case AttributeType::LITE_WEAK:
-                            if (!los(player_ptr, by, bx, y, x)) {
-                                continue;
-                            }
-                            break;
-                        case AttributeType::DISINTEGRATE:
-                            if (!in_disintegration_range(player_ptr->current_floor_ptr, by, bx, y, x)) {
-                                continue;
-                            }
-                            break;
-                        default:
-                            if (!projectable(player_ptr, by, bx, y, x)) {
-                                continue;
-                            }
-                            break;
-                        }
-
-                        gy[grids] = y;
-                        gx[grids] = x;
-                        grids++;
-                    }
-                }
-
-                gm[dist + 1] = grids;
-            }
+            ball_shape(player_ptr, area, rad, by, bx, typ);
         }
     }
 
-    if (!grids) {
+    if (area.positions.empty()) {
         return res;
     }
 
+    /* Find the closest point in the blast */
+    const auto &positions = area.positions;
+    const int grids = positions.size();
+    auto &dists = scratch.dists;
+    auto layer = 0;
+    for (int i = 0; i < grids; i++) {
+        if (area.get_boundary(layer + 1) == i) {
+            layer++;
+        }
+
+        dists.push_back(breath ? dist_to_line(positions[i].y, positions[i].x, y1, x1, by, bx) : layer);
+    }
+
     if (!is_blind && !(flag & (PROJECT_HIDE)) && (delay_factor > 0)) {
         auto drawn = false;
         for (int t = 0; t <= gm_rad; t++) {
-            for (int i = gm[t]; i < gm[t + 1]; i++) {
-                const Pos2D pos(gy[i], gx[i]);
+            for (int i = area.get_boundary(t); i < area.get_boundary(t + 1); i++) {
+                const auto &pos = positions[i];
                 if (panel_contains(pos.y, pos.x) && floor.has_los(pos)) {
                     drawn = true;
                     print_bolt_pict(player_ptr, pos.y, pos.x, pos.y, pos.x, typ);
@@ -289,8 +308,7 @@ ProjectResult project(PlayerType *player_ptr, const MONSTER_IDX src_idx, POSITIO
         }
 
         if (drawn) {
-            for (int i = 0; i < grids; i++) {
-                const Pos2D pos(gy[i], gx[i]);
+            for (const auto &pos : positions) {
                 if (panel_contains(pos.y, pos.x) && floor.has_los(pos)) {
                     lite_spot(player_ptr, pos.y, pos.x);
                 }
@@ -309,45 +327,23 @@ ProjectResult project(PlayerType *player_ptr, const MONSTER_IDX src_idx, POSITIO
     }
 
     if (flag & (PROJECT_GRID)) {
-        auto dist = 0;
         for (int i = 0; i < grids; i++) {
-            if (gm[dist + 1] == i) {
-                dist++;
-            }
-            auto y = gy[i];
-            auto x = gx[i];
-            if (breath) {
-                int d = dist_to_line(y, x, y1, x1, by, bx);
-                if (affect_feature(player_ptr, src_idx, d, y, x, dam, typ)) {
-                    res.notice = true;
-                }
-            } else {
-                if (affect_feature(player_ptr, src_idx, dist, y, x, dam, typ)) {
-                    res.notice = true;
-                }
+            if (affect_feature(player_ptr, src_idx, dists[i], positions[i].y, positions[i].x, dam, typ)) {
+                res.notice = true;
             }
         }
     }
 
     update_creature(player_ptr);
     if (flag & (PROJECT_ITEM)) {
-        auto dist = 0;
         for (int i = 0; i < grids; i++) {
-            if (gm[dist + 1] == i) {
-                dist++;
+            const auto &pos = positions[i];
+            if (floor.get_grid(pos).o_idx_list.empty()) {
+                continue;
             }
 
-            auto y = gy[i];
-            auto x = gx[i];
-            if (breath) {
-                int d = dist_to_line(y, x, y1, x1, by, bx);
-                if (affect_item(player_ptr, src_idx, d, y, x, dam, typ)) {
-                    res.notice = true;
-                }
-            } else {
-                if (affect_item(player_ptr, src_idx, dist, y, x, dam, typ)) {
-                    res.notice = true;
-                }
+            if (affect_item(player_ptr, src_idx, dists[i], pos.y, pos.x, dam, typ)) {
+                res.notice = true;
             }
         }
     }
@@ -356,14 +352,8 @@ ProjectResult project(PlayerType *player_ptr, const MONSTER_IDX src_idx, POSITIO
         project_m_n = 0;
         project_m_x = 0;
         project_m_y = 0;
-        auto dist = 0;
         for (int i = 0; i < grids; i++) {
-            int effective_dist;
-            if (gm[dist + 1] == i) {
-                dist++;
-            }
-
-            const Pos2D pos(gy[i], gx[i]);
+            const auto &pos = positions[i];
             const auto &grid = floor.get_grid(pos);
             if (grids <= 1) {
                 auto *m_ptr = &floor.m_list[grid.m_idx];
@@ -411,13 +401,7 @@ ProjectResult project(PlayerType *player_ptr, const MONSTER_IDX src_idx, POSITIO
                 }
             }
 
-            /* Find the closest point in the blast */
-            if (breath) {
-                effective_dist = dist_to_line(pos.y, pos.x, y1, x1, by, bx);
-            } else {
-                effective_dist = dist;
-            }
-
+            auto effective_dist = dists[i];
             if (player_ptr->riding && player_ptr->is_located_at(pos)) {
                 if (flag & PROJECT_PLAYER) {
                     if (flag & (PROJECT_BEAM | PROJECT_REFLECTABLE | PROJECT_AIMED)) {
@@ -473,6 +457,10 @@ ProjectResult project(PlayerType *player_ptr, const MONSTER_IDX src_idx, POSITIO
                 }
             }
 
+            if (!grid.has_monster()) {
+                continue;
+            }
+
             if (affect_monster(player_ptr, src_idx, effective_dist, pos.y, pos.x, dam, typ, flag, see_s_msg, cap_mon_ptr)) {
                 res.notice = true;
             }
@@ -495,24 +483,13 @@ ProjectResult project(PlayerType *player_ptr, const MONSTER_IDX src_idx, POSITIO
     }
 
     if (flag & (PROJECT_KILL)) {
-        auto dist = 0;
         for (int i = 0; i < grids; i++) {
-            int effective_dist;
-            if (gm[dist + 1] == i) {
-                dist++;
-            }
-
-            const Pos2D pos(gy[i], gx[i]);
+            const auto &pos = positions[i];
             if (!player_ptr->is_located_at(pos)) {
                 continue;
             }
 
-            /* Find the closest point in the blast */
-            if (breath) {
-                effective_dist = dist_to_line(pos.y, pos.x, y1, x1, by, bx);
-            } else {
-                effective_dist = dist;
-            }
+            auto effective_dist = dists[i];
 
             if (player_ptr->riding) {
                 if (flag & PROJECT_PLAYER) {
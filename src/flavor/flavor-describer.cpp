@@ -8,6 +8,7 @@
 #include "combat/shoot.h"
 #include "flavor/flag-inscriptions-table.h"
 #include "flavor/flavor-util.h"
+#include "flavor/item-description-cache.h"
 #include "flavor/named-item-describer.h"
 #include "flavor/object-flavor-types.h"
 #include "game-option/text-display-options.h"
@@ -36,6 +37,7 @@
 #include "system/player-type-definition.h"
 #include "util/bit-flags-calculator.h"
 #include "util/string-processor.h"
+#include <optional>
 #include <sstream>
 
 static std::string describe_chest_trap(const ItemEntity &item)
@@ -568,14 +570,7 @@ static describe_option_type decide_describe_option(const ItemEntity &item, BIT_F
     return opt;
 }
 
-/*!
- * @brief オブジェクトの各表記を返す
- * @param player_ptr プレイヤーへの参照ポインタ
- * @param o_ptr 特性短縮表記を得たいオブジェクト構造体の参照ポインタ
- * @param mode 表記に関するオプション指定
- * @return modeに応じたオブジェクトの表記
- */
-std::string describe_flavor(PlayerType *player_ptr, const ItemEntity *o_ptr, BIT_FLAGS mode, const size_t max_length)
+static std::string describe_flavor_without_cache(PlayerType *player_ptr, const ItemEntity *o_ptr, BIT_FLAGS mode, const size_t max_length)
 {
     const auto &item = *o_ptr;
     const auto opt = decide_describe_option(item, mode);
@@ -613,3 +608,72 @@ std::string describe_flavor(PlayerType *player_ptr, const ItemEntity *o_ptr, BIT
     ss << describe_inscription(item, opt);
     return str_substr(ss.str(), 0, max_length);
 }
+
+/*!
+ * @brief アイテム表記のキャッシュのキーを作る
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param item アイテムへの参照
+ * @param mode 表記に関するオプション指定
+ * @param max_length 表記の最大長
+ * @return キー (キャッシュできないアイテムならnullopt)
+ * @details 鍛冶師の名前 (プレイヤー名) を含む鍛冶アイテム、及び装備中の弓やプレイヤーの能力値から
+ * 期待ダメージを計算する矢弾と忍者の鉄製の楔はキャッシュしない.
+ * 上記以外でプレイヤーの状態に依存する表記はキーに含める.
+ */
+static std::optional<ItemDescriptionKey> make_description_key(PlayerType *player_ptr, const ItemEntity &item, BIT_FLAGS mode, const size_t max_length)
+{
+    if (item.is_smith()) {
+        return std::nullopt;
+    }
+
+    const auto tval = item.bi_key.tval();
+    const auto describes_detail = none_bits(mode, OD_NAME_ONLY | OD_DEBUG) && item.is_valid();
+    if (describes_detail) {
+        const auto &bow = player_ptr->inventory_list[INVEN_BOW];
+        if (bow.is_valid() && (tval == bow.get_arrow_kind())) {
+            return std::nullopt;
+        }
+
+        if (PlayerClass(player_ptr).equals(PlayerClassType::NINJA) && (tval == ItemKindType::SPIKE)) {
+            return std::nullopt;
+        }
+    }
+
+    ItemDescriptionKey key(item, mode, max_length);
+    key.plain_descriptions = plain_descriptions;
+    key.abbrev_extra = abbrev_extra;
+    key.abbrev_all = abbrev_all;
+    key.is_riding = player_ptr->riding > 0;
+    key.is_quest_target = object_is_quest_target(player_ptr->current_floor_ptr->quest_number, &item);
+    if (describes_detail && (tval == ItemKindType::BOW)) {
+        key.num_fire = calc_num_fire(player_ptr, &item);
+    }
+
+    return key;
+}
+
+/*!
+ * @brief オブジェクトの各表記を返す
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param o_ptr 特性短縮表記を得たいオブジェクト構造体の参照ポインタ
+ * @param mode 表記に関するオプション指定
+ * @return modeに応じたオブジェクトの表記
+ * @details 同じ状態のアイテムを同じオプションで表記した結果は ItemDescriptionCache から返す.
+ */
+std::string describe_flavor(PlayerType *player_ptr, const ItemEntity *o_ptr, BIT_FLAGS mode, const size_t max_length)
+{
+    auto &cache = ItemDescriptionCache::get_instance();
+    const auto key = make_description_key(player_ptr, *o_ptr, mode, max_length);
+    if (!key) {
+        cache.count_uncacheable();
+        return describe_flavor_without_cache(player_ptr, o_ptr, mode, max_length);
+    }
+
+    if (const auto *description = cache.find(*key)) {
+        return *description;
+    }
+
+    auto description = describe_flavor_without_cache(player_ptr, o_ptr, mode, max_length);
+    cache.store(*key, description);
+    return description;
+}
@@ -0,0 +1,158 @@
+#include "flavor/item-description-cache.h"
+#include "system/item-entity.h"
+#include "util/enum-converter.h"
+#include <functional>
+
+namespace {
+constexpr auto MAX_DESCRIPTIONS = 4096; //!< キャッシュするアイテム表記の最大数 (超えたら全て捨てる)
+
+void hash_combine(size_t &seed, size_t value)
+{
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+}
+
+ItemDescriptionCache ItemDescriptionCache::instance{};
+
+/*!
+ * @brief アイテムの表記に関わる値からキーを作る
+ * @param item アイテムへの参照
+ * @param mode 表記に関するオプション指定
+ * @param max_length 表記の最大長
+ */
+ItemDescriptionKey::ItemDescriptionKey(const ItemEntity &item, BIT_FLAGS mode, size_t max_length)
+    : mode(mode)
+    , max_length(max_length)
+    , bi_id(item.bi_id)
+    , bi_key(item.bi_key)
+    , pval(item.pval)
+    , discount(item.discount)
+    , number(item.number)
+    , weight(item.weight)
+    , fa_id(item.fa_id)
+    , ego_idx(item.ego_idx)
+    , activation_id(item.activation_id)
+    , chest_level(item.chest_level)
+    , captured_monster_speed(item.captured_monster_speed)
+    , captured_monster_current_hp(item.captured_monster_current_hp)
+    , captured_monster_max_hp(item.captured_monster_max_hp)
+    , fuel(item.fuel)
+    , to_h(item.to_h)
+    , to_d(item.to_d)
+    , to_a(item.to_a)
+    , ac(item.ac)
+    , dd(item.dd)
+    , ds(item.ds)
+    , timeout(item.timeout)
+    , ident(item.ident)
+    , feeling(item.feeling)
+    , inscription(item.inscription)
+    , randart_name(item.randart_name)
+    , art_flags(item.art_flags)
+    , curse_flags(item.curse_flags)
+    , is_aware(item.is_aware())
+    , is_tried(item.is_tried())
+{
+}
+
+size_t ItemDescriptionCache::KeyHash::operator()(const ItemDescriptionKey &key) const
+{
+    size_t seed = key.mode;
+    hash_combine(seed, key.bi_id);
+    hash_combine(seed, key.pval);
+    hash_combine(seed, key.number);
+    hash_combine(seed, enum2i(key.fa_id));
+    hash_combine(seed, enum2i(key.ego_idx));
+    hash_combine(seed, key.to_h);
+    hash_combine(seed, key.to_d);
+    hash_combine(seed, key.to_a);
+    hash_combine(seed, key.timeout);
+    hash_combine(seed, key.ident);
+    hash_combine(seed, key.feeling);
+    hash_combine(seed, key.is_aware);
+    if (key.inscription) {
+        hash_combine(seed, std::hash<std::string>{}(*key.inscription));
+    }
+
+    return seed;
+}
+
+ItemDescriptionCache &ItemDescriptionCache::get_instance()
+{
+    return instance;
+}
+
+/*!
+ * @brief キャッシュからアイテム表記を探す
+ * @param key アイテム表記のキー
+ * @return アイテム表記 (なければnullptr)
+ */
+const std::string *ItemDescriptionCache::find(const ItemDescriptionKey &key)
+{
+    if (this->stored_generation != this->generation) {
+        this->descriptions.clear();
+        this->stored_generation = this->generation;
+    }
+
+    const auto it = this->descriptions.find(key);
+    if (it == this->descriptions.end()) {
+        this->miss_count++;
+        return nullptr;
+    }
+
+    this->hit_count++;
+    return &it->second;
+}
+
+/*!
+ * @brief アイテム表記をキャッシュに登録する
+ * @param key アイテム表記のキー
+ * @param description アイテム表記
+ */
+void ItemDescriptionCache::store(const ItemDescriptionKey &key, const std::string &description)
+{
+    if (std::ssize(this->descriptions) >= MAX_DESCRIPTIONS) {
+        this->descriptions.clear();
+    }
+
+    this->descriptions.insert_or_assign(key, description);
+}
+
+/*!
+ * @brief キャッシュできないアイテムの表記を組み立てたことを記録する
+ */
+void ItemDescriptionCache::count_uncacheable()
+{
+    this->uncacheable_count++;
+}
+
+/*!
+ * @brief キャッシュした全てのアイテム表記を破棄する
+ * @details フレーバーの割り当てやベースアイテムの鑑定状態の読み込み等、キーに含まれない状態が変わった時に呼ぶ.
+ */
+void ItemDescriptionCache::invalidate()
+{
+    this->generation++;
+}
+
+uint64_t ItemDescriptionCache::get_hit_count() const
+{
+    return this->hit_count;
+}
+
+uint64_t ItemDescriptionCache::get_miss_count() const
+{
+    return this->miss_count;
+}
+
+uint64_t ItemDescriptionCache::get_uncacheable_count() const
+{
+    return this->uncacheable_count;
+}
+
+void ItemDescriptionCache::reset_counts()
+{
+    this->hit_count = 0;
+    this->miss_count = 0;
+    this->uncacheable_count = 0;
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "object-enchant/tr-flags.h"
+#include "object-enchant/trc-types.h"
+#include "system/angband.h"
+#include "system/baseitem-info.h"
+#include "util/flag-group.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+enum class EgoType;
+enum class FixedArtifactId : short;
+enum class RandomArtActType : short;
+class ItemEntity;
+
+/*!
+ * @brief アイテム表記のキャッシュのキー
+ * @details アイテムの表記に関わる値 (位置やスタック番号等を除く全てのフィールドとベースアイテムの鑑定状態)、
+ * 表記オプション、及びプレイヤーの状態のうち表記に関わるものを保持する.
+ * プレイヤーの状態は describe_flavor() 側で設定する.
+ */
+struct ItemDescriptionKey {
+    ItemDescriptionKey(const ItemEntity &item, BIT_FLAGS mode, size_t max_length);
+
+    BIT_FLAGS mode;
+    size_t max_length;
+
+    short bi_id;
+    BaseitemKey bi_key;
+    PARAMETER_VALUE pval;
+    byte discount;
+    ITEM_NUMBER number;
+    WEIGHT weight;
+    FixedArtifactId fa_id;
+    EgoType ego_idx;
+    RandomArtActType activation_id;
+    byte chest_level;
+    uint8_t captured_monster_speed;
+    short captured_monster_current_hp;
+    short captured_monster_max_hp;
+    short fuel;
+    HIT_PROB to_h;
+    int to_d;
+    ARMOUR_CLASS to_a;
+    ARMOUR_CLASS ac;
+    DICE_NUMBER dd;
+    DICE_SID ds;
+    TIME_EFFECT timeout;
+    byte ident;
+    byte feeling;
+    std::optional<std::string> inscription;
+    std::optional<std::string> randart_name;
+    TrFlags art_flags;
+    EnumClassFlagGroup<CurseTraitType> curse_flags;
+    bool is_aware;
+    bool is_tried;
+
+    bool plain_descriptions = false; //!< 表記オプション
+    bool abbrev_extra = false; //!< 表記オプション
+    bool abbrev_all = false; //!< 表記オプション
+    bool is_riding = false; //!< 騎乗中か (ランスのダイス表記が変わる)
+    bool is_quest_target = false; //!< 現在のクエストの目標か (未鑑定時にダイス表記を隠す)
+    int num_fire = 0; //!< 射撃回数 (弓の表記に用いる)
+
+    bool operator==(const ItemDescriptionKey &other) const = default;
+};
+
+/*!
+ * @brief describe_flavor() で作ったアイテム表記のキャッシュ
+ * @details 同じ状態のアイテムを同じ表記オプションで繰り返し表記する時 (インベントリやサブウィンドウの再描画、
+ * 自動拾いの照合等)、文字列を組み立て直さずに前回の結果を返す.
+ * 表記に関わる値は全てキーに含めるため、アイテムや鑑定状態が変わった時は自然に別のエントリとなる.
+ * キーに含まれない全体の状態 (フレーバーの割り当て等) を変えた時は invalidate() を呼ぶこと.
+ */
+class ItemDescriptionCache {
+public:
+    ItemDescriptionCache(const ItemDescriptionCache &) = delete;
+    ItemDescriptionCache(ItemDescriptionCache &&) = delete;
+    ItemDescriptionCache &operator=(const ItemDescriptionCache &) = delete;
+    ItemDescriptionCache &operator=(ItemDescriptionCache &&) = delete;
+
+    static ItemDescriptionCache &get_instance();
+    const std::string *find(const ItemDescriptionKey &key);
+    void store(const ItemDescriptionKey &key, const std::string &description);
+    void count_uncacheable();
+    void invalidate();
+
+    uint64_t get_hit_count() const;
+    uint64_t get_miss_count() const;
+    uint64_t get_uncacheable_count() const;
+    void reset_counts();
+
+private:
+    ItemDescriptionCache() = default;
+
+    static ItemDescriptionCache instance;
+
+    struct KeyHash {
+        size_t operator()(const ItemDescriptionKey &key) const;
+    };
+
+    std::unordered_map<ItemDescriptionKey, std::string, KeyHash> descriptions;
+    uint64_t generation = 0; //!< invalidate() の度に増える世代
+    uint64_t stored_generation = 0; //!< descriptions を作った時の世代
+    uint64_t hit_count = 0; //!< キャッシュから返した回数
+    uint64_t miss_count = 0; //!< キャッシュになく表記を組み立てた回数
+    uint64_t uncacheable_count = 0; //!< キャッシュできないアイテムの表記を組み立てた回数
+};
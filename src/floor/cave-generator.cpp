@@ -3,6 +3,7 @@
 #include "dungeon/quest-monster-placer.h"
 #include "floor/dungeon-tunnel-util.h"
 #include "floor/floor-allocation-types.h"
+#include "floor/floor-generation-stats.h"
 #include "floor/floor-streams.h"
 #include "floor/geometry.h"
 #include "floor/object-allocator.h"
@@ -201,24 +202,32 @@ static void make_only_tunnel_points(FloorType *floor_ptr, dun_data_type *dd_ptr)
 static bool make_one_floor(PlayerType *player_ptr, dun_data_type *dd_ptr, dungeon_type *d_ptr)
 {
     auto *floor_ptr = player_ptr->current_floor_ptr;
+    {
+        FloorGenerationPhaseTimer timer(FloorGenerationPhase::ROOMS);
+        if (floor_ptr->get_dungeon_definition().flags.has(DungeonFeatureType::NO_ROOM)) {
+            make_only_tunnel_points(floor_ptr, dd_ptr);
+        } else {
+            if (!generate_rooms(player_ptr, dd_ptr)) {
+                *dd_ptr->why = _("部屋群の生成に失敗", "Failed to generate rooms");
+                return false;
+            }
+        }
 
-    if (floor_ptr->get_dungeon_definition().flags.has(DungeonFeatureType::NO_ROOM)) {
-        make_only_tunnel_points(floor_ptr, dd_ptr);
-    } else {
-        if (!generate_rooms(player_ptr, dd_ptr)) {
-            *dd_ptr->why = _("部屋群の生成に失敗", "Failed to generate rooms");
+        place_cave_contents(player_ptr, dd_ptr, d_ptr);
+    }
+
+    {
+        FloorGenerationPhaseTimer timer(FloorGenerationPhase::TUNNELS);
+        dt_type tmp_dt;
+        dt_type *dt_ptr = initialize_dt_type(&tmp_dt);
+        if (!make_centers(player_ptr, dd_ptr, d_ptr, dt_ptr)) {
             return false;
         }
-    }
 
-    place_cave_contents(player_ptr, dd_ptr, d_ptr);
-    dt_type tmp_dt;
-    dt_type *dt_ptr = initialize_dt_type(&tmp_dt);
-    if (!make_centers(player_ptr, dd_ptr, d_ptr, dt_ptr)) {
-        return false;
+        make_doors(player_ptr, dd_ptr, dt_ptr);
     }
 
-    make_doors(player_ptr, dd_ptr, dt_ptr);
+    FloorGenerationPhaseTimer timer(FloorGenerationPhase::PLACEMENT);
     if (!alloc_stairs(player_ptr, feat_down_stair, rand_range(3, 4), 3)) {
         *dd_ptr->why = _("下り階段生成に失敗", "Failed to generate down stairs.");
         return false;
@@ -236,7 +245,12 @@ static bool switch_making_floor(PlayerType *player_ptr, dun_data_type *dd_ptr, d
 {
     if (d_ptr->flags.has(DungeonFeatureType::MAZE)) {
         auto *floor_ptr = player_ptr->current_floor_ptr;
-        build_maze_vault(player_ptr, floor_ptr->width / 2 - 1, floor_ptr->height / 2 - 1, floor_ptr->width - 4, floor_ptr->height - 4, false);
+        {
+            FloorGenerationPhaseTimer timer(FloorGenerationPhase::ROOMS);
+            build_maze_vault(player_ptr, floor_ptr->width / 2 - 1, floor_ptr->height / 2 - 1, floor_ptr->width - 4, floor_ptr->height - 4, false);
+        }
+
+        FloorGenerationPhaseTimer timer(FloorGenerationPhase::PLACEMENT);
         if (!alloc_stairs(player_ptr, feat_down_stair, rand_range(2, 3), 3)) {
             *dd_ptr->why = _("迷宮ダンジョンの下り階段生成に失敗", "Failed to alloc up stairs in maze dungeon.");
             return false;
@@ -441,13 +455,22 @@ bool cave_gen(PlayerType *player_ptr, concptr *why)
     }
 
     check_arena_floor(player_ptr, dd_ptr);
-    gen_caverns_and_lakes(player_ptr, d_ptr, dd_ptr);
+    {
+        FloorGenerationPhaseTimer timer(FloorGenerationPhase::ROOMS);
+        gen_caverns_and_lakes(player_ptr, d_ptr, dd_ptr);
+    }
+
     if (!switch_making_floor(player_ptr, dd_ptr, d_ptr)) {
         return false;
     }
 
-    make_aqua_streams(player_ptr, dd_ptr, d_ptr);
+    {
+        FloorGenerationPhaseTimer timer(FloorGenerationPhase::STREAMS);
+        make_aqua_streams(player_ptr, dd_ptr, d_ptr);
+    }
+
     make_perm_walls(player_ptr);
+    FloorGenerationPhaseTimer timer(FloorGenerationPhase::PLACEMENT);
     if (!check_place_necessary_objects(player_ptr, dd_ptr)) {
         return false;
     }
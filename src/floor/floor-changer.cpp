@@ -9,6 +9,8 @@
 #include "floor/floor-save-util.h"
 #include "floor/floor-save.h"
 #include "floor/floor-util.h"
+#include "floor/line-of-sight.h"
+#include "floor/next-floor-preparer.h"
 #include "floor/wild.h"
 #include "game-option/birth-options.h"
 #include "game-option/play-record-options.h"
@@ -348,7 +350,7 @@ static void set_stairs(PlayerType *player_ptr)
 static void generate_new_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr)
 {
     if (!is_visited_floor(sf_ptr)) {
-        generate_floor(player_ptr);
+        NextFloorPreparer::get_instance().generate_floor(player_ptr);
     } else {
         build_dead_end(player_ptr, sf_ptr);
     }
@@ -384,7 +386,7 @@ static void cut_off_the_upstair(PlayerType *player_ptr)
 static void update_floor(PlayerType *player_ptr)
 {
     if (!(player_ptr->change_floor_mode & CFM_SAVE_FLOORS) && !(player_ptr->change_floor_mode & CFM_FIRST_FLOOR)) {
-        generate_floor(player_ptr);
+        NextFloorPreparer::get_instance().generate_floor(player_ptr);
         new_floor_id = 0;
         return;
     }
@@ -427,10 +429,12 @@ void change_floor(PlayerType *player_ptr)
     panel_col_max = 0;
     player_ptr->ambush_flag = false;
     update_floor(player_ptr);
+    NextFloorPreparer::get_instance().discard();
     place_pet(player_ptr);
     forget_travel_flow(player_ptr->current_floor_ptr);
     update_unique_artifact(player_ptr->current_floor_ptr, new_floor_id);
     player_ptr->floor_id = new_floor_id;
+    SightCache::invalidate_all();
     w_ptr->character_dungeon = true;
     if (player_ptr->ppersonality == PERSONALITY_MUNCHKIN) {
         wiz_lite(player_ptr, PlayerClass(player_ptr).equals(PlayerClassType::NINJA));
@@ -0,0 +1,192 @@
+/*!
+ * @brief フロアの連結性の判定と修復
+ * @details プレイヤーが通れない永久地形で区切られた孤立部屋は、狂戦士でのプレイに支障をきたしうる.
+ * そのようなフロアを丸ごと生成し直す代わりに、孤立部屋との間の永久地形を最小限だけ掘り抜いて連結にする.
+ */
+
+#include "floor/floor-connectivity.h"
+#include "floor/cave.h"
+#include "floor/floor-generation-stats.h"
+#include "floor/geometry.h"
+#include "grid/grid.h"
+#include "system/floor-type-definition.h"
+#include "system/grid-type-definition.h"
+#include "system/player-type-definition.h"
+#include "system/terrain-type-definition.h"
+#include "util/disjoint-set.h"
+#include <array>
+#include <deque>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace {
+constexpr auto MAX_REPAIR_TUNNELS = 16; //!< 1つのフロアを連結にするために掘る通路の最大数
+constexpr auto MAX_REPAIR_LENGTH = 12; //!< 1本の通路で掘り抜く永久地形の最大数
+
+/*!
+ * @brief マスがプレイヤーの通れない永久地形か
+ */
+bool is_permanent_blocker(const FloorType &floor, const Pos2D &pos)
+{
+    const auto &flags = floor.get_grid(pos).get_terrain().flags;
+    return flags.has(TerrainCharacteristics::PERMANENT) && flags.has_not(TerrainCharacteristics::MOVE);
+}
+
+/*!
+ * @brief 永久地形以外のマスを連結成分に分ける
+ * @param floor フロアへの参照
+ * @param components 連結成分を返す素集合 (要素はマスの y * width + x)
+ * @return 連結成分の数
+ * @details 各マスの8近傍は互いに移動可能とし、永久地形のみを壁とみなす.
+ * 左上から順に見ていくため、既に見た4近傍とだけ併合すれば良い.
+ */
+int label_components(const FloorType &floor, DisjointSet &components)
+{
+    static constexpr std::array<Pos2DVec, 4> prev_vecs{ { { 0, -1 }, { -1, -1 }, { -1, 0 }, { -1, 1 } } };
+    const auto width = floor.width;
+    components.assign(floor.height * width);
+    auto num_components = 0;
+    for (auto y = 0; y < floor.height; y++) {
+        for (auto x = 0; x < width; x++) {
+            const Pos2D pos(y, x);
+            if (is_permanent_blocker(floor, pos)) {
+                continue;
+            }
+
+            num_components++;
+            for (const auto &vec : prev_vecs) {
+                const auto pos_neighbor = pos + vec;
+                if ((pos_neighbor.y < 0) || (pos_neighbor.x < 0) || (pos_neighbor.x >= width) || is_permanent_blocker(floor, pos_neighbor)) {
+                    continue;
+                }
+
+                if (components.unite(y * width + x, pos_neighbor.y * width + pos_neighbor.x)) {
+                    num_components--;
+                }
+            }
+        }
+    }
+
+    return num_components;
+}
+
+/*!
+ * @brief 最大の連結成分から他の連結成分へ、掘り抜く永久地形が最も少ない経路を探す
+ * @param floor フロアへの参照
+ * @param components 連結成分
+ * @return 掘り抜く永久地形のマスの列 (MAX_REPAIR_LENGTH 以内で届かなければnullopt)
+ * @details 永久地形へ進む時だけ費用1がかかる 0-1 BFS で、最大の連結成分の全てのマスから同時に探す.
+ * フロア端の永久壁は掘らない.
+ */
+std::optional<std::vector<Pos2D>> find_repair_path(const FloorType &floor, DisjointSet &components)
+{
+    const auto width = floor.width;
+    const auto num_grids = floor.height * width;
+    auto main_root = -1;
+    size_t main_size = 0;
+    for (auto i = 0; i < num_grids; i++) {
+        if (!is_permanent_blocker(floor, { i / width, i % width }) && (components.size_of(i) > main_size)) {
+            main_root = static_cast<int>(components.find(i));
+            main_size = components.size_of(i);
+        }
+    }
+
+    static std::vector<int> costs;
+    static std::vector<int> prevs;
+    costs.assign(num_grids, std::numeric_limits<int>::max());
+    prevs.assign(num_grids, -1);
+    std::deque<int> queue;
+    for (auto i = 0; i < num_grids; i++) {
+        if (!is_permanent_blocker(floor, { i / width, i % width }) && (static_cast<int>(components.find(i)) == main_root)) {
+            costs[i] = 0;
+            queue.push_back(i);
+        }
+    }
+
+    while (!queue.empty()) {
+        const auto current = queue.front();
+        queue.pop_front();
+        const Pos2D pos(current / width, current % width);
+        const auto is_blocker = is_permanent_blocker(floor, pos);
+        if (costs[current] > MAX_REPAIR_LENGTH) {
+            return std::nullopt;
+        }
+
+        if (!is_blocker && (static_cast<int>(components.find(current)) != main_root)) {
+            std::vector<Pos2D> path;
+            for (auto i = prevs[current]; i >= 0; i = prevs[i]) {
+                if (is_permanent_blocker(floor, { i / width, i % width })) {
+                    path.emplace_back(i / width, i % width);
+                }
+            }
+
+            return path;
+        }
+
+        for (auto dir = 0; dir < 8; dir++) {
+            const Pos2D pos_neighbor(pos.y + ddy_ddd[dir], pos.x + ddx_ddd[dir]);
+            if (!in_bounds(&floor, pos_neighbor.y, pos_neighbor.x)) {
+                continue;
+            }
+
+            const auto neighbor = pos_neighbor.y * width + pos_neighbor.x;
+            const auto is_neighbor_blocker = is_permanent_blocker(floor, pos_neighbor);
+            const auto cost = costs[current] + (is_neighbor_blocker ? 1 : 0);
+            if (cost >= costs[neighbor]) {
+                continue;
+            }
+
+            costs[neighbor] = cost;
+            prevs[neighbor] = current;
+            if (is_neighbor_blocker) {
+                queue.push_back(neighbor);
+            } else {
+                queue.push_front(neighbor);
+            }
+        }
+    }
+
+    return std::nullopt;
+}
+}
+
+/*!
+ * @brief フロアを連結にする
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @return 連結になったか (掘り抜く永久地形が多すぎる等で修復できなければ偽)
+ * @details 素集合で連結成分を求め、2つ以上あれば最大の連結成分から最寄りの連結成分への通路を掘ることを繰り返す.
+ * 通路のマスは make_tunnels() と同じく床にする. 永久地形以外の壁は掘れるので、掘るのは経路上の永久地形だけで良い.
+ */
+bool connect_floor(PlayerType *player_ptr)
+{
+    FloorGenerationPhaseTimer timer(FloorGenerationPhase::CONNECTIVITY);
+    auto &floor = *player_ptr->current_floor_ptr;
+    DisjointSet components;
+    for (auto num_tunnels = 0; true; num_tunnels++) {
+        const auto num_components = label_components(floor, components);
+        if (num_components <= 1) {
+            auto &stats = FloorGenerationStats::get_instance();
+            if ((num_components == 1) && (num_tunnels > 0) && stats.is_enabled()) {
+                stats.add_repair(num_tunnels);
+            }
+
+            return num_components == 1;
+        }
+
+        if (num_tunnels >= MAX_REPAIR_TUNNELS) {
+            return false;
+        }
+
+        const auto path = find_repair_path(floor, components);
+        if (!path) {
+            return false;
+        }
+
+        for (const auto &pos : *path) {
+            auto &grid = floor.get_grid(pos);
+            grid.mimic = 0;
+            place_grid(player_ptr, &grid, GB_FLOOR);
+        }
+    }
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+class PlayerType;
+bool connect_floor(PlayerType *player_ptr);
@@ -14,6 +14,7 @@
 #include "grid/grid.h"
 #include "main/sound-of-music.h"
 #include "mind/mind-ninja.h"
+#include "monster-floor/monster-lite.h"
 #include "monster-race/monster-race.h"
 #include "monster/monster-info.h"
 #include "monster/monster-list.h"
@@ -42,6 +43,7 @@
 #include "util/bit-flags-calculator.h"
 #include "view/display-messages.h"
 #include "world/world.h"
+#include <limits>
 
 static void update_sun_light(PlayerType *player_ptr)
 {
@@ -275,6 +277,35 @@ static byte get_dungeon_feeling(PlayerType *player_ptr)
     return 10;
 }
 
+/*!
+ * @brief 雰囲気を更新するまでに経過させるゲームターン数を返す
+ * @param player_ptr プレイヤーへの参照ポインタ
+ */
+static int get_dungeon_feeling_delay(PlayerType *player_ptr)
+{
+    const auto &floor = *player_ptr->current_floor_ptr;
+    return std::max(10, 150 - player_ptr->skill_fos) * (150 - floor.dun_level) * TURNS_PER_TICK / 100;
+}
+
+/*!
+ * @brief 雰囲気を感じ取れない固定クエストの中にいるかを返す
+ * @param floor フロアへの参照
+ */
+static bool is_in_feeling_quest(const FloorType &floor)
+{
+    const auto quest_id = floor.get_quest_id();
+    const auto &quests = QuestList::get_instance();
+
+    auto dungeon_quest = (quest_id == QuestId::OBERON);
+    dungeon_quest |= (quest_id == QuestId::SERPENT);
+    dungeon_quest |= !(quests.get_quest(quest_id).flags & QUEST_FLAG_PRESET);
+
+    auto feeling_quest = inside_quest(quest_id);
+    feeling_quest &= QuestType::is_fixed(quest_id);
+    feeling_quest &= !dungeon_quest;
+    return feeling_quest;
+}
+
 /*!
  * @brief ダンジョンの雰囲気を更新し、変化があった場合メッセージを表示する
  * / Update dungeon feeling, and announce it if changed
@@ -290,22 +321,12 @@ void update_dungeon_feeling(PlayerType *player_ptr)
         return;
     }
 
-    int delay = std::max(10, 150 - player_ptr->skill_fos) * (150 - floor.dun_level) * TURNS_PER_TICK / 100;
+    const auto delay = get_dungeon_feeling_delay(player_ptr);
     if (w_ptr->game_turn < player_ptr->feeling_turn + delay && !cheat_xtra) {
         return;
     }
 
-    const auto quest_id = floor.get_quest_id();
-    const auto &quests = QuestList::get_instance();
-
-    auto dungeon_quest = (quest_id == QuestId::OBERON);
-    dungeon_quest |= (quest_id == QuestId::SERPENT);
-    dungeon_quest |= !(quests.get_quest(quest_id).flags & QUEST_FLAG_PRESET);
-
-    auto feeling_quest = inside_quest(quest_id);
-    feeling_quest &= QuestType::is_fixed(quest_id);
-    feeling_quest &= !dungeon_quest;
-    if (feeling_quest) {
+    if (is_in_feeling_quest(floor)) {
         return;
     }
     byte new_feeling = get_dungeon_feeling(player_ptr);
@@ -323,6 +344,26 @@ void update_dungeon_feeling(PlayerType *player_ptr)
     }
 }
 
+/*!
+ * @brief ダンジョンの雰囲気を更新せずに経過するゲームターン数を返す
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @return 現在のゲームターンから数えたゲームターン数 (雰囲気を更新しないフロアなら int の最大値)
+ */
+int count_turns_before_dungeon_feeling(PlayerType *player_ptr)
+{
+    const auto &floor = *player_ptr->current_floor_ptr;
+    if (!floor.dun_level || AngbandSystem::get_instance().is_phase_out() || is_in_feeling_quest(floor)) {
+        return std::numeric_limits<int>::max();
+    }
+
+    if (cheat_xtra) {
+        return 0;
+    }
+
+    const auto feeling_turn = static_cast<int64_t>(player_ptr->feeling_turn) + get_dungeon_feeling_delay(player_ptr);
+    return static_cast<int>(std::clamp<int64_t>(feeling_turn - w_ptr->game_turn, 0, std::numeric_limits<int>::max()));
+}
+
 /*
  * Glow deep lava and building entrances in the floor
  */
@@ -384,6 +425,7 @@ void forget_lite(FloorType *floor_ptr)
  */
 void forget_view(FloorType *floor_ptr)
 {
+    invalidate_mon_lite_cache();
     if (!floor_ptr->view_n) {
         return;
     }
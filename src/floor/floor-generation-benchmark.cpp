@@ -0,0 +1,162 @@
+/*!
+ * @brief フロア生成のベンチマーク
+ * @details 全てのダンジョンについて、深さの範囲毎に固定の乱数の種でフロアを繰り返し生成し、
+ * 工程毎の所要時間と生成をやり直した理由毎の回数をCSVで出力する.
+ * どのダンジョンがフロアの生成に時間を費やしているか (特にやり直しによって) を調べるためのもの.
+ */
+
+#include "floor/floor-generation-benchmark.h"
+#include "birth/game-play-initializer.h"
+#include "floor/floor-generation-stats.h"
+#include "floor/floor-generator.h"
+#include "floor/floor-util.h"
+#include "monster-floor/monster-remover.h"
+#include "player-info/class-info.h"
+#include "player-info/race-info.h"
+#include "player/player-personality.h"
+#include "player/race-info-table.h"
+#include "system/dungeon-info.h"
+#include "system/floor-type-definition.h"
+#include "system/player-type-definition.h"
+#include "term/z-rand.h"
+#include "util/enum-converter.h"
+#include "world/world.h"
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace {
+constexpr auto NUM_DEPTH_RANGES = 4; //!< 1つのダンジョンの深さを分ける範囲の数
+
+/*!
+ * @brief フロア毎の乱数の種を作る
+ * @param seed 乱数の種の基準値
+ * @param dungeon_id ダンジョンID
+ * @param depth 階層
+ * @param count 同じ範囲で何番目に生成するフロアか
+ */
+uint32_t make_floor_seed(uint32_t seed, int dungeon_id, int depth, int count)
+{
+    auto x = seed ^ (static_cast<uint32_t>(dungeon_id) << 24) ^ (static_cast<uint32_t>(depth) << 14) ^ static_cast<uint32_t>(count);
+    x = (x ^ (x >> 16)) * 0x7feb352d;
+    x = (x ^ (x >> 15)) * 0x846ca68b;
+    return x ^ (x >> 16);
+}
+
+void output_csv_string(std::ostream &os, std::string_view str)
+{
+    os << '"';
+    for (const auto c : str) {
+        if (c == '"') {
+            os << '"';
+        }
+
+        os << c;
+    }
+
+    os << '"';
+}
+
+double to_milliseconds(std::chrono::steady_clock::duration time)
+{
+    return std::chrono::duration<double, std::milli>(time).count();
+}
+
+/*!
+ * @brief 統計をCSVの1行として出力する
+ */
+void output_stats(std::ostream &os, const dungeon_type &dungeon, int min_depth, int max_depth)
+{
+    const auto &stats = FloorGenerationStats::get_instance();
+    os << dungeon.idx << ',';
+    output_csv_string(os, dungeon.name);
+    os << ',' << min_depth << ',' << max_depth << ',' << stats.get_floor_count() << ',' << stats.get_restart_count();
+    os << ',' << stats.get_repair_count() << ',' << stats.get_repair_tunnel_count();
+    os << ',' << to_milliseconds(stats.get_total_time());
+    for (auto phase = 0; phase < enum2i(FloorGenerationPhase::MAX); phase++) {
+        os << ',' << to_milliseconds(stats.get_phase_time(i2enum<FloorGenerationPhase>(phase)));
+    }
+
+    std::string reasons;
+    for (const auto &[why, count] : stats.get_restart_reasons()) {
+        if (!reasons.empty()) {
+            reasons.append(";");
+        }
+
+        reasons.append(why).append("=").append(std::to_string(count));
+    }
+
+    os << ',';
+    output_csv_string(os, reasons);
+    os << '\n';
+}
+}
+
+/*!
+ * @brief フロアの生成に必要な最小限のプレイヤーを作る
+ * @details キャラクター作成前に呼ばれるため、種族・職業・性格は既定のものとする.
+ */
+void setup_floor_generation_player(PlayerType *player_ptr)
+{
+    player_wipe_without_name(player_ptr);
+    player_ptr->prace = PlayerRaceType::HUMAN;
+    player_ptr->pclass = PlayerClassType::WARRIOR;
+    player_ptr->ppersonality = PERSONALITY_ORDINARY;
+    rp_ptr = &race_info[enum2i(player_ptr->prace)];
+    cp_ptr = &class_info[enum2i(player_ptr->pclass)];
+    ap_ptr = &personality_info[player_ptr->ppersonality];
+    mp_ptr = &class_magics_info[enum2i(player_ptr->pclass)];
+    player_ptr->playing = true;
+}
+
+/*!
+ * @brief 全てのダンジョンのフロアを生成し、所要時間と生成をやり直した理由の統計をCSVで出力する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param floors_per_range 深さの範囲毎に生成するフロアの数
+ * @param seed 乱数の種の基準値
+ * @param os 出力先
+ * @details ダンジョンの最浅層から最深層までを NUM_DEPTH_RANGES 個の範囲に分け、範囲毎に1行を出力する.
+ * 時間の単位はミリ秒で、total_ms は生成のやり直しや工程に含まれない処理も含めた全体の時間.
+ * プレイヤーとフロアの状態は上書きするため、ゲームを始める前に呼ぶこと.
+ */
+void output_floor_generation_benchmark(PlayerType *player_ptr, int floors_per_range, uint32_t seed, std::ostream &os)
+{
+    os << "dungeon_id,dungeon,min_depth,max_depth,floors,restarts,repairs,repair_tunnels,total_ms,rooms_ms,tunnels_ms,streams_ms,placement_ms,connectivity_ms,restart_reasons\n";
+    setup_floor_generation_player(player_ptr);
+    auto &stats = FloorGenerationStats::get_instance();
+    stats.set_enabled(true);
+    auto &floor = *player_ptr->current_floor_ptr;
+    for (const auto &dungeon : dungeons_info) {
+        if ((dungeon.idx == 0) || !dungeon.maxdepth) {
+            continue;
+        }
+
+        const auto num_depths = dungeon.maxdepth - dungeon.mindepth + 1;
+        for (auto range = 0; range < NUM_DEPTH_RANGES; range++) {
+            const auto min_depth = dungeon.mindepth + num_depths * range / NUM_DEPTH_RANGES;
+            const auto max_depth = dungeon.mindepth + num_depths * (range + 1) / NUM_DEPTH_RANGES - 1;
+            if (min_depth > max_depth) {
+                continue;
+            }
+
+            stats.reset();
+            for (auto i = 0; i < floors_per_range; i++) {
+                const auto depth = min_depth + i % (max_depth - min_depth + 1);
+                Rand_state_init(make_floor_seed(seed, dungeon.idx, depth, i));
+                floor.set_dungeon_index(dungeon.idx);
+                floor.dun_level = depth;
+                w_ptr->character_dungeon = false;
+                generate_floor(player_ptr);
+                wipe_o_list(&floor);
+                wipe_monsters_list(player_ptr);
+            }
+
+            output_stats(os, dungeon, min_depth, max_depth);
+            os.flush();
+        }
+    }
+
+    stats.set_enabled(false);
+    stats.reset();
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+
+class PlayerType;
+void setup_floor_generation_player(PlayerType *player_ptr);
+void output_floor_generation_benchmark(PlayerType *player_ptr, int floors_per_range, uint32_t seed, std::ostream &os);
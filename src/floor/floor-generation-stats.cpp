@@ -0,0 +1,123 @@
+#include "floor/floor-generation-stats.h"
+#include "util/enum-converter.h"
+
+FloorGenerationStats FloorGenerationStats::instance{};
+
+FloorGenerationStats &FloorGenerationStats::get_instance()
+{
+    return instance;
+}
+
+bool FloorGenerationStats::is_enabled() const
+{
+    return this->enabled;
+}
+
+void FloorGenerationStats::set_enabled(bool enabled)
+{
+    this->enabled = enabled;
+}
+
+/*!
+ * @brief 工程の所要時間を加える
+ * @param phase 工程
+ * @param time 所要時間
+ */
+void FloorGenerationStats::add_phase_time(FloorGenerationPhase phase, std::chrono::steady_clock::duration time)
+{
+    this->phase_times[enum2i(phase)] += time;
+}
+
+/*!
+ * @brief フロアを1つ生成し終えたことを記録する
+ * @param time 生成をやり直した分も含めた所要時間
+ */
+void FloorGenerationStats::add_floor(std::chrono::steady_clock::duration time)
+{
+    this->floor_count++;
+    this->total_time += time;
+}
+
+/*!
+ * @brief フロアの生成をやり直したことを記録する
+ * @param why やり直した理由 (不明ならnullptr)
+ */
+void FloorGenerationStats::add_restart(concptr why)
+{
+    this->restart_count++;
+    this->restart_reasons[why ? why : "unknown"]++;
+}
+
+/*!
+ * @brief 連結でないフロアを生成し直さずに連結にしたことを記録する
+ * @param num_tunnels 掘った通路の数
+ */
+void FloorGenerationStats::add_repair(int num_tunnels)
+{
+    this->repair_count++;
+    this->repair_tunnel_count += num_tunnels;
+}
+
+/*!
+ * @brief 統計を全て消す
+ */
+void FloorGenerationStats::reset()
+{
+    this->floor_count = 0;
+    this->restart_count = 0;
+    this->repair_count = 0;
+    this->repair_tunnel_count = 0;
+    this->total_time = {};
+    this->phase_times.fill({});
+    this->restart_reasons.clear();
+}
+
+int FloorGenerationStats::get_floor_count() const
+{
+    return this->floor_count;
+}
+
+int FloorGenerationStats::get_restart_count() const
+{
+    return this->restart_count;
+}
+
+int FloorGenerationStats::get_repair_count() const
+{
+    return this->repair_count;
+}
+
+int FloorGenerationStats::get_repair_tunnel_count() const
+{
+    return this->repair_tunnel_count;
+}
+
+std::chrono::steady_clock::duration FloorGenerationStats::get_total_time() const
+{
+    return this->total_time;
+}
+
+std::chrono::steady_clock::duration FloorGenerationStats::get_phase_time(FloorGenerationPhase phase) const
+{
+    return this->phase_times[enum2i(phase)];
+}
+
+const std::map<std::string, int> &FloorGenerationStats::get_restart_reasons() const
+{
+    return this->restart_reasons;
+}
+
+FloorGenerationPhaseTimer::FloorGenerationPhaseTimer(FloorGenerationPhase phase)
+    : phase(phase)
+{
+    if (FloorGenerationStats::get_instance().is_enabled()) {
+        this->start = std::chrono::steady_clock::now();
+    }
+}
+
+FloorGenerationPhaseTimer::~FloorGenerationPhaseTimer()
+{
+    if (this->start) {
+        FloorGenerationStats::get_instance().add_phase_time(this->phase, std::chrono::steady_clock::now() - *this->start);
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "system/angband.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+
+/*!
+ * @brief フロア生成の工程
+ */
+enum class FloorGenerationPhase : int {
+    ROOMS = 0, //!< 洞窟・湖・部屋・迷宮の生成
+    TUNNELS = 1, //!< 部屋同士を結ぶトンネルと扉の生成
+    STREAMS = 2, //!< 鉱脈の生成
+    PLACEMENT = 3, //!< 階段・プレイヤー・モンスター・アイテム・罠等の配置
+    CONNECTIVITY = 4, //!< フロアの連結性の判定と修復
+    MAX,
+};
+
+/*!
+ * @brief フロア生成の統計
+ * @details 有効にした間だけ、generate_floor() に要した時間を工程毎に積算し、生成をやり直した理由を数える.
+ * 無効な間は時刻も取得しない.
+ */
+class FloorGenerationStats {
+public:
+    FloorGenerationStats(const FloorGenerationStats &) = delete;
+    FloorGenerationStats(FloorGenerationStats &&) = delete;
+    FloorGenerationStats &operator=(const FloorGenerationStats &) = delete;
+    FloorGenerationStats &operator=(FloorGenerationStats &&) = delete;
+
+    static FloorGenerationStats &get_instance();
+    bool is_enabled() const;
+    void set_enabled(bool enabled);
+    void add_phase_time(FloorGenerationPhase phase, std::chrono::steady_clock::duration time);
+    void add_floor(std::chrono::steady_clock::duration time);
+    void add_restart(concptr why);
+    void add_repair(int num_tunnels);
+    void reset();
+
+    int get_floor_count() const;
+    int get_restart_count() const;
+    int get_repair_count() const;
+    int get_repair_tunnel_count() const;
+    std::chrono::steady_clock::duration get_total_time() const;
+    std::chrono::steady_clock::duration get_phase_time(FloorGenerationPhase phase) const;
+    const std::map<std::string, int> &get_restart_reasons() const;
+
+private:
+    FloorGenerationStats() = default;
+
+    static FloorGenerationStats instance;
+
+    bool enabled = false;
+    int floor_count = 0; //!< 生成し終えたフロアの数
+    int restart_count = 0; //!< 生成をやり直した回数
+    int repair_count = 0; //!< 生成をやり直す代わりに連結にしたフロアの数
+    int repair_tunnel_count = 0; //!< 連結にするために掘った通路の数
+    std::chrono::steady_clock::duration total_time{}; //!< 生成をやり直した分も含めた、フロアの生成に要した時間
+    std::array<std::chrono::steady_clock::duration, static_cast<int>(FloorGenerationPhase::MAX)> phase_times{};
+    std::map<std::string, int> restart_reasons; //!< 生成をやり直した理由毎の回数
+};
+
+/*!
+ * @brief フロア生成の工程の所要時間を計るタイマー
+ * @details 生成中の関数の中で作り、スコープを抜けるまでの時間を統計に加える.
+ */
+class FloorGenerationPhaseTimer {
+public:
+    explicit FloorGenerationPhaseTimer(FloorGenerationPhase phase);
+    ~FloorGenerationPhaseTimer();
+    FloorGenerationPhaseTimer(const FloorGenerationPhaseTimer &) = delete;
+    FloorGenerationPhaseTimer(FloorGenerationPhaseTimer &&) = delete;
+    FloorGenerationPhaseTimer &operator=(const FloorGenerationPhaseTimer &) = delete;
+    FloorGenerationPhaseTimer &operator=(FloorGenerationPhaseTimer &&) = delete;
+
+private:
+    FloorGenerationPhase phase;
+    std::optional<std::chrono::steady_clock::time_point> start; //!< 計測を始めた時刻 (統計が無効ならnullopt)
+};
@@ -13,10 +13,13 @@
 #include "dungeon/dungeon-flag-types.h"
 #include "dungeon/quest.h"
 #include "floor/cave-generator.h"
+#include "floor/floor-connectivity.h"
 #include "floor/floor-events.h"
+#include "floor/floor-generation-stats.h"
 #include "floor/floor-generator.h"
 #include "floor/floor-save.h" //!< @todo precalc_cur_num_of_pet() が依存している、違和感.
 #include "floor/floor-util.h"
+#include "floor/next-floor-preparer.h"
 #include "floor/wild.h"
 #include "game-option/birth-options.h"
 #include "game-option/cheat-types.h"
@@ -54,8 +57,7 @@
 #include "wizard/wizard-messages.h"
 #include "world/world.h"
 #include <algorithm>
-#include <array>
-#include <stack>
+#include <chrono>
 
 /*!
  * @brief 闘技場用のアリーナ地形を作成する / Builds the on_defeat_arena_monster after it is entered -KMW-
@@ -387,105 +389,18 @@ void clear_cave(PlayerType *player_ptr)
             g_ptr->m_idx = 0;
             g_ptr->special = 0;
             g_ptr->mimic = 0;
-            g_ptr->reset_costs();
-            g_ptr->reset_dists();
-            g_ptr->when = 0;
         }
     }
 
+    floor_ptr->pathing_layer.reset_flow();
+    floor_ptr->pathing_layer.reset_whens();
+    invalidate_flow();
+
     floor_ptr->base_level = floor_ptr->dun_level;
     floor_ptr->monster_level = floor_ptr->base_level;
     floor_ptr->object_level = floor_ptr->base_level;
 }
 
-typedef bool (*IsWallFunc)(const FloorType *, int, int);
-
-// (y,x) がプレイヤーが通れない永久地形かどうかを返す。
-static bool is_permanent_blocker(const FloorType *const floor_ptr, const int y, const int x)
-{
-    const auto &flags = floor_ptr->get_grid({ y, x }).get_terrain().flags;
-    return flags.has(TerrainCharacteristics::PERMANENT) && flags.has_not(TerrainCharacteristics::MOVE);
-}
-
-static void floor_is_connected_dfs(const FloorType *const floor_ptr, const IsWallFunc is_wall, const int y_start, const int x_start, bool *const visited)
-{
-    // clang-format off
-    static const int DY[8] = { -1, -1, -1,  0, 0,  1, 1, 1 };
-    static const int DX[8] = { -1,  0,  1, -1, 1, -1, 0, 1 };
-    // clang-format on
-
-    const int h = floor_ptr->height;
-    const int w = floor_ptr->width;
-    const int start = w * y_start + x_start;
-
-    // 深さ優先探索用のスタック。
-    // 最大フロアサイズが h=66, w=198 なので、スタックオーバーフロー防止のため再帰は使わない。
-    std::stack<int> stk;
-
-    stk.emplace(start);
-    visited[start] = true;
-
-    while (!stk.empty()) {
-        const int cur = stk.top();
-        stk.pop();
-        const int y = cur / w;
-        const int x = cur % w;
-
-        for (int i = 0; i < 8; ++i) {
-            const int y_nxt = y + DY[i];
-            const int x_nxt = x + DX[i];
-            if (y_nxt < 0 || h <= y_nxt || x_nxt < 0 || w <= x_nxt) {
-                continue;
-            }
-            const int nxt = w * y_nxt + x_nxt;
-            if (visited[nxt]) {
-                continue;
-            }
-            if (is_wall(floor_ptr, y_nxt, x_nxt)) {
-                continue;
-            }
-
-            stk.emplace(nxt);
-            visited[nxt] = true;
-        }
-    }
-}
-
-// 現在のフロアが連結かどうかを返す。
-// 各セルの8近傍は互いに移動可能とし、is_wall が真を返すセルのみを壁とみなす。
-//
-// 連結成分数が 0 の場合、偽を返す。
-static bool floor_is_connected(const FloorType *const floor_ptr, const IsWallFunc is_wall)
-{
-    static std::array<bool, MAX_HGT * MAX_WID> visited;
-
-    const int h = floor_ptr->height;
-    const int w = floor_ptr->width;
-
-    std::fill(begin(visited), end(visited), false);
-
-    int n_component = 0; // 連結成分数
-
-    for (int y = 0; y < h; ++y) {
-        for (int x = 0; x < w; ++x) {
-            const int idx = w * y + x;
-            if (visited[idx]) {
-                continue;
-            }
-            if (is_wall(floor_ptr, y, x)) {
-                continue;
-            }
-
-            if (++n_component >= 2) {
-                break;
-            }
-            floor_is_connected_dfs(floor_ptr, is_wall, y, x, visited.data());
-        }
-    }
-
-    return n_component == 1;
-}
-
 /*!
  * ダンジョンのランダムフロアを生成する / Generates a random dungeon level -RAK-
  * @parama player_ptr プレイヤーへの参照ポインタ
@@ -493,7 +408,9 @@ static bool floor_is_connected(const FloorType *const floor_ptr, const IsWallFun
  */
 void generate_floor(PlayerType *player_ptr)
 {
+    RngStreamSelector rng_selector(RngStream::FLOOR_GENERATION);
     auto &floor = *player_ptr->current_floor_ptr;
+    const auto start_time = std::chrono::steady_clock::now();
     set_floor_and_wall(floor.dungeon_idx);
     for (int num = 0; true; num++) {
         bool okay = true;
@@ -525,11 +442,11 @@ void generate_floor(PlayerType *player_ptr)
         }
 
         // ダンジョン内フロアが連結でない(永久壁で区切られた孤立部屋がある)場合、
-        // 狂戦士でのプレイに支障をきたしうるので再生成する。
+        // 狂戦士でのプレイに支障をきたしうるので、永久壁を掘って連結にする。それができなければ再生成する。
         // 地上、荒野マップ、クエストでは連結性判定は行わない。
         // TODO: 本来はダンジョン生成アルゴリズム自身で連結性を保証するのが理想ではある。
         const bool check_conn = okay && floor.is_in_underground() && !floor.is_in_quest();
-        if (check_conn && !floor_is_connected(&floor, is_permanent_blocker)) {
+        if (check_conn && !connect_floor(player_ptr)) {
             // 一定回数試しても連結にならないなら諦める。
             if (num >= 1000) {
                 plog("cannot generate connected floor. giving up...");
@@ -543,7 +460,12 @@ void generate_floor(PlayerType *player_ptr)
             break;
         }
 
-        if (why) {
+        auto &stats = FloorGenerationStats::get_instance();
+        if (stats.is_enabled()) {
+            stats.add_restart(why);
+        }
+
+        if (why && !NextFloorPreparer::get_instance().is_preparing()) {
             msg_format(_("生成やり直し(%s)", "Generation restarted (%s)"), why);
         }
 
@@ -554,4 +476,8 @@ void generate_floor(PlayerType *player_ptr)
     glow_deep_lava_and_bldg(player_ptr);
     player_ptr->enter_dungeon = false;
     wipe_generate_random_floor_flags(&floor);
+    auto &stats = FloorGenerationStats::get_instance();
+    if (stats.is_enabled()) {
+        stats.add_floor(std::chrono::steady_clock::now() - start_time);
+    }
 }
@@ -27,7 +27,7 @@
 #include "object/object-kind-hook.h"
 #include "object/object-stack.h"
 #include "perception/object-perception.h"
-#include "system/alloc-entries.h"
+#include "system/angband-system.h"
 #include "system/artifact-type-definition.h"
 #include "system/floor-type-definition.h"
 #include "system/grid-type-definition.h"
@@ -46,25 +46,6 @@
 
 #define MAX_GOLD 18 /* Number of "gold" entries */
 
-/*!
- * @brief オブジェクト生成テーブルに生成制約を加える /
- * Apply a "object restriction function" to the "object allocation table"
- * @return 常に0を返す。
- * @details 生成の制約はグローバルのget_obj_index_hook関数ポインタで加える
- */
-static errr get_obj_index_prep(void)
-{
-    for (auto &entry : alloc_kind_table) {
-        if (!get_obj_index_hook || (*get_obj_index_hook)(entry.index)) {
-            entry.prob2 = entry.prob1;
-        } else {
-            entry.prob2 = 0;
-        }
-    }
-
-    return 0;
-}
-
 /*!
  * @brief デバッグ時にアイテム生成情報をメッセージに出力する / Cheat -- describe a created object for the user
  * @param player_ptr プレイヤーへの参照ポインタ
@@ -117,6 +98,7 @@ static void set_ammo_quantity(ItemEntity *j_ptr)
  */
 bool make_object(PlayerType *player_ptr, ItemEntity *j_ptr, BIT_FLAGS mode, std::optional<int> rq_mon_level)
 {
+    RngStreamSelector rng_selector(RngStream::ITEM_GENERATION);
     auto *floor_ptr = player_ptr->current_floor_ptr;
     auto prob = any_bits(mode, AM_GOOD) ? 10 : 1000;
     auto base = get_base_floor(floor_ptr, mode, rq_mon_level);
@@ -159,6 +141,7 @@ bool make_object(PlayerType *player_ptr, ItemEntity *j_ptr, BIT_FLAGS mode, std:
  */
 bool make_gold(PlayerType *player_ptr, ItemEntity *j_ptr)
 {
+    RngStreamSelector rng_selector(RngStream::ITEM_GENERATION);
     const auto &floor = *player_ptr->current_floor_ptr;
     auto i = ((randint1(floor.object_level + 2) + 2) / 2) - 1;
     if (one_in_(CHANCE_BASEITEM_LEVEL_BOOST)) {
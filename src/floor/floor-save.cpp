@@ -12,6 +12,7 @@
 #include "floor/floor-save.h"
 #include "core/asking-player.h"
 #include "floor/floor-save-util.h"
+#include "floor/saved-floor-cache.h"
 #include "io/files-util.h"
 #include "io/uid-checker.h"
 #include "monster-race/monster-race.h"
@@ -62,6 +63,7 @@ static void check_saved_tmp_files(const int fd, bool *force)
  */
 void init_saved_floors(PlayerType *player_ptr, bool force)
 {
+    SavedFloorCache::get_instance().clear();
     auto fd = -1;
     for (int i = 0; i < MAX_SAVED_FLOORS; i++) {
         saved_floor_type *sf_ptr = &saved_floors[i];
@@ -90,6 +92,7 @@ void init_saved_floors(PlayerType *player_ptr, bool force)
  */
 void clear_saved_floor_files(PlayerType *player_ptr)
 {
+    SavedFloorCache::get_instance().clear();
     for (int i = 0; i < MAX_SAVED_FLOORS; i++) {
         saved_floor_type *sf_ptr = &saved_floors[i];
         if (!is_saved_floor(sf_ptr) || (sf_ptr->floor_id == player_ptr->floor_id)) {
@@ -140,6 +143,7 @@ void kill_saved_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr)
         return;
     }
 
+    SavedFloorCache::get_instance().erase(sf_ptr->savefile_id);
     safe_setuid_grab();
     (void)fd_kill(get_saved_floor_name((int)sf_ptr->savefile_id));
     safe_setuid_drop();
@@ -13,6 +13,7 @@
 #include "floor/line-of-sight.h"
 #include "game-option/birth-options.h"
 #include "grid/feature.h"
+#include "grid/grid.h"
 #include "perception/object-perception.h"
 #include "system/angband-system.h"
 #include "system/artifact-type-definition.h"
@@ -63,12 +64,10 @@ void update_smell(FloorType *floor_ptr, PlayerType *player_ptr)
         { -1, 0, 0, 0, -1 },
     };
 
+    auto &pathing_layer = floor_ptr->pathing_layer;
     if (++scent_when == 254) {
-        for (auto y = 0; y < floor_ptr->height; y++) {
-            for (auto x = 0; x < floor_ptr->width; x++) {
-                int w = floor_ptr->grid_array[y][x].when;
-                floor_ptr->grid_array[y][x].when = (w > 128) ? (w - 128) : 0;
-            }
+        for (auto &when : pathing_layer.whens.elements()) {
+            when = (when > 128) ? (when - 128) : 0;
         }
 
         scent_when = 126;
@@ -89,7 +88,7 @@ void update_smell(FloorType *floor_ptr, PlayerType *player_ptr)
                 continue;
             }
 
-            grid.when = scent_when + scent_adjust[i][j];
+            pathing_layer.set_when(pos, static_cast<byte>(scent_when + scent_adjust[i][j]));
         }
     }
 }
@@ -99,14 +98,9 @@ void update_smell(FloorType *floor_ptr, PlayerType *player_ptr)
  */
 void forget_flow(FloorType *floor_ptr)
 {
-    for (POSITION y = 0; y < floor_ptr->height; y++) {
-        for (POSITION x = 0; x < floor_ptr->width; x++) {
-            auto &grid = floor_ptr->grid_array[y][x];
-            grid.reset_costs();
-            grid.reset_dists();
-            floor_ptr->grid_array[y][x].when = 0;
-        }
-    }
+    floor_ptr->pathing_layer.reset_flow();
+    floor_ptr->pathing_layer.reset_whens();
+    invalidate_flow();
 }
 
 /*!
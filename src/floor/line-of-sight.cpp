@@ -1,7 +1,81 @@
 #include "floor/line-of-sight.h"
 #include "floor/cave.h"
+#include "floor/ray-table.h"
 #include "system/floor-type-definition.h"
 #include "system/player-type-definition.h"
+#include "world/world.h"
+
+namespace {
+SightCache los_cache;
+}
+
+uint32_t SightCache::current_generation = 1;
+
+/*!
+ * @brief キャッシュから判定結果を探す
+ * @param pos_src 始点の座標
+ * @param pos_dst 終点の座標
+ * @param range 射程 (射程によらない判定なら0)
+ * @return 判定結果 (今のゲームターンの間に記録されていなければstd::nullopt)
+ * @details フロアの生成中は地形が頻繁に変わるため、キャッシュを使わない
+ */
+std::optional<bool> SightCache::find(const Pos2D &pos_src, const Pos2D &pos_dst, int range) const
+{
+    if (!w_ptr->character_dungeon) {
+        return std::nullopt;
+    }
+
+    const auto key = make_key(pos_src, pos_dst, range);
+    const auto &entry = this->entries[get_index(key)];
+    if ((entry.key != key) || (entry.generation != current_generation) || (entry.game_turn != w_ptr->game_turn)) {
+        return std::nullopt;
+    }
+
+    return entry.result;
+}
+
+/*!
+ * @brief 判定結果をキャッシュに記録する
+ * @param pos_src 始点の座標
+ * @param pos_dst 終点の座標
+ * @param result 判定結果
+ * @param range 射程 (射程によらない判定なら0)
+ */
+void SightCache::store(const Pos2D &pos_src, const Pos2D &pos_dst, bool result, int range)
+{
+    if (!w_ptr->character_dungeon) {
+        return;
+    }
+
+    const auto key = make_key(pos_src, pos_dst, range);
+    this->entries[get_index(key)] = { key, current_generation, w_ptr->game_turn, result };
+}
+
+/*!
+ * @brief 地形の変化に伴い、全てのキャッシュの内容を破棄する
+ */
+void SightCache::invalidate_all()
+{
+    current_generation++;
+    if (current_generation == 0) {
+        current_generation = 1;
+    }
+}
+
+uint64_t SightCache::make_key(const Pos2D &pos_src, const Pos2D &pos_dst, int range)
+{
+    uint64_t key = static_cast<uint16_t>(range);
+    key = (key << 12) | static_cast<uint16_t>(pos_src.y);
+    key = (key << 12) | static_cast<uint16_t>(pos_src.x);
+    key = (key << 12) | static_cast<uint16_t>(pos_dst.y);
+    key = (key << 12) | static_cast<uint16_t>(pos_dst.x);
+    return key;
+}
+
+size_t SightCache::get_index(uint64_t key)
+{
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 52) % CACHE_SIZE;
+}
 
 /*!
  * @brief LOS(Line Of Sight / 視線が通っているか)の判定を行う。
@@ -12,6 +86,8 @@
  * @param x2 終点のx座標
  * @return LOSが通っているならTRUEを返す。
  * @details
+ * 経路は RayTable で事前計算したものを辿り、判定結果は1ゲームターンの間キャッシュする.\n
+ *\n
  * A simple, fast, integer-based line-of-sight algorithm.  By Joseph Hall,\n
  * 4116 Brewster Drive, Raleigh NC 27606.  Email to jnh@ecemwl.ncsu.edu.\n
  *\n
@@ -48,166 +124,22 @@
  */
 bool los(PlayerType *player_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION x2)
 {
-    POSITION dy = y2 - y1;
-    POSITION dx = x2 - x1;
-    POSITION ay = std::abs(dy);
-    POSITION ax = std::abs(dx);
-    if ((ax < 2) && (ay < 2)) {
-        return true;
-    }
-
-    /* Directly South/North */
-    auto *floor_ptr = player_ptr->current_floor_ptr;
-    POSITION tx, ty;
-    if (!dx) {
-        /* South -- check for walls */
-        if (dy > 0) {
-            for (ty = y1 + 1; ty < y2; ty++) {
-                if (!cave_los_bold(floor_ptr, ty, x1)) {
-                    return false;
-                }
-            }
-        }
-
-        /* North -- check for walls */
-        else {
-            for (ty = y1 - 1; ty > y2; ty--) {
-                if (!cave_los_bold(floor_ptr, ty, x1)) {
-                    return false;
-                }
-            }
-        }
-
-        /* Assume los */
-        return true;
-    }
-
-    /* Directly East/West */
-    if (!dy) {
-        /* East -- check for walls */
-        if (dx > 0) {
-            for (tx = x1 + 1; tx < x2; tx++) {
-                if (!cave_los_bold(floor_ptr, y1, tx)) {
-                    return false;
-                }
-            }
-        }
-
-        /* West -- check for walls */
-        else {
-            for (tx = x1 - 1; tx > x2; tx--) {
-                if (!cave_los_bold(floor_ptr, y1, tx)) {
-                    return false;
-                }
-            }
-        }
-
-        return true;
-    }
-
-    POSITION sx = (dx < 0) ? -1 : 1;
-    POSITION sy = (dy < 0) ? -1 : 1;
-
-    if (ax == 1) {
-        if (ay == 2) {
-            if (cave_los_bold(floor_ptr, y1 + sy, x1)) {
-                return true;
-            }
-        }
-    } else if (ay == 1) {
-        if (ax == 2) {
-            if (cave_los_bold(floor_ptr, y1, x1 + sx)) {
-                return true;
-            }
-        }
-    }
-
-    POSITION f2 = (ax * ay);
-    POSITION f1 = f2 << 1;
-    POSITION qy;
-    POSITION m;
-    if (ax >= ay) {
-        qy = ay * ay;
-        m = qy << 1;
-        tx = x1 + sx;
-        if (qy == f2) {
-            ty = y1 + sy;
-            qy -= f1;
-        } else {
-            ty = y1;
-        }
-
-        /* Note (below) the case (qy == f2), where */
-        /* the LOS exactly meets the corner of a tile. */
-        while (x2 - tx) {
-            if (!cave_los_bold(floor_ptr, ty, tx)) {
-                return false;
-            }
-
-            qy += m;
-
-            if (qy < f2) {
-                tx += sx;
-                continue;
-            }
-
-            if (qy > f2) {
-                ty += sy;
-                if (!cave_los_bold(floor_ptr, ty, tx)) {
-                    return false;
-                }
-                qy -= f1;
-                tx += sx;
-                continue;
-            }
-
-            ty += sy;
-            qy -= f1;
-            tx += sx;
-        }
-
+    const Pos2D pos_src(y1, x1);
+    const Pos2D pos_dst(y2, x2);
+    const auto vec = pos_dst - pos_src;
+    if ((std::abs(vec.y) < 2) && (std::abs(vec.x) < 2)) {
         return true;
     }
 
-    /* Travel vertically */
-    POSITION qx = ax * ax;
-    m = qx << 1;
-    ty = y1 + sy;
-    if (qx == f2) {
-        tx = x1 + sx;
-        qx -= f1;
-    } else {
-        tx = x1;
-    }
-
-    /* Note (below) the case (qx == f2), where */
-    /* the LOS exactly meets the corner of a tile. */
-    while (y2 - ty) {
-        if (!cave_los_bold(floor_ptr, ty, tx)) {
-            return false;
-        }
-
-        qx += m;
-
-        if (qx < f2) {
-            ty += sy;
-            continue;
-        }
-
-        if (qx > f2) {
-            tx += sx;
-            if (!cave_los_bold(floor_ptr, ty, tx)) {
-                return false;
-            }
-            qx -= f1;
-            ty += sy;
-            continue;
-        }
-
-        tx += sx;
-        qx -= f1;
-        ty += sy;
+    if (const auto result = los_cache.find(pos_src, pos_dst)) {
+        return *result;
     }
 
-    return true;
+    const auto *floor_ptr = player_ptr->current_floor_ptr;
+    const auto result = RayTable::get_instance().trace_los(vec, [floor_ptr, &pos_src](const Pos2DVec &cell) {
+        const auto pos = pos_src + cell;
+        return cave_los_bold(floor_ptr, pos.y, pos.x);
+    });
+    los_cache.store(pos_src, pos_dst, result);
+    return result;
 }
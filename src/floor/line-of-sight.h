@@ -1,6 +1,43 @@
 #pragma once
 
 #include "system/angband.h"
+#include "util/point-2d.h"
+#include <array>
+#include <cstdint>
+#include <optional>
+
+/*!
+ * @brief 2点間の視線・射線の判定結果のキャッシュ
+ * @details 1ゲームターンの間だけ結果を保持する. ターンの途中で地形が変わった時は invalidate_all() を呼び、
+ * 全てのインスタンスの内容を破棄すること. フロアの生成中 (character_dungeon が偽の間) は使わない.
+ */
+class SightCache {
+public:
+    SightCache() = default;
+
+    std::optional<bool> find(const Pos2D &pos_src, const Pos2D &pos_dst, int range = 0) const;
+    void store(const Pos2D &pos_src, const Pos2D &pos_dst, bool result, int range = 0);
+    static void invalidate_all();
+
+private:
+    /*!
+     * @brief キャッシュの要素
+     */
+    struct Entry {
+        uint64_t key = 0;
+        uint32_t generation = 0; //!< 0なら未使用
+        GAME_TURN game_turn = 0;
+        bool result = false;
+    };
+
+    static constexpr size_t CACHE_SIZE = 4096;
+    static uint32_t current_generation;
+
+    std::array<Entry, CACHE_SIZE> entries{};
+
+    static uint64_t make_key(const Pos2D &pos_src, const Pos2D &pos_dst, int range);
+    static size_t get_index(uint64_t key);
+};
 
 class PlayerType;
 bool los(PlayerType *player_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION x2);
@@ -0,0 +1,336 @@
+/*!
+ * @brief 下り階段の先のフロアの先行生成の検証
+ * @details 同じ乱数の種から、先行生成したフロアへ差し替えた場合とその場で生成した場合とで階段を降り、
+ * フロアの内容とモンスター種族の状態 (出現数・思い出) 、固定アーティファクトの生成済フラグ、乱数列の状態が一致するかを調べる.
+ * 先行生成してから階段を降りるまでの間に思い出が増えた場合とユニークを倒した場合も調べる.
+ */
+
+#include "floor/next-floor-preparation-check.h"
+#include "floor/floor-generation-benchmark.h"
+#include "floor/floor-generator.h"
+#include "floor/floor-util.h"
+#include "floor/next-floor-preparer.h"
+#include "monster-floor/monster-remover.h"
+#include "player/player-status-flags.h"
+#include "system/angband-system.h"
+#include "system/artifact-type-definition.h"
+#include "system/dungeon-info.h"
+#include "system/floor-type-definition.h"
+#include "system/grid-type-definition.h"
+#include "system/item-entity.h"
+#include "system/monster-entity.h"
+#include "system/monster-race-info.h"
+#include "system/player-type-definition.h"
+#include "system/terrain-type-definition.h"
+#include "term/z-rand.h"
+#include "util/enum-converter.h"
+#include "world/world.h"
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr auto MAX_CHECK_DEPTH = 98; //!< 検証する最深の階層 (最深層のクエストは対象外)
+
+/*!
+ * @brief 先行生成してから階段を降りるまでの間に起きること
+ */
+enum class DescentEvent {
+    NONE, //!< 何も起きない
+    LEARN_LORE, //!< 現在のフロアのモンスターの思い出が増える
+    KILL_UNIQUE, //!< ユニークを倒す
+    MAX,
+};
+
+/*!
+ * @brief 階段を降りた後の状態
+ */
+struct DescentResult {
+    std::vector<int64_t> floor_values; //!< フロアの内容を並べたもの
+    std::vector<MonraceGenerationState> monrace_states;
+    std::vector<bool> artifact_flags;
+    std::vector<Xoshiro128StarStar::state_type> rng_states;
+    Pos2D player_pos{ 0, 0 };
+    bool is_adopted = false; //!< 先行生成したフロアに差し替えたか
+};
+
+/*!
+ * @brief 階段を降りる前の状態
+ * @details 先行生成した後に保存し、2回目に階段を降りる前に書き戻す
+ */
+struct StairsState {
+    FloorType *floor_ptr;
+    FloorType floor;
+    Pos2D player_pos;
+    std::vector<MonraceGenerationState> monrace_states;
+    std::vector<bool> artifact_flags;
+    AngbandSystem::RngSnapshot rngs;
+};
+
+std::vector<bool> get_artifact_flags()
+{
+    std::vector<bool> flags;
+    for (const auto &[fa_id, artifact] : ArtifactList::get_instance()) {
+        flags.push_back(artifact.is_generated);
+    }
+
+    return flags;
+}
+
+/*!
+ * @brief フロアの地形・モンスター・アイテムを比較できる形に並べる
+ * @details モンスターの所在フロアへのポインタのように、フロアの実体によって異なるものは含めない
+ */
+std::vector<int64_t> get_floor_values(const FloorType &floor)
+{
+    std::vector<int64_t> values{ floor.dungeon_idx, floor.dun_level, floor.base_level, floor.object_level, floor.monster_level, floor.width, floor.height,
+        floor.num_repro, floor.o_max, floor.o_cnt, floor.m_max, floor.m_cnt };
+    for (auto y = 0; y < floor.height; y++) {
+        for (const auto &grid : floor.grid_array[y].first(floor.width)) {
+            values.insert(values.end(), { grid.info, grid.feat, grid.mimic, grid.m_idx, grid.special });
+            for (const auto o_idx : grid.o_idx_list) {
+                values.push_back(o_idx);
+            }
+        }
+    }
+
+    for (auto i = 1; i < floor.m_max; i++) {
+        const auto &monster = floor.m_list[i];
+        values.insert(values.end(), { enum2i(monster.r_idx), enum2i(monster.ap_r_idx), monster.sub_align, monster.fy, monster.fx, monster.hp, monster.maxhp,
+                                        monster.max_maxhp, monster.mspeed, monster.energy_need, monster.ml, monster.exp, monster.parent_m_idx });
+        for (const auto timed : monster.mtimed) {
+            values.push_back(timed);
+        }
+
+        for (const auto o_idx : monster.hold_o_idx_list) {
+            values.push_back(o_idx);
+        }
+    }
+
+    for (auto i = 1; i < floor.o_max; i++) {
+        const auto &item = floor.o_list[i];
+        values.insert(values.end(), { item.bi_id, item.iy, item.ix, item.stack_idx, item.pval, item.discount, item.number, item.weight, enum2i(item.fa_id),
+                                        enum2i(item.ego_idx), item.to_h, item.to_d, item.to_a, item.ac, item.dd, item.ds, item.timeout, item.ident,
+                                        item.held_m_idx });
+    }
+
+    return values;
+}
+
+DescentResult get_descent_result(PlayerType *player_ptr, const FloorType *floor_ptr_before)
+{
+    std::vector<Xoshiro128StarStar::state_type> rng_states;
+    for (const auto &rng : AngbandSystem::get_instance().snapshot_rngs()) {
+        rng_states.push_back(rng.get_state());
+    }
+
+    return {
+        .floor_values = get_floor_values(*player_ptr->current_floor_ptr),
+        .monrace_states = get_monrace_generation_states(),
+        .artifact_flags = get_artifact_flags(),
+        .rng_states = std::move(rng_states),
+        .player_pos = player_ptr->get_position(),
+        .is_adopted = player_ptr->current_floor_ptr != floor_ptr_before,
+    };
+}
+
+/*!
+ * @brief 階段を降りて、移動先のフロアを生成する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param dun_level 降りた先の階層
+ * @param is_descending 下り階段を降りたことを記録するか (偽ならば先行生成したフロアは使われない)
+ * @details change_floor() の内、フロアを離れる処理と移動先のフロアを生成する処理だけを行う
+ */
+DescentResult descend(PlayerType *player_ptr, DEPTH dun_level, bool is_descending)
+{
+    auto &preparer = NextFloorPreparer::get_instance();
+    if (is_descending) {
+        preparer.start_descent();
+    } else {
+        preparer.discard();
+    }
+
+    auto *floor_ptr = player_ptr->current_floor_ptr;
+    wipe_o_list(floor_ptr);
+    wipe_monsters_list(player_ptr);
+    floor_ptr->dun_level = dun_level;
+    w_ptr->character_dungeon = false;
+    preparer.generate_floor(player_ptr);
+    w_ptr->character_dungeon = true;
+    auto result = get_descent_result(player_ptr, floor_ptr);
+    preparer.discard();
+    return result;
+}
+
+/*!
+ * @brief 通常の下り階段を探し、その上にプレイヤーを置く
+ * @return 降りた先の階層 (下り階段がなければnullopt)
+ */
+std::optional<DEPTH> put_player_on_down_stairs(PlayerType *player_ptr)
+{
+    const auto &floor = *player_ptr->current_floor_ptr;
+    for (auto y = 0; y < floor.height; y++) {
+        for (auto x = 0; x < floor.width; x++) {
+            const auto &terrain = floor.grid_array[y][x].get_terrain();
+            if (terrain.flags.has_not(TerrainCharacteristics::MORE) || terrain.flags.has_not(TerrainCharacteristics::STAIRS)) {
+                continue;
+            }
+
+            if (terrain.flags.has_any_of({ TerrainCharacteristics::TRAP, TerrainCharacteristics::QUEST, TerrainCharacteristics::SPECIAL })) {
+                continue;
+            }
+
+            player_ptr->y = y;
+            player_ptr->x = x;
+            return floor.dun_level + (terrain.flags.has(TerrainCharacteristics::SHAFT) ? 2 : 1);
+        }
+    }
+
+    return std::nullopt;
+}
+
+/*!
+ * @brief 先行生成してから階段を降りるまでの間の出来事を起こす
+ * @return 先行生成したフロアへ差し替えるべきか
+ */
+bool occur_descent_event(PlayerType *player_ptr, DescentEvent event)
+{
+    const auto &floor = *player_ptr->current_floor_ptr;
+    auto &monraces = MonraceList::get_instance();
+    switch (event) {
+    case DescentEvent::LEARN_LORE:
+        for (auto i = 1; i < floor.m_max; i++) {
+            const auto &monster = floor.m_list[i];
+            if (!monster.is_valid()) {
+                continue;
+            }
+
+            auto &monrace = monster.get_real_monrace();
+            monrace.r_sights++;
+            monrace.r_pkills++;
+            monrace.r_tkills++;
+            monrace.r_kind_flags.set(monrace.kind_flags);
+            break;
+        }
+
+        return true;
+    case DescentEvent::KILL_UNIQUE:
+        for (auto &[monrace_id, monrace] : monraces) {
+            if (monrace.kind_flags.has(MonsterKindType::UNIQUE) && (monrace.max_num > 0) && (monrace.level <= floor.dun_level + 1)) {
+                monrace.max_num = 0;
+                return false;
+            }
+        }
+
+        return true;
+    default:
+        return true;
+    }
+}
+
+/*!
+ * @brief 2つの結果の食い違いを出力する
+ * @return 一致したか
+ */
+bool output_differences(std::ostream &os, const std::string &label, const DescentResult &adopted, const DescentResult &generated)
+{
+    auto is_same = true;
+    const auto check = [&](bool is_matched, const char *what) {
+        if (!is_matched) {
+            os << label << ": " << what << " differ\n";
+            is_same = false;
+        }
+    };
+
+    check(adopted.floor_values == generated.floor_values, "floors");
+    check(adopted.monrace_states == generated.monrace_states, "monster races");
+    check(adopted.artifact_flags == generated.artifact_flags, "artifacts");
+    check(adopted.rng_states == generated.rng_states, "RNG states");
+    check(adopted.player_pos == generated.player_pos, "player positions");
+    return is_same;
+}
+}
+
+/*!
+ * @brief 先行生成したフロアへの差し替えが、その場で生成したフロアと一致するかを検証する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param floors 検証するフロアの数
+ * @param seed 乱数の種の基準値
+ * @param os 出力先
+ * @return 全て一致したか
+ * @details 鉄獄の浅い階層から順に、乱数の種を変えながらフロアを生成して下り階段の上で先行生成し、
+ * 差し替えた場合とその場で生成した場合とで階段を降りた後の状態を比べる.
+ * プレイヤーとフロアの状態は上書きするため、ゲームを始める前に呼ぶこと.
+ */
+bool output_next_floor_preparation_check(PlayerType *player_ptr, int floors, uint32_t seed, std::ostream &os)
+{
+    setup_floor_generation_player(player_ptr);
+
+    // テレパシーがあれば、生成したフロアのモンスターが見えて思い出が増える
+    player_ptr->telepathy = FLAG_CAUSE_MAGIC_TIME_EFFECT;
+    auto &preparer = NextFloorPreparer::get_instance();
+    auto checked = 0;
+    auto adopted = 0;
+    auto failed = 0;
+    for (auto i = 0; i < floors; i++) {
+        const auto depth = 1 + i % MAX_CHECK_DEPTH;
+        const auto event = i2enum<DescentEvent>(i % enum2i(DescentEvent::MAX));
+        const auto label = "floor " + std::to_string(i) + " (depth " + std::to_string(depth) + ", event " + std::to_string(enum2i(event)) + ")";
+        Rand_state_init(seed + i);
+        auto &floor = *player_ptr->current_floor_ptr;
+        floor.set_dungeon_index(DUNGEON_ANGBAND);
+        floor.dun_level = depth;
+        w_ptr->character_dungeon = false;
+        generate_floor(player_ptr);
+        w_ptr->character_dungeon = true;
+        if (floor.is_in_quest()) {
+            continue;
+        }
+
+        const auto next_depth = put_player_on_down_stairs(player_ptr);
+        if (!next_depth || !preparer.prepare(player_ptr)) {
+            continue;
+        }
+
+        const auto should_adopt = occur_descent_event(player_ptr, event);
+        const StairsState state{
+            .floor_ptr = player_ptr->current_floor_ptr,
+            .floor = *player_ptr->current_floor_ptr,
+            .player_pos = player_ptr->get_position(),
+            .monrace_states = get_monrace_generation_states(),
+            .artifact_flags = get_artifact_flags(),
+            .rngs = AngbandSystem::get_instance().snapshot_rngs(),
+        };
+        const auto result_adopted = descend(player_ptr, *next_depth, true);
+
+        player_ptr->current_floor_ptr = state.floor_ptr;
+        *state.floor_ptr = state.floor;
+        player_ptr->y = state.player_pos.y;
+        player_ptr->x = state.player_pos.x;
+        set_monrace_generation_states(state.monrace_states);
+        auto it = state.artifact_flags.begin();
+        for (auto &[fa_id, artifact] : ArtifactList::get_instance()) {
+            artifact.is_generated = *it++;
+        }
+
+        AngbandSystem::get_instance().restore_rngs(state.rngs);
+        const auto result_generated = descend(player_ptr, *next_depth, false);
+
+        checked++;
+        auto is_passed = output_differences(os, label, result_adopted, result_generated);
+        if (result_adopted.is_adopted != should_adopt) {
+            os << label << ": the prepared floor was " << (should_adopt ? "not adopted" : "adopted") << '\n';
+            is_passed = false;
+        }
+
+        adopted += result_adopted.is_adopted ? 1 : 0;
+        failed += is_passed ? 0 : 1;
+        wipe_o_list(player_ptr->current_floor_ptr);
+        wipe_monsters_list(player_ptr);
+    }
+
+    os << "checked: " << checked << ", adopted: " << adopted << ", failed: " << failed << '\n';
+    w_ptr->character_dungeon = false;
+    return failed == 0;
+}
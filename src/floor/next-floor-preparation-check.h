@@ -0,0 +1,7 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+
+class PlayerType;
+bool output_next_floor_preparation_check(PlayerType *player_ptr, int floors, uint32_t seed, std::ostream &os);
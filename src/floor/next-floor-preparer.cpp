@@ -0,0 +1,514 @@
+/*!
+ * @brief 下り階段の先のフロアの先行生成
+ * @details 深い階層の洞窟や迷宮は生成に時間がかかり、階段を降りる度に待たされる.
+ * キー入力を待つ間に生成を済ませておき、階段を降りた時にはフロアを差し替えるだけで済ませる.
+ */
+
+#include "floor/next-floor-preparer.h"
+#include "dungeon/quest.h"
+#include "floor/floor-generator.h"
+#include "floor/floor-save-util.h"
+#include "floor/floor-save.h"
+#include "floor/floor-util.h"
+#include "floor/line-of-sight.h"
+#include "floor/wild.h"
+#include "game-option/birth-options.h"
+#include "grid/grid.h"
+#include "monster-floor/monster-lite.h"
+#include "monster/monster-util.h"
+#include "player/attack-defense-types.h"
+#include "system/angband-system.h"
+#include "system/artifact-type-definition.h"
+#include "system/gamevalue.h"
+#include "system/grid-type-definition.h"
+#include "system/item-entity.h"
+#include "system/monster-entity.h"
+#include "system/monster-race-info.h"
+#include "system/player-type-definition.h"
+#include "system/redrawing-flags-updater.h"
+#include "system/terrain-type-definition.h"
+#include "target/target-checker.h"
+#include "window/main-window-util.h"
+#include "world/world.h"
+#include <algorithm>
+#include <array>
+#include <set>
+#include <utility>
+
+namespace {
+/*!
+ * @brief 全クエストの状態を取得する
+ */
+std::vector<QuestStatusType> get_quest_statuses()
+{
+    std::vector<QuestStatusType> statuses;
+    for (const auto &[quest_id, quest] : QuestList::get_instance()) {
+        statuses.push_back(quest.status);
+    }
+
+    return statuses;
+}
+
+/*!
+ * @brief 全固定アーティファクトの生成済フラグを取得する
+ */
+std::vector<bool> get_artifact_flags()
+{
+    std::vector<bool> flags;
+    for (const auto &[fa_id, artifact] : ArtifactList::get_instance()) {
+        flags.push_back(artifact.is_generated);
+    }
+
+    return flags;
+}
+
+/*!
+ * @brief 全固定アーティファクトの生成済フラグを設定する
+ * @param flags get_artifact_flags() で取得した生成済フラグ
+ */
+void set_artifact_flags(const std::vector<bool> &flags)
+{
+    auto it = flags.begin();
+    for (auto &[fa_id, artifact] : ArtifactList::get_instance()) {
+        artifact.is_generated = *it++;
+    }
+}
+
+/*!
+ * @brief 現在のフロアを離れた後の、全固定アーティファクトの生成済フラグを計算する
+ * @param floor 現在のフロアへの参照
+ * @return 生成済フラグ
+ * @details 保存モードでは、フロアを離れる時に wipe_o_list() が未鑑定のまま床に残っている固定アーティファクトを未生成に戻す.
+ */
+std::vector<bool> calc_artifact_flags_after_leaving(const FloorType &floor)
+{
+    std::set<FixedArtifactId> lost_fa_ids;
+    if (preserve_mode) {
+        for (auto i = 1; i < floor.o_max; i++) {
+            const auto &item = floor.o_list[i];
+            if (item.is_valid() && item.is_fixed_artifact() && !item.is_known()) {
+                lost_fa_ids.insert(item.fa_id);
+            }
+        }
+    }
+
+    std::vector<bool> flags;
+    for (const auto &[fa_id, artifact] : ArtifactList::get_instance()) {
+        flags.push_back(artifact.is_generated && !lost_fa_ids.contains(fa_id));
+    }
+
+    return flags;
+}
+
+/*!
+ * @brief 騎乗中のモンスターや連れて行くペットがいるか
+ * @details ペットはフロアを離れる時に party_mon[] へ移され、移動先のフロアの生成時に出現数へ数えられる.
+ */
+bool has_companions(PlayerType *player_ptr)
+{
+    const auto is_valid = [](const auto &monster) { return monster.is_valid(); };
+    return (player_ptr->riding != 0) || std::any_of(std::begin(party_mon), std::end(party_mon), is_valid);
+}
+
+/*!
+ * @brief 足元の下り階段を降りた先の階層を求める
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @return 降りた先の階層 (先行生成できる普通の下り階段の上にいなければnullopt)
+ * @details クエストの階段、落とし戸、訪れたことのあるフロアへ繋がる階段は対象外とする.
+ */
+std::optional<DEPTH> calc_descent_level(PlayerType *player_ptr)
+{
+    const auto &floor = *player_ptr->current_floor_ptr;
+    auto can_prepare = w_ptr->character_dungeon && !player_ptr->wild_mode && floor.is_in_underground();
+    can_prepare &= !floor.is_in_quest() && !floor.inside_arena && !AngbandSystem::get_instance().is_phase_out();
+    can_prepare &= (player_ptr->action == ACTION_NONE) && !has_companions(player_ptr);
+    if (!can_prepare) {
+        return std::nullopt;
+    }
+
+    const auto &grid = floor.get_grid(player_ptr->get_position());
+    const auto &terrain = grid.get_terrain();
+    if (terrain.flags.has_not(TerrainCharacteristics::MORE) || terrain.flags.has_not(TerrainCharacteristics::STAIRS)) {
+        return std::nullopt;
+    }
+
+    if (terrain.flags.has_any_of({ TerrainCharacteristics::TRAP, TerrainCharacteristics::QUEST, TerrainCharacteristics::QUEST_ENTER, TerrainCharacteristics::SPECIAL })) {
+        return std::nullopt;
+    }
+
+    if (grid.special != 0) {
+        const auto *sf_ptr = get_sf_ptr(grid.special);
+        if ((sf_ptr != nullptr) && (sf_ptr->last_visit != 0)) {
+            return std::nullopt;
+        }
+    }
+
+    return floor.dun_level + (terrain.flags.has(TerrainCharacteristics::SHAFT) ? 2 : 1);
+}
+
+/*!
+ * @brief フロアの生成に用いる乱数列の状態を取得する
+ * @details フロアの生成中に置かれるアイテムはアイテム生成の乱数列で生成される
+ */
+std::array<Xoshiro128StarStar::state_type, 2> get_floor_rng_states()
+{
+    auto &system = AngbandSystem::get_instance();
+    return { { system.get_rng(RngStream::FLOOR_GENERATION).get_state(), system.get_rng(RngStream::ITEM_GENERATION).get_state() } };
+}
+
+/*!
+ * @brief フロアの生成に用いる乱数列の状態を設定する
+ * @param states get_floor_rng_states() で取得した乱数列の状態
+ */
+void set_floor_rng_states(const std::array<Xoshiro128StarStar::state_type, 2> &states)
+{
+    auto &system = AngbandSystem::get_instance();
+    system.get_rng(RngStream::FLOOR_GENERATION).set_state(states[0]);
+    system.get_rng(RngStream::ITEM_GENERATION).set_state(states[1]);
+}
+
+/*!
+ * @brief 全モンスター種族の最大出現数を取得する
+ * @details 撃破したユニークとナズグルの最大出現数は減り、フロアの生成で出現できるモンスターが変わる
+ */
+std::vector<MONSTER_NUMBER> get_monrace_max_nums()
+{
+    std::vector<MONSTER_NUMBER> max_nums;
+    for (const auto &[monrace_id, monrace] : MonraceList::get_instance()) {
+        max_nums.push_back(monrace.max_num);
+    }
+
+    return max_nums;
+}
+
+/*!
+ * @brief 先行生成でモンスター種族の状態に加わった変化を、現在の状態に加える
+ * @param before 先行生成する直前の状態
+ * @param after 先行生成した後の状態
+ * @details 出現数はフロアの生成で数え直されるため、生成した後の値をそのまま設定する.
+ * 先行生成してから階段を降りるまでに現在のフロアで思い出が増えていることがあるため、
+ * 目撃数等の数は生成で増えた分だけを足し、思い出のフラグは生成で立ったものを立てる.
+ */
+void apply_monrace_generation_changes(const std::vector<MonraceGenerationState> &before, const std::vector<MonraceGenerationState> &after)
+{
+    auto it_before = before.begin();
+    auto it_after = after.begin();
+    for (auto &[monrace_id, monrace] : MonraceList::get_instance()) {
+        const auto &state_before = *it_before++;
+        const auto &state_after = *it_after++;
+        monrace.cur_num = state_after.cur_num;
+        if (state_after.max_num != state_before.max_num) {
+            monrace.max_num = state_after.max_num;
+        }
+
+        if (state_after.floor_id != state_before.floor_id) {
+            monrace.floor_id = state_after.floor_id;
+        }
+
+        monrace.r_sights = std::min<MONSTER_NUMBER>(monrace.r_sights + state_after.r_sights - state_before.r_sights, MAX_SHORT);
+        monrace.r_pkills += state_after.r_pkills - state_before.r_pkills;
+        monrace.r_akills += state_after.r_akills - state_before.r_akills;
+        monrace.r_tkills = std::min<MONSTER_NUMBER>(monrace.r_tkills + state_after.r_tkills - state_before.r_tkills, MAX_SHORT);
+        monrace.r_kind_flags.set(state_after.r_kind_flags);
+        monrace.r_misc_flags.set(state_after.r_misc_flags);
+    }
+}
+
+/*!
+ * @brief 先行生成の間、フロアの生成が書き換える大域的な状態を退避しておくスコープ
+ * @details 作った時に状態を退避し、スコープを抜ける時に復元する. 退避・復元する状態はここに集める.
+ */
+class GenerationStateGuard {
+public:
+    explicit GenerationStateGuard(PlayerType *player_ptr);
+    ~GenerationStateGuard();
+    GenerationStateGuard(const GenerationStateGuard &) = delete;
+    GenerationStateGuard(GenerationStateGuard &&) = delete;
+    GenerationStateGuard &operator=(const GenerationStateGuard &) = delete;
+    GenerationStateGuard &operator=(GenerationStateGuard &&) = delete;
+
+private:
+    PlayerType *player_ptr;
+    FloorType *floor_ptr;
+    std::vector<MonraceGenerationState> monrace_states;
+    std::vector<bool> artifact_flags;
+    std::vector<PROB> mon_num_weights;
+    AngbandSystem::RngSnapshot rngs;
+    Pos2D player_pos;
+    bool enter_dungeon;
+    bool dtrap;
+    bool ambush_flag;
+    MONSTER_IDX target_who;
+    MONSTER_IDX pet_t_m_idx;
+    MONSTER_IDX riding_t_m_idx;
+    IDX health_who;
+    std::array<POSITION, 4> panels;
+};
+
+GenerationStateGuard::GenerationStateGuard(PlayerType *player_ptr)
+    : player_ptr(player_ptr)
+    , floor_ptr(player_ptr->current_floor_ptr)
+    , monrace_states(get_monrace_generation_states())
+    , artifact_flags(get_artifact_flags())
+    , mon_num_weights(get_mon_num_weights())
+    , rngs(AngbandSystem::get_instance().snapshot_rngs())
+    , player_pos(player_ptr->get_position())
+    , enter_dungeon(player_ptr->enter_dungeon)
+    , dtrap(player_ptr->dtrap)
+    , ambush_flag(player_ptr->ambush_flag)
+    , target_who(::target_who)
+    , pet_t_m_idx(player_ptr->pet_t_m_idx)
+    , riding_t_m_idx(player_ptr->riding_t_m_idx)
+    , health_who(player_ptr->health_who)
+    , panels{ { panel_row_min, panel_row_max, panel_col_min, panel_col_max } }
+{
+}
+
+GenerationStateGuard::~GenerationStateGuard()
+{
+    this->player_ptr->current_floor_ptr = this->floor_ptr;
+    AngbandSystem::get_instance().restore_rngs(this->rngs);
+    panel_row_min = this->panels[0];
+    panel_row_max = this->panels[1];
+    panel_col_min = this->panels[2];
+    panel_col_max = this->panels[3];
+    this->player_ptr->health_who = this->health_who;
+    this->player_ptr->riding_t_m_idx = this->riding_t_m_idx;
+    this->player_ptr->pet_t_m_idx = this->pet_t_m_idx;
+    ::target_who = this->target_who;
+    this->player_ptr->ambush_flag = this->ambush_flag;
+    this->player_ptr->dtrap = this->dtrap;
+    this->player_ptr->enter_dungeon = this->enter_dungeon;
+    this->player_ptr->y = this->player_pos.y;
+    this->player_ptr->x = this->player_pos.x;
+    w_ptr->character_dungeon = true;
+    set_mon_num_weights(this->mon_num_weights);
+    set_artifact_flags(this->artifact_flags);
+    set_monrace_generation_states(this->monrace_states);
+    set_floor_and_wall(this->floor_ptr->dungeon_idx);
+    invalidate_flow();
+    invalidate_mon_lite_cache();
+    SightCache::invalidate_all();
+    RedrawingFlagsUpdater::get_instance().set_flag(MainWindowRedrawingFlag::MAP);
+}
+}
+
+/*!
+ * @brief 全モンスター種族の、フロアの生成で書き換わる状態を取得する
+ */
+std::vector<MonraceGenerationState> get_monrace_generation_states()
+{
+    std::vector<MonraceGenerationState> states;
+    for (const auto &[monrace_id, monrace] : MonraceList::get_instance()) {
+        states.push_back({ monrace.max_num, monrace.cur_num, monrace.floor_id, monrace.r_sights, monrace.r_pkills, monrace.r_akills, monrace.r_tkills,
+            monrace.r_kind_flags, monrace.r_misc_flags });
+    }
+
+    return states;
+}
+
+/*!
+ * @brief 全モンスター種族の、フロアの生成で書き換わる状態を設定する
+ * @param states get_monrace_generation_states() で取得した状態
+ */
+void set_monrace_generation_states(const std::vector<MonraceGenerationState> &states)
+{
+    auto it = states.begin();
+    for (auto &[monrace_id, monrace] : MonraceList::get_instance()) {
+        const auto &state = *it++;
+        monrace.max_num = state.max_num;
+        monrace.cur_num = state.cur_num;
+        monrace.floor_id = state.floor_id;
+        monrace.r_sights = state.r_sights;
+        monrace.r_pkills = state.r_pkills;
+        monrace.r_akills = state.r_akills;
+        monrace.r_tkills = state.r_tkills;
+        monrace.r_kind_flags = state.r_kind_flags;
+        monrace.r_misc_flags = state.r_misc_flags;
+    }
+}
+
+NextFloorPreparer NextFloorPreparer::instance{};
+
+NextFloorPreparer &NextFloorPreparer::get_instance()
+{
+    return instance;
+}
+
+/*!
+ * @brief 先行生成中か
+ * @details 先行生成中のフロアはまだプレイヤーのいるフロアではないため、生成のやり直し等のメッセージを表示しない
+ */
+bool NextFloorPreparer::is_preparing() const
+{
+    return this->preparing;
+}
+
+/*!
+ * @brief 足元の下り階段を降りた先のフロアを先行生成する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @return フロアを生成したか
+ * @details キー入力を待つ直前に呼ぶ. 普通の下り階段の上にいなければ何もしない.
+ * 生成は階段の上に来る度に1回だけ行い、その後に前提条件が変わっても生成し直さない.
+ * (階段の上で戦い続ける間、キー入力を待つ度に生成し直して待たされないようにする)
+ */
+bool NextFloorPreparer::prepare(PlayerType *player_ptr)
+{
+    const auto player_pos = player_ptr->get_position();
+    if (this->visited_stair_pos != player_pos) {
+        this->visited_stair_pos.reset();
+    }
+
+    if (this->visited_stair_pos) {
+        return false;
+    }
+
+    const auto dun_level = calc_descent_level(player_ptr);
+    if (!dun_level) {
+        return false;
+    }
+
+    auto &floor = *player_ptr->current_floor_ptr;
+    Condition condition{
+        .floor_id = player_ptr->floor_id,
+        .dungeon_idx = floor.dungeon_idx,
+        .dun_level = *dun_level,
+        .player_level = player_ptr->lev,
+        .rng_states = get_floor_rng_states(),
+        .quest_statuses = get_quest_statuses(),
+        .artifact_flags = calc_artifact_flags_after_leaving(floor),
+    };
+    this->visited_stair_pos = player_pos;
+    this->prepared_condition.reset();
+    auto &next_floor = this->get_spare_floor(player_ptr);
+    next_floor.set_dungeon_index(floor.dungeon_idx);
+    next_floor.dun_level = *dun_level;
+    next_floor.quest_number = QuestId::NONE;
+    next_floor.inside_arena = false;
+    next_floor.num_repro = 0;
+    {
+        GenerationStateGuard guard(player_ptr);
+
+        // change_floor() でフロアを離れてから生成するまでと同じ状態にする
+        MonraceList::get_instance().defeat_separated_uniques();
+        condition.monrace_max_nums = get_monrace_max_nums();
+        this->monrace_states_before_generation = get_monrace_generation_states();
+        set_artifact_flags(condition.artifact_flags);
+        w_ptr->character_dungeon = false;
+        player_ptr->dtrap = false;
+        player_ptr->ambush_flag = false;
+        panel_row_min = panel_row_max = panel_col_min = panel_col_max = 0;
+        player_ptr->current_floor_ptr = &next_floor;
+        this->preparing = true;
+        ::generate_floor(player_ptr);
+        this->preparing = false;
+        this->prepared_player_pos = player_ptr->get_position();
+        this->prepared_artifact_flags = get_artifact_flags();
+        this->prepared_rng_states = get_floor_rng_states();
+        this->prepared_monrace_states = get_monrace_generation_states();
+    }
+
+    this->prepared_floor_ptr = &next_floor;
+    this->prepared_condition = std::move(condition);
+    return true;
+}
+
+/*!
+ * @brief 下り階段を降りたことを記録する
+ */
+void NextFloorPreparer::start_descent()
+{
+    this->is_descending = true;
+}
+
+/*!
+ * @brief 移動先のフロアを生成する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @details 下り階段を降りた時は、先行生成したフロアが使えればそれに差し替える.
+ * それ以外の時は通常通りに生成する.
+ */
+void NextFloorPreparer::generate_floor(PlayerType *player_ptr)
+{
+    if (!std::exchange(this->is_descending, false)) {
+        ::generate_floor(player_ptr);
+        return;
+    }
+
+    const auto &floor = *player_ptr->current_floor_ptr;
+    const Condition condition{
+        .floor_id = player_ptr->floor_id,
+        .dungeon_idx = floor.dungeon_idx,
+        .dun_level = floor.dun_level,
+        .player_level = player_ptr->lev,
+        .rng_states = get_floor_rng_states(),
+        .quest_statuses = get_quest_statuses(),
+        .artifact_flags = get_artifact_flags(),
+        .monrace_max_nums = get_monrace_max_nums(),
+    };
+    if (!has_companions(player_ptr) && this->adopt(player_ptr, condition)) {
+        return;
+    }
+
+    ::generate_floor(player_ptr);
+}
+
+/*!
+ * @brief 先行生成したフロアと階段の上に来た記録、階段を降りた記録を破棄する
+ * @details フロアを切り替えたら呼ぶ
+ */
+void NextFloorPreparer::discard()
+{
+    this->prepared_condition.reset();
+    this->prepared_floor_ptr = nullptr;
+    this->visited_stair_pos.reset();
+    this->is_descending = false;
+}
+
+/*!
+ * @brief 予備のフロアを取得する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @return 現在のフロアでない方のフロア
+ */
+FloorType &NextFloorPreparer::get_spare_floor(PlayerType *player_ptr)
+{
+    auto &spare_floor = (player_ptr->current_floor_ptr == &floor_info) ? this->floor : floor_info;
+    if (spare_floor.o_list.empty()) {
+        spare_floor.o_list.assign(MAX_FLOOR_ITEMS, {});
+        spare_floor.m_list.assign(MAX_FLOOR_MONSTERS, {});
+        for (auto &list : spare_floor.mproc_list) {
+            list.assign(MAX_FLOOR_MONSTERS, {});
+        }
+
+        spare_floor.grid_array.assign(MAX_HGT, MAX_WID);
+    }
+
+    return spare_floor;
+}
+
+/*!
+ * @brief 先行生成したフロアを現在のフロアと差し替える
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param condition 階段を降りた時点の前提条件
+ * @return 差し替えたか (先行生成していないか、前提条件が変わっていれば偽)
+ * @details 差し替えた後のモンスター種族の出現数や思い出は、その場で generate_floor() を呼んだ時と同じになるように設定する.
+ */
+bool NextFloorPreparer::adopt(PlayerType *player_ptr, const Condition &condition)
+{
+    auto *next_floor_ptr = std::exchange(this->prepared_floor_ptr, nullptr);
+    const auto prepared_condition = std::exchange(this->prepared_condition, std::nullopt);
+    if ((next_floor_ptr == nullptr) || (next_floor_ptr == player_ptr->current_floor_ptr) || (prepared_condition != condition)) {
+        return false;
+    }
+
+    player_ptr->current_floor_ptr = next_floor_ptr;
+    set_artifact_flags(this->prepared_artifact_flags);
+    set_floor_rng_states(this->prepared_rng_states);
+    apply_monrace_generation_changes(this->monrace_states_before_generation, this->prepared_monrace_states);
+    player_ptr->y = this->prepared_player_pos.y;
+    player_ptr->x = this->prepared_player_pos.x;
+    player_ptr->enter_dungeon = false;
+    set_floor_and_wall(next_floor_ptr->dungeon_idx);
+    invalidate_flow();
+    invalidate_mon_lite_cache();
+    return true;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "monster-race/race-kind-flags.h"
+#include "monster-race/race-misc-flags.h"
+#include "system/angband.h"
+#include "system/floor-type-definition.h"
+#include "util/flag-group.h"
+#include "util/point-2d.h"
+#include "util/rng-xoshiro.h"
+#include <array>
+#include <optional>
+#include <vector>
+
+enum class QuestStatusType : short;
+class PlayerType;
+
+/*!
+ * @brief フロアの生成で書き換わるモンスター種族の状態
+ * @details 出現数と所在、分離ユニークの撃破による撃破数、生成時に見えたモンスターの思い出が書き換わる
+ */
+struct MonraceGenerationState {
+    MONSTER_NUMBER max_num;
+    MONSTER_NUMBER cur_num;
+    FLOOR_IDX floor_id;
+    MONSTER_NUMBER r_sights;
+    MONSTER_NUMBER r_pkills;
+    MONSTER_NUMBER r_akills;
+    MONSTER_NUMBER r_tkills;
+    EnumClassFlagGroup<MonsterKindType> r_kind_flags;
+    EnumClassFlagGroup<MonsterMiscType> r_misc_flags;
+
+    bool operator==(const MonraceGenerationState &other) const = default;
+};
+
+std::vector<MonraceGenerationState> get_monrace_generation_states();
+void set_monrace_generation_states(const std::vector<MonraceGenerationState> &states);
+
+/*!
+ * @brief 下り階段の先のフロアの先行生成
+ * @details プレイヤーが下り階段の上でキー入力を待っている間に、降りた先のフロアを予備の FloorType へ生成しておく.
+ * 実際に階段を降りた時に前提条件が変わっていなければ、生成済のフロアを現在のフロアと差し替えるだけで済ませる.
+ *
+ * フロアの生成はフロア生成とアイテム生成の乱数列だけを消費する. キー入力待ちの時点からフロアを切り替えるまでに
+ * これらの乱数列が消費されておらず、クエストの状態やアーティファクトの生成済フラグ、モンスター種族の最大出現数等の
+ * 生成に関わる状態も変わっていなければ、差し替えたフロアはその場で生成したフロアと一致する.
+ *
+ * フロアの生成はモンスター種族の出現数やアーティファクトの生成済フラグ等の大域的な状態を書き換えるため、
+ * 先行生成はメインスレッドで行い、書き換えられる状態は生成の前後で退避・復元する.
+ * 生成は下り階段の上に来る度に1回だけ行う. 生成は途中で中断できず、その間はキー入力が待たされるため、
+ * prepare_next_floor オプションが有効な時だけ行う.
+ */
+class NextFloorPreparer {
+public:
+    NextFloorPreparer(const NextFloorPreparer &) = delete;
+    NextFloorPreparer(NextFloorPreparer &&) = delete;
+    NextFloorPreparer &operator=(const NextFloorPreparer &) = delete;
+    NextFloorPreparer &operator=(NextFloorPreparer &&) = delete;
+
+    static NextFloorPreparer &get_instance();
+    bool is_preparing() const;
+    bool prepare(PlayerType *player_ptr);
+    void start_descent();
+    void generate_floor(PlayerType *player_ptr);
+    void discard();
+
+private:
+    NextFloorPreparer() = default;
+
+    static NextFloorPreparer instance;
+
+    /*!
+     * @brief 生成したフロアを差し替えに使うための前提条件
+     */
+    struct Condition {
+        FLOOR_IDX floor_id = 0; //!< 階段のあるフロアのID
+        short dungeon_idx = 0; //!< ダンジョンID
+        DEPTH dun_level = 0; //!< 降りた先の階層
+        PLAYER_LEVEL player_level = 0; //!< プレイヤーのレベル
+        std::array<Xoshiro128StarStar::state_type, 2> rng_states{}; //!< 生成に用いるフロア生成とアイテム生成の乱数列の状態
+        std::vector<QuestStatusType> quest_statuses; //!< 全クエストの状態
+        std::vector<bool> artifact_flags; //!< フロアを離れた後の、全固定アーティファクトの生成済フラグ
+        std::vector<MONSTER_NUMBER> monrace_max_nums; //!< フロアを離れた後の、全モンスター種族の最大出現数 (ユニークやナズグルの撃破で減る)
+
+        bool operator==(const Condition &other) const = default;
+    };
+
+    FloorType floor; //!< 予備のフロア (現在のフロアが floor_info でない時は floor_info が予備となる)
+    FloorType *prepared_floor_ptr = nullptr; //!< 先行生成したフロア
+    std::optional<Condition> prepared_condition; //!< 先行生成したフロアの前提条件 (なければnullopt)
+    Pos2D prepared_player_pos{ 0, 0 }; //!< 先行生成したフロアでのプレイヤーの位置
+    std::vector<bool> prepared_artifact_flags; //!< 先行生成した後の、全固定アーティファクトの生成済フラグ
+    std::array<Xoshiro128StarStar::state_type, 2> prepared_rng_states{}; //!< 先行生成した後の、フロア生成とアイテム生成の乱数列の状態
+    std::vector<MonraceGenerationState> monrace_states_before_generation; //!< 先行生成する直前の、全モンスター種族の状態
+    std::vector<MonraceGenerationState> prepared_monrace_states; //!< 先行生成した後の、全モンスター種族の状態
+    std::optional<Pos2D> visited_stair_pos; //!< 先行生成を行った下り階段の位置 (その階段の上にいなければnullopt)
+    bool is_descending = false; //!< 下り階段を降りたか
+    bool preparing = false;
+
+    FloorType &get_spare_floor(PlayerType *player_ptr);
+    bool adopt(PlayerType *player_ptr, const Condition &condition);
+};
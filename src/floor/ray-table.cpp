@@ -0,0 +1,47 @@
+#include "floor/ray-table.h"
+
+RayTable RayTable::instance{};
+
+RayTable::RayTable()
+{
+    const auto width = RADIUS * 2 + 1;
+    this->rays.resize(width * width);
+    for (auto dy = -RADIUS; dy <= RADIUS; dy++) {
+        for (auto dx = -RADIUS; dx <= RADIUS; dx++) {
+            const Pos2DVec vec(dy, dx);
+            auto &ray = this->rays[get_index(vec)];
+            ray.los_shortcut = get_los_shortcut(vec);
+            ray.los_begin = this->los_cells.size();
+            calc_los_ray(vec, [this](const Pos2DVec &cell) {
+                this->los_cells.push_back(cell);
+                return true;
+            });
+            ray.los_end = this->los_cells.size();
+
+            ray.projection_begin = this->projection_steps.size();
+            if ((dy != 0) || (dx != 0)) {
+                calc_projection_ray(vec, RADIUS, [this](const Pos2DVec &cell, int cost) {
+                    this->projection_steps.push_back({ cell, cost });
+                    return true;
+                });
+            }
+
+            ray.projection_end = this->projection_steps.size();
+        }
+    }
+}
+
+const RayTable &RayTable::get_instance()
+{
+    return instance;
+}
+
+bool RayTable::is_in_table(const Pos2DVec &vec)
+{
+    return (std::abs(vec.y) <= RADIUS) && (std::abs(vec.x) <= RADIUS);
+}
+
+size_t RayTable::get_index(const Pos2DVec &vec)
+{
+    return (vec.y + RADIUS) * (RADIUS * 2 + 1) + (vec.x + RADIUS);
+}
@@ -0,0 +1,319 @@
+#pragma once
+
+#include "system/angband.h"
+#include "system/gamevalue.h"
+#include "util/point-2d.h"
+#include <cstdlib>
+#include <optional>
+#include <vector>
+
+/*!
+ * @brief 視線の経路のうち、その1グリッドが視線を通せば他を調べずに視線が通るとみなすグリッドを求める
+ * @param vec 始点から終点への相対座標
+ * @return 始点からの相対座標 (該当するグリッドがなければstd::nullopt)
+ * @details 桂馬飛びの位置関係の時に、始点に隣接する長軸方向のグリッドが該当する
+ */
+inline std::optional<Pos2DVec> get_los_shortcut(const Pos2DVec &vec)
+{
+    const auto ay = std::abs(vec.y);
+    const auto ax = std::abs(vec.x);
+    if ((ax == 1) && (ay == 2)) {
+        return Pos2DVec((vec.y < 0) ? -1 : 1, 0);
+    }
+
+    if ((ay == 1) && (ax == 2)) {
+        return Pos2DVec(0, (vec.x < 0) ? -1 : 1);
+    }
+
+    return std::nullopt;
+}
+
+/*!
+ * @brief 視線の経路を1グリッドずつ辿る (los() のアルゴリズム本体)
+ * @param vec 始点から終点への相対座標
+ * @param is_transparent 始点からの相対座標を受け取り、そのグリッドが視線を通すかを返す関数オブジェクト
+ * @return 経路上の全てのグリッド (始点と終点を除く) が視線を通すか
+ * @details get_los_shortcut() による近道の判定は含まない. 詳細は los() を参照のこと.
+ */
+template <typename F>
+bool calc_los_ray(const Pos2DVec &vec, F is_transparent)
+{
+    const auto dy = vec.y;
+    const auto dx = vec.x;
+    const auto ay = std::abs(dy);
+    const auto ax = std::abs(dx);
+    if ((ax < 2) && (ay < 2)) {
+        return true;
+    }
+
+    POSITION tx, ty;
+    if (!dx) {
+        const auto sy = (dy < 0) ? -1 : 1;
+        for (ty = sy; ty != dy; ty += sy) {
+            if (!is_transparent(Pos2DVec(ty, 0))) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    if (!dy) {
+        const auto sx = (dx < 0) ? -1 : 1;
+        for (tx = sx; tx != dx; tx += sx) {
+            if (!is_transparent(Pos2DVec(0, tx))) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    const auto sx = (dx < 0) ? -1 : 1;
+    const auto sy = (dy < 0) ? -1 : 1;
+    const auto f2 = ax * ay;
+    const auto f1 = f2 << 1;
+    if (ax >= ay) {
+        auto qy = ay * ay;
+        const auto m = qy << 1;
+        tx = sx;
+        if (qy == f2) {
+            ty = sy;
+            qy -= f1;
+        } else {
+            ty = 0;
+        }
+
+        while (dx - tx) {
+            if (!is_transparent(Pos2DVec(ty, tx))) {
+                return false;
+            }
+
+            qy += m;
+            if (qy < f2) {
+                tx += sx;
+                continue;
+            }
+
+            if (qy > f2) {
+                ty += sy;
+                if (!is_transparent(Pos2DVec(ty, tx))) {
+                    return false;
+                }
+                qy -= f1;
+                tx += sx;
+                continue;
+            }
+
+            ty += sy;
+            qy -= f1;
+            tx += sx;
+        }
+
+        return true;
+    }
+
+    auto qx = ax * ax;
+    const auto m = qx << 1;
+    ty = sy;
+    if (qx == f2) {
+        tx = sx;
+        qx -= f1;
+    } else {
+        tx = 0;
+    }
+
+    while (dy - ty) {
+        if (!is_transparent(Pos2DVec(ty, tx))) {
+            return false;
+        }
+
+        qx += m;
+        if (qx < f2) {
+            ty += sy;
+            continue;
+        }
+
+        if (qx > f2) {
+            tx += sx;
+            if (!is_transparent(Pos2DVec(ty, tx))) {
+                return false;
+            }
+            qx -= f1;
+            ty += sy;
+            continue;
+        }
+
+        tx += sx;
+        qx -= f1;
+        ty += sy;
+    }
+
+    return true;
+}
+
+/*!
+ * @brief 射線の経路を1グリッドずつ辿る (ProjectionPath のアルゴリズム本体)
+ * @param vec 始点から終点への相対座標 (0であってはならない)
+ * @param range 射程
+ * @param visit 始点からの相対座標及びそこまでの距離を受け取り、経路を先へ進めるならtrueを返す関数オブジェクト
+ * @details 経路は終点で止まらず、距離が射程に達するまで同じ傾きで延びる.
+ * 距離は斜め移動を1.5グリッドとして数える.
+ */
+template <typename F>
+void calc_projection_ray(const Pos2DVec &vec, int range, F visit)
+{
+    const auto sy = (vec.y > 0) ? 1 : ((vec.y < 0) ? -1 : 0);
+    const auto sx = (vec.x > 0) ? 1 : ((vec.x < 0) ? -1 : 0);
+    const auto ay = std::abs(vec.y);
+    const auto ax = std::abs(vec.x);
+    const auto half = ay * ax;
+    const auto full = half * 2;
+    if (ay == ax) {
+        Pos2DVec pos(sy, sx);
+        for (auto num = 1;; num++) {
+            const auto cost = num * 3 / 2;
+            if (!visit(pos, cost) || (cost >= range)) {
+                return;
+            }
+
+            pos += Pos2DVec(sy, sx);
+        }
+    }
+
+    const auto is_vertical = ay > ax;
+    const auto m = is_vertical ? (ax * ax * 2) : (ay * ay * 2);
+    auto frac = m;
+    auto k = 0;
+    const Pos2DVec minor_step = is_vertical ? Pos2DVec(0, sx) : Pos2DVec(sy, 0);
+    const Pos2DVec major_step = is_vertical ? Pos2DVec(sy, 0) : Pos2DVec(0, sx);
+    auto pos = major_step;
+    if (frac > half) {
+        pos += minor_step;
+        frac -= full;
+        k++;
+    }
+
+    for (auto num = 1;; num++) {
+        const auto cost = num + k / 2;
+        if (!visit(pos, cost) || (cost >= range)) {
+            return;
+        }
+
+        if (m != 0) {
+            frac += m;
+            if (frac > half) {
+                pos += minor_step;
+                frac -= full;
+                k++;
+            }
+        }
+
+        pos += major_step;
+    }
+}
+
+/*!
+ * @brief 視線及び射線の経路を相対座標毎に事前計算した表
+ * @details 始点から RADIUS 以内の相対座標について、calc_los_ray() 及び calc_projection_ray() が
+ * 辿るグリッドの相対座標の列を起動時に求めておき、判定の度に傾きを計算し直さずに済むようにする.
+ * 表の範囲外の相対座標や射程については、その都度 calc_los_ray() 及び calc_projection_ray() で計算する.
+ */
+class RayTable {
+public:
+    RayTable(RayTable &&) = delete;
+    RayTable(const RayTable &) = delete;
+    RayTable &operator=(const RayTable &) = delete;
+    RayTable &operator=(RayTable &&) = delete;
+
+    static const RayTable &get_instance();
+
+    template <typename F>
+    bool trace_los(const Pos2DVec &vec, F is_transparent) const;
+    template <typename F>
+    void trace_projection(const Pos2DVec &vec, int range, F visit) const;
+
+private:
+    RayTable();
+
+    static constexpr auto RADIUS = MAX_PLAYER_SIGHT; //!< 表に収める相対座標の範囲及び射程
+
+    /*!
+     * @brief 射線の経路上の1グリッド
+     */
+    struct ProjectionStep {
+        Pos2DVec vec; //!< 始点からの相対座標
+        int cost; //!< このグリッドまでの距離 (これが射程以上なら経路はここで終わる)
+    };
+
+    /*!
+     * @brief 表の1要素 (始点からの相対座標1つ分)
+     */
+    struct Ray {
+        std::optional<Pos2DVec> los_shortcut;
+        size_t los_begin = 0;
+        size_t los_end = 0;
+        size_t projection_begin = 0;
+        size_t projection_end = 0;
+    };
+
+    static RayTable instance;
+
+    std::vector<Ray> rays;
+    std::vector<Pos2DVec> los_cells;
+    std::vector<ProjectionStep> projection_steps;
+
+    static bool is_in_table(const Pos2DVec &vec);
+    static size_t get_index(const Pos2DVec &vec);
+};
+
+/*!
+ * @brief 視線が通るかを判定する
+ * @param vec 始点から終点への相対座標
+ * @param is_transparent 始点からの相対座標を受け取り、そのグリッドが視線を通すかを返す関数オブジェクト
+ * @return 視線が通るか
+ */
+template <typename F>
+bool RayTable::trace_los(const Pos2DVec &vec, F is_transparent) const
+{
+    if (!is_in_table(vec)) {
+        const auto shortcut = get_los_shortcut(vec);
+        return (shortcut && is_transparent(*shortcut)) || calc_los_ray(vec, is_transparent);
+    }
+
+    const auto &ray = this->rays[get_index(vec)];
+    if (ray.los_shortcut && is_transparent(*ray.los_shortcut)) {
+        return true;
+    }
+
+    for (auto i = ray.los_begin; i < ray.los_end; i++) {
+        if (!is_transparent(this->los_cells[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*!
+ * @brief 射線の経路を辿る
+ * @param vec 始点から終点への相対座標 (0であってはならない)
+ * @param range 射程
+ * @param visit 始点からの相対座標を受け取り、経路を先へ進めるならtrueを返す関数オブジェクト
+ */
+template <typename F>
+void RayTable::trace_projection(const Pos2DVec &vec, int range, F visit) const
+{
+    if (!is_in_table(vec) || (range > RADIUS)) {
+        calc_projection_ray(vec, range, [&visit](const Pos2DVec &cell, int) { return visit(cell); });
+        return;
+    }
+
+    const auto &ray = this->rays[get_index(vec)];
+    for (auto i = ray.projection_begin; i < ray.projection_end; i++) {
+        const auto &step = this->projection_steps[i];
+        if (!visit(step.vec) || (step.cost >= range)) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,279 @@
+#include "floor/saved-floor-cache.h"
+#include "io/uid-checker.h"
+#include "util/angband-files.h"
+#include "view/display-messages.h"
+#include <algorithm>
+
+namespace {
+/*!
+ * @brief メモリ上に保持する、書き込み済みの保存フロアの最大数
+ */
+constexpr size_t SAVED_FLOOR_CACHE_CAPACITY = 8;
+
+/*!
+ * @brief シリアライズ済みデータをテンポラリファイルへ書き込んで閉じる
+ * @param fp 書き込み先のテンポラリファイル
+ * @param bytes シリアライズ済みデータ
+ * @return 書き込みに成功したらtrue
+ */
+bool write_saved_floor(FILE *fp, const std::vector<byte> &bytes)
+{
+    auto is_written = fwrite(bytes.data(), 1, bytes.size(), fp) == bytes.size();
+    is_written &= angband_fclose(fp) == 0;
+    return is_written;
+}
+
+/*!
+ * @brief 書き込みに失敗した保存フロアがあることをプレイヤーに知らせる
+ * @param num_lost_floors 書き込みに失敗した保存フロアの数
+ */
+void report_lost_floors(int num_lost_floors)
+{
+    if (num_lost_floors == 0) {
+        return;
+    }
+
+    msg_print(_("テンポラリ・ファイルへのフロアの保存に失敗しました。", "Failed to write a saved floor to its temporary file."));
+}
+}
+
+SavedFloorCache SavedFloorCache::instance{};
+
+SavedFloorCache::~SavedFloorCache()
+{
+    {
+        std::unique_lock lock(this->mutex);
+        this->is_stopping = true;
+    }
+
+    this->condition.notify_all();
+    if (this->writer.joinable()) {
+        this->writer.join();
+    }
+}
+
+SavedFloorCache &SavedFloorCache::get_instance()
+{
+    return instance;
+}
+
+/*!
+ * @brief 保存フロアのシリアライズ済みデータをキャッシュに格納し、テンポラリファイルへの書き込みを予約する
+ * @param savefile_id 保存フロアのファイルID
+ * @param bytes シリアライズ済みデータ
+ * @param fp 書き込み先として開いたテンポラリファイル (書き込み後に閉じる)
+ * @param path テンポラリファイルのパス
+ * @return 格納に成功したらtrue
+ * @details 以前にバックグラウンドでの書き込みに失敗していれば、その場で書き込み、書き込みに失敗したらキャッシュに格納しない
+ */
+bool SavedFloorCache::store(int savefile_id, std::vector<byte> &&bytes, FILE *fp, const std::filesystem::path &path)
+{
+    std::unique_lock lock(this->mutex);
+    const auto num_lost_floors = this->retry_failed_writes();
+    this->cancel_write(lock, savefile_id);
+    auto shared_bytes = std::make_shared<const std::vector<byte>>(std::move(bytes));
+    if (this->is_synchronous) {
+        const auto is_written = write_saved_floor(fp, *shared_bytes);
+        if (is_written) {
+            this->entries[savefile_id] = { std::move(shared_bytes), path, true };
+            this->touch(savefile_id);
+        } else {
+            this->entries.erase(savefile_id);
+            this->recently_used_ids.remove(savefile_id);
+        }
+
+        lock.unlock();
+        report_lost_floors(num_lost_floors);
+        return is_written;
+    }
+
+    this->entries[savefile_id] = { shared_bytes, path, false };
+    this->touch(savefile_id);
+    this->write_requests.push_back({ savefile_id, std::move(shared_bytes), fp });
+    if (!this->writer.joinable()) {
+        this->writer = std::thread([this] { this->write_in_background(); });
+    }
+
+    lock.unlock();
+    this->condition.notify_all();
+    report_lost_floors(num_lost_floors);
+    return true;
+}
+
+/*!
+ * @brief 保存フロアのシリアライズ済みデータをキャッシュから探す
+ * @param savefile_id 保存フロアのファイルID
+ * @return シリアライズ済みデータの複製 (キャッシュにない場合はstd::nullopt)
+ */
+std::optional<std::vector<byte>> SavedFloorCache::find(int savefile_id)
+{
+    std::unique_lock lock(this->mutex);
+    const auto num_lost_floors = this->retry_failed_writes();
+    const auto it = this->entries.find(savefile_id);
+    if (it == this->entries.end()) {
+        this->statistics.misses++;
+        lock.unlock();
+        report_lost_floors(num_lost_floors);
+        return std::nullopt;
+    }
+
+    this->statistics.hits++;
+    this->statistics.saved_bytes += it->second.bytes->size();
+    auto bytes = *it->second.bytes;
+    this->touch(savefile_id);
+    lock.unlock();
+    report_lost_floors(num_lost_floors);
+    return bytes;
+}
+
+/*!
+ * @brief 保存フロアをキャッシュから取り除き、未完了の書き込み要求を取り消す
+ * @param savefile_id 保存フロアのファイルID
+ * @details 書き込み中の場合は完了を待つため、呼び出し後はテンポラリファイルを安全に削除・再作成できる
+ */
+void SavedFloorCache::erase(int savefile_id)
+{
+    std::unique_lock lock(this->mutex);
+    this->cancel_write(lock, savefile_id);
+    this->entries.erase(savefile_id);
+    this->recently_used_ids.remove(savefile_id);
+}
+
+/*!
+ * @brief 全ての保存フロアをキャッシュから取り除き、未完了の書き込み要求を取り消す
+ */
+void SavedFloorCache::clear()
+{
+    std::unique_lock lock(this->mutex);
+    for (auto &request : this->write_requests) {
+        angband_fclose(request.fp);
+    }
+
+    this->write_requests.clear();
+    this->condition.wait(lock, [this] { return !this->writing_id; });
+    this->failed_ids.clear();
+    this->entries.clear();
+    this->recently_used_ids.clear();
+}
+
+SavedFloorCacheStatistics SavedFloorCache::get_statistics() const
+{
+    std::unique_lock lock(this->mutex);
+    return this->statistics;
+}
+
+void SavedFloorCache::touch(int savefile_id)
+{
+    this->recently_used_ids.remove(savefile_id);
+    this->recently_used_ids.push_front(savefile_id);
+    this->evict();
+}
+
+/*!
+ * @brief 最近使われていない追い出してよい保存フロアを、保持数が上限以下になるまで取り除く
+ */
+void SavedFloorCache::evict()
+{
+    auto it = this->recently_used_ids.end();
+    while ((this->entries.size() > SAVED_FLOOR_CACHE_CAPACITY) && (it != this->recently_used_ids.begin())) {
+        --it;
+        if (!this->entries.at(*it).is_evictable) {
+            continue;
+        }
+
+        this->entries.erase(*it);
+        it = this->recently_used_ids.erase(it);
+    }
+}
+
+/*!
+ * @brief 保存フロアの未完了の書き込み要求を取り消し、書き込み中であれば完了を待つ
+ * @param lock mutex を保持しているロック
+ * @param savefile_id 保存フロアのファイルID
+ */
+void SavedFloorCache::cancel_write(std::unique_lock<std::mutex> &lock, int savefile_id)
+{
+    for (auto &request : this->write_requests) {
+        if (request.savefile_id == savefile_id) {
+            angband_fclose(request.fp);
+        }
+    }
+
+    std::erase_if(this->write_requests, [savefile_id](const auto &request) { return request.savefile_id == savefile_id; });
+    this->condition.wait(lock, [this, savefile_id] { return this->writing_id != savefile_id; });
+    std::erase(this->failed_ids, savefile_id);
+}
+
+/*!
+ * @brief バックグラウンドでの書き込みに失敗した保存フロアを、メインスレッドで書き込み直す
+ * @return 書き込み直しにも失敗した保存フロアの数
+ * @details mutex を保持した状態で呼ぶ. 書き込み直しにも失敗した保存フロアは、不完全なテンポラリファイルを削除した上で
+ * メモリ上にだけ残し、他の保存フロアと同様に追い出してよいものとする. 追い出された後は読み込みに失敗するため、新しいフロアが生成される.
+ */
+int SavedFloorCache::retry_failed_writes()
+{
+    auto num_lost_floors = 0;
+    for (const auto savefile_id : this->failed_ids) {
+        const auto it = this->entries.find(savefile_id);
+        if ((it == this->entries.end()) || it->second.is_evictable) {
+            continue;
+        }
+
+        auto &entry = it->second;
+        safe_setuid_grab();
+        auto *fp = angband_fopen(entry.path, FileOpenMode::WRITE, true);
+        safe_setuid_drop();
+        entry.is_evictable = true;
+        if ((fp != nullptr) && write_saved_floor(fp, *entry.bytes)) {
+            continue;
+        }
+
+        safe_setuid_grab();
+        fd_kill(entry.path);
+        safe_setuid_drop();
+        num_lost_floors++;
+    }
+
+    this->failed_ids.clear();
+    this->evict();
+    return num_lost_floors;
+}
+
+/*!
+ * @brief テンポラリファイルへの書き込み要求を順に処理する (バックグラウンドのスレッドで実行する)
+ */
+void SavedFloorCache::write_in_background()
+{
+    std::unique_lock lock(this->mutex);
+    while (true) {
+        this->condition.wait(lock, [this] { return this->is_stopping || !this->write_requests.empty(); });
+        if (this->write_requests.empty()) {
+            return;
+        }
+
+        const auto request = std::move(this->write_requests.front());
+        this->write_requests.pop_front();
+        this->writing_id = request.savefile_id;
+        lock.unlock();
+
+        const auto is_written = write_saved_floor(request.fp, *request.bytes);
+
+        lock.lock();
+        this->writing_id.reset();
+        if (!is_written) {
+            this->is_synchronous = true;
+        }
+
+        const auto it = this->entries.find(request.savefile_id);
+        if ((it != this->entries.end()) && (it->second.bytes == request.bytes)) {
+            if (is_written) {
+                it->second.is_evictable = true;
+                this->evict();
+            } else {
+                this->failed_ids.push_back(request.savefile_id);
+            }
+        }
+
+        this->condition.notify_all();
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "system/angband.h"
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+/*!
+ * @brief 保存フロアキャッシュの統計情報
+ */
+struct SavedFloorCacheStatistics {
+    int hits = 0; //!< メモリ上から読み込めた回数
+    int misses = 0; //!< テンポラリファイルから読み込む必要があった回数
+    size_t saved_bytes = 0; //!< メモリ上から読み込んだためにファイルから読まずに済んだバイト数
+};
+
+/*!
+ * @brief 保存フロアのシリアライズ済みデータをメモリ上に保持するLRUキャッシュ
+ * @details 保存フロアはシリアライズ後にまずこのキャッシュへ格納し、テンポラリファイルへの書き込みは
+ * バックグラウンドのスレッドで行う. 最近訪れたフロアはファイルを読まずにメモリ上から復元できる.
+ * ファイルへの書き込みが完了していないデータはキャッシュから追い出さない.
+ * バックグラウンドでの書き込みに失敗した場合は、次にキャッシュを使う時にメインスレッドで書き込み直して失敗を報告し、
+ * 以後の書き込みは全て同期的に行う.
+ */
+class SavedFloorCache {
+public:
+    SavedFloorCache(const SavedFloorCache &) = delete;
+    SavedFloorCache(SavedFloorCache &&) = delete;
+    SavedFloorCache &operator=(const SavedFloorCache &) = delete;
+    SavedFloorCache &operator=(SavedFloorCache &&) = delete;
+    ~SavedFloorCache();
+    static SavedFloorCache &get_instance();
+
+    bool store(int savefile_id, std::vector<byte> &&bytes, FILE *fp, const std::filesystem::path &path);
+    std::optional<std::vector<byte>> find(int savefile_id);
+    void erase(int savefile_id);
+    void clear();
+    SavedFloorCacheStatistics get_statistics() const;
+
+private:
+    SavedFloorCache() = default;
+
+    /*!
+     * @brief キャッシュの要素
+     */
+    struct Entry {
+        std::shared_ptr<const std::vector<byte>> bytes;
+        std::filesystem::path path; //!< テンポラリファイルのパス
+        bool is_evictable = false; //!< キャッシュから追い出してよいか (書き込みが完了したか、書き込みを諦めたか)
+    };
+
+    /*!
+     * @brief バックグラウンドで行うテンポラリファイルへの書き込み要求
+     */
+    struct WriteRequest {
+        int savefile_id;
+        std::shared_ptr<const std::vector<byte>> bytes;
+        FILE *fp;
+    };
+
+    static SavedFloorCache instance;
+
+    mutable std::mutex mutex;
+    std::condition_variable condition;
+    std::map<int, Entry> entries;
+    std::list<int> recently_used_ids; //!< 先頭ほど最近使われた保存フロア
+    std::deque<WriteRequest> write_requests;
+    std::optional<int> writing_id; //!< 書き込み中の保存フロア
+    std::vector<int> failed_ids; //!< バックグラウンドでの書き込みに失敗した保存フロア
+    bool is_synchronous = false; //!< 書き込みをメインスレッドで同期的に行うか
+    std::thread writer;
+    bool is_stopping = false;
+    SavedFloorCacheStatistics statistics;
+
+    void touch(int savefile_id);
+    void evict();
+    void cancel_write(std::unique_lock<std::mutex> &lock, int savefile_id);
+    int retry_failed_writes();
+    void write_in_background();
+};
@@ -9,6 +9,8 @@ bool empty_levels; /* Allow empty 'on_defeat_arena_monster' levels */
 bool bound_walls_perm; /* Boundary walls become 'permanent wall' */
 bool last_words; /* Leave last words when your character dies */
 bool auto_dump; /* Dump a character record automatically */
+bool skip_idle_turns; /* Fast-forward game turns in which nothing happens */
+bool prepare_next_floor; /* Generate the floor below while waiting on down stairs */
 bool auto_debug_save; /* Dump a debug savedata every key input */
 bool send_score; /* Send score dump to the world score server */
 bool allow_debug_opts; /* Allow use of debug/cheat options */
@@ -11,5 +11,7 @@ extern bool empty_levels; /* Allow empty 'on_defeat_arena_monster' levels */
 extern bool bound_walls_perm; /* Boundary walls become 'permanent wall' */
 extern bool last_words; /* Leave last words when your character dies */
 extern bool auto_dump; /* Dump a character record automatically */
+extern bool skip_idle_turns; /* Fast-forward game turns in which nothing happens */
+extern bool prepare_next_floor; /* Generate the floor below while waiting on down stairs */
 extern bool send_score; /* Send score dump to the world score server */
 extern bool allow_debug_opts; /* Allow use of debug/cheat options */
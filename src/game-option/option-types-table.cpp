@@ -156,6 +156,11 @@ const std::vector<option_type> option_info = {
 
     { &auto_dump, false, OPT_PAGE_GAMEPLAY, 4, 5, "auto_dump", _("自動的にキャラクターの記録をファイルに書き出す", "Dump a character record automatically") },
 
+    { &skip_idle_turns, true, OPT_PAGE_GAMEPLAY, 2, 19, "skip_idle_turns", _("誰も行動しないゲームターンを一括で進める", "Fast-forward game turns in which no one acts") },
+
+    { &prepare_next_floor, false, OPT_PAGE_GAMEPLAY, 2, 20, "prepare_next_floor",
+        _("下り階段の上で待つ間に降りた先のフロアを生成しておく", "Generate the floor below while waiting on down stairs") },
+
 #ifdef WORLD_SCORE
     { &send_score, true, OPT_PAGE_GAMEPLAY, 4, 6, "send_score", _("スコアサーバにスコアを送る", "Send score dump to the world score server") },
 #else
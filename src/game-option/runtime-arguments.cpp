@@ -9,3 +9,4 @@ bool arg_monochrome; /* Command arg -- Request monochrome mode */
 bool arg_force_original; /* Command arg -- Request original keyset */
 bool arg_force_roguelike; /* Command arg -- Request roguelike keyset */
 bool arg_bigtile = false; /* Command arg -- Request big tile mode */
+std::optional<uint32_t> arg_random_seed; /* Command arg -- Fix the random seed of a new game */
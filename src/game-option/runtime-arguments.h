@@ -1,6 +1,8 @@
 #pragma once
 
 #include "system/angband.h"
+#include <cstdint>
+#include <optional>
 
 extern bool arg_music;
 extern int arg_music_volume_table_index;
@@ -11,3 +13,4 @@ extern bool arg_monochrome;
 extern bool arg_force_original;
 extern bool arg_force_roguelike;
 extern bool arg_bigtile;
+extern std::optional<uint32_t> arg_random_seed;
@@ -2,10 +2,12 @@
 #include "dungeon/dungeon-flag-types.h"
 #include "floor/cave.h"
 #include "floor/geometry.h"
+#include "floor/line-of-sight.h"
 #include "game-option/map-screen-options.h"
 #include "grid/grid.h"
 #include "grid/lighting-colors-table.h"
 #include "mind/mind-ninja.h"
+#include "monster-floor/monster-lite.h"
 #include "monster/monster-update.h"
 #include "player/special-defense-types.h"
 #include "room/door-definition.h"
@@ -171,6 +173,7 @@ void cave_set_feat(PlayerType *player_ptr, POSITION y, POSITION x, FEAT_IDX feat
     auto *g_ptr = &floor_ptr->grid_array[y][x];
     const auto &terrain = TerrainList::get_instance()[feat];
     const auto &dungeon = floor_ptr->get_dungeon_definition();
+    SightCache::invalidate_all();
     if (!w_ptr->character_dungeon) {
         g_ptr->mimic = 0;
         g_ptr->feat = feat;
@@ -195,6 +198,8 @@ void cave_set_feat(PlayerType *player_ptr, POSITION y, POSITION x, FEAT_IDX feat
     g_ptr->mimic = 0;
     g_ptr->feat = feat;
     g_ptr->info &= ~(CAVE_OBJECT);
+    invalidate_flow({ y, x });
+    invalidate_mon_lite_cache();
     if (old_mirror && dungeon.flags.has(DungeonFeatureType::DARKNESS)) {
         g_ptr->info &= ~(CAVE_GLOW);
         if (!view_torch_grids) {
@@ -63,6 +63,7 @@
 #include "view/display-symbol.h"
 #include "window/main-window-util.h"
 #include "world/world.h"
+#include <array>
 #include <queue>
 
 bool GridTemplate::matches(const Grid &grid) const
@@ -630,6 +631,51 @@ void lite_spot(PlayerType *player_ptr, POSITION y, POSITION x)
 static POSITION flow_x = 0;
 static POSITION flow_y = 0;
 
+// 敵のプレイヤーに対する移動道のりの最大値(この値以上は処理を打ち切る).
+constexpr auto MONSTER_FLOW_DEPTH = 32;
+
+/*!
+ * @brief 流れ情報が現在の地形に対して有効か否か / Is the flow information valid for the current terrain?
+ */
+static bool is_flow_valid = false;
+
+static FlowUpdateStatistics flow_statistics;
+
+/*!
+ * @brief 流れ情報を全て無効化する / Invalidate the whole flow information
+ * @details フロアの生成・読み込みや広範囲の地形変化の後に呼ばれる.
+ */
+void invalidate_flow()
+{
+    is_flow_valid = false;
+}
+
+/*!
+ * @brief 地形が変化したグリッドに応じて流れ情報を無効化する / Invalidate the flow information affected by the terrain change
+ * @param pos 地形が変化したグリッドの座標
+ * @details 流れの起点から MONSTER_FLOW_DEPTH より遠いグリッドは幅優先探索で到達し得ないため、その地形変化は流れ情報に影響しない.
+ */
+void invalidate_flow(const Pos2D &pos)
+{
+    if (!is_flow_valid) {
+        return;
+    }
+
+    const auto distance_to_origin = std::max(std::abs(pos.y - flow_y), std::abs(pos.x - flow_x));
+    if (distance_to_origin <= MONSTER_FLOW_DEPTH) {
+        is_flow_valid = false;
+    }
+}
+
+/*!
+ * @brief 直前の流れ情報更新の統計を返す / Get the statistics of the last flow update
+ * @return 統計情報
+ */
+const FlowUpdateStatistics &get_flow_update_statistics()
+{
+    return flow_statistics;
+}
+
 /*
  * Hack -- fill in the "cost" field of every grid that the player
  * can "reach" with the number of steps needed to reach that grid.
@@ -642,6 +688,11 @@ static POSITION flow_y = 0;
  *
  * We do not need a priority queue because the cost from grid
  * to grid is always "one" and we process them in order.
+ *
+ * Instead of erasing the flow information of the whole floor, only the grids
+ * stamped by the last update are erased if they are not reached again.
+ * The update itself is skipped when neither the player nor the terrain
+ * around the player has changed since the last update.
  */
 void update_flow(PlayerType *player_ptr)
 {
@@ -655,48 +706,64 @@ void update_flow(PlayerType *player_ptr)
         }
     }
 
-    /* Erase all of the current flow information */
-    for (auto y = 0; y < floor.height; y++) {
-        for (auto x = 0; x < floor.width; x++) {
-            auto &grid = floor.grid_array[y][x];
-            grid.reset_costs();
-            grid.reset_dists();
-        }
+    /* Nothing has changed since the last update - do not update. (Speedup) */
+    if (is_flow_valid && player_ptr->is_located_at({ flow_y, flow_x })) {
+        flow_statistics = { 0, 0, true };
+        return;
     }
 
+    /* Start a new generation */
+    auto &pathing_layer = floor.pathing_layer;
+    pathing_layer.begin_flow_update();
+
     /* Save player position */
     flow_y = player_ptr->y;
     flow_x = player_ptr->x;
 
+    // グリッド配列と経路探索用の配列は同じ大きさ・同じ並びなので、隣接マスは共通の位置差分で参照できる.
+    const auto grids = floor.grid_array.elements();
+    const auto stride = floor.grid_array.stride();
+    std::array<int, 8> offsets{};
+    for (auto d = 0; d < 8; d++) {
+        offsets[d] = ddy_ddd[d] * stride + ddx_ddd[d];
+    }
+
+    const auto index_player = pathing_layer.get_index(player_ptr->get_position());
     for (auto i = 0; i < FLOW_MAX; i++) {
+        const auto costs = pathing_layer.costs[i].elements();
+        const auto dists = pathing_layer.dists[i].elements();
+
         // 幅優先探索用のキュー。
-        std::queue<Pos2D> que;
-        que.emplace(player_ptr->y, player_ptr->x);
+        std::queue<int> que;
+        que.push(index_player);
 
         /* Now process the queue */
         while (!que.empty()) {
-            const Pos2D pos = std::move(que.front());
+            const auto index = que.front();
             que.pop();
-            const auto &grid = floor.get_grid(pos);
+            const auto is_stamped = pathing_layer.is_stamped(index);
+            const byte cost = is_stamped ? costs[index] : 0;
+            const byte dist = is_stamped ? dists[index] : 0;
 
             /* Add the "children" */
             for (auto d = 0; d < 8; d++) {
-                byte m = grid.costs[i] + 1;
-                byte n = grid.dists[i] + 1;
-                const Pos2D pos_neighbor(pos.y + ddy_ddd[d], pos.x + ddx_ddd[d]);
+                byte m = cost + 1;
+                byte n = dist + 1;
+                const auto index_neighbor = index + offsets[d];
 
                 /* Ignore player's grid */
-                if (player_ptr->is_located_at(pos_neighbor)) {
+                if (index_neighbor == index_player) {
                     continue;
                 }
 
-                auto &grid_neighbor = floor.get_grid(pos_neighbor);
+                const auto &grid_neighbor = grids[index_neighbor];
                 if (is_closed_door(player_ptr, grid_neighbor.feat)) {
                     m += 3;
                 }
 
                 /* Ignore "pre-stamped" entries */
-                if ((grid_neighbor.dists[i] != 0) && (grid_neighbor.dists[i] <= n) && (grid_neighbor.costs[i] <= m)) {
+                const auto is_neighbor_stamped = pathing_layer.is_stamped(index_neighbor);
+                if (is_neighbor_stamped && (dists[index_neighbor] != 0) && (dists[index_neighbor] <= n) && (costs[index_neighbor] <= m)) {
                     continue;
                 }
 
@@ -715,24 +782,32 @@ void update_flow(PlayerType *player_ptr)
                     continue;
                 }
 
+                /* Stamp the grid with the current generation */
+                if (!is_neighbor_stamped) {
+                    pathing_layer.stamp(index_neighbor);
+                }
+
                 /* Save the flow cost */
-                if (grid_neighbor.costs[i] == 0 || (grid_neighbor.costs[i] > m)) {
-                    grid_neighbor.costs[i] = m;
+                if (costs[index_neighbor] == 0 || (costs[index_neighbor] > m)) {
+                    costs[index_neighbor] = m;
                 }
-                if (grid_neighbor.dists[i] == 0 || (grid_neighbor.dists[i] > n)) {
-                    grid_neighbor.dists[i] = n;
+                if (dists[index_neighbor] == 0 || (dists[index_neighbor] > n)) {
+                    dists[index_neighbor] = n;
                 }
 
-                // 敵のプレイヤーに対する移動道のりの最大値(この値以上は処理を打ち切る).
-                constexpr auto monster_flow_depth = 32;
-                if (n == monster_flow_depth) {
+                if (n == MONSTER_FLOW_DEPTH) {
                     continue;
                 }
 
-                que.emplace(pos_neighbor);
+                que.push(index_neighbor);
             }
         }
     }
+
+    /* Erase the flow information of the grids which are no longer reachable */
+    const auto cleared_grids = pathing_layer.end_flow_update();
+    flow_statistics = { cleared_grids, pathing_layer.get_stamped_count(), false };
+    is_flow_valid = true;
 }
 
 /*
@@ -1068,6 +1143,7 @@ void place_bold(PlayerType *player_ptr, POSITION y, POSITION x, grid_bold_type g
 void set_cave_feat(FloorType *floor_ptr, POSITION y, POSITION x, FEAT_IDX feature_idx)
 {
     floor_ptr->grid_array[y][x].feat = feature_idx;
+    invalidate_flow({ y, x });
 }
 
 /*!
@@ -47,6 +47,15 @@ public:
     bool matches(const Grid &grid) const;
 };
 
+/*!
+ * @brief 流れ情報の更新統計 / Statistics of the last flow update
+ */
+struct FlowUpdateStatistics {
+    int cleared_grids; //!< 到達不能になり消去したグリッド数
+    int stamped_grids; //!< 流れ情報を書き込んだグリッド数
+    bool skipped; //!< 流れ情報が有効なままだったため再計算を省略したか否か
+};
+
 enum grid_bold_type {
     GB_FLOOR,
     GB_EXTRA,
@@ -76,6 +85,9 @@ void print_rel(PlayerType *player_ptr, const DisplaySymbol &symbol, POSITION y,
 void print_bolt_pict(PlayerType *player_ptr, POSITION y, POSITION x, POSITION ny, POSITION nx, AttributeType typ);
 void note_spot(PlayerType *player_ptr, POSITION y, POSITION x);
 void lite_spot(PlayerType *player_ptr, POSITION y, POSITION x);
+void invalidate_flow();
+void invalidate_flow(const Pos2D &pos);
+const FlowUpdateStatistics &get_flow_update_statistics();
 void update_flow(PlayerType *player_ptr);
 FEAT_IDX feat_state(const FloorType *floor_ptr, FEAT_IDX feat, TerrainCharacteristics action);
 void cave_alter_feat(PlayerType *player_ptr, POSITION y, POSITION x, TerrainCharacteristics action);
@@ -229,6 +229,7 @@ void place_trap(FloorType *floor_ptr, POSITION y, POSITION x)
     /* Place an invisible trap */
     g_ptr->mimic = g_ptr->feat;
     g_ptr->feat = choose_random_trap(floor_ptr);
+    invalidate_flow({ y, x });
 }
 
 /*!
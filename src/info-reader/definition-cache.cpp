@@ -0,0 +1,491 @@
+/*!
+ * @brief 解析済みのゲームデータのキャッシュファイルの読み書き
+ * @details
+ * キャッシュファイルは以下の形式で、整数はすべてリトルエンディアンで格納する.
+ * - 識別子 (8バイト)
+ * - キー (定義ファイルの内容、キャッシュ形式のバージョン、ゲームのバージョン及びデータ構造の大きさのハッシュ値)
+ * - 解析済みのJSONオブジェクトのハッシュ値
+ * - ゲームデータ本体
+ * ゲームデータの各フィールドの読み書きは同じ visit_*() 関数で行い、読み書きの順序が食い違わないようにする.
+ * 定義ファイルから読み込むフィールドを追加した場合は visit_*() にも追加すること.
+ */
+
+#include "info-reader/definition-cache.h"
+#include "io/files-util.h"
+#include "io/uid-checker.h"
+#include "system/angband-version.h"
+#include "system/artifact-type-definition.h"
+#include "system/baseitem-info.h"
+#include "system/monster-race-info.h"
+#include "util/angband-files.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+namespace {
+/*!
+ * @brief キャッシュファイルの先頭に置く識別子
+ */
+constexpr std::string_view CACHE_SIGNATURE("HBDCACHE", 8);
+
+/*!
+ * @brief キャッシュファイルの形式のバージョン
+ * @details visit_*() で読み書きするフィールドを変更した時は値を増やすこと
+ */
+constexpr uint32_t CACHE_FORMAT_VERSION = 1;
+
+constexpr auto CACHE_HEADER_SIZE = CACHE_SIGNATURE.size() + util::SHA256::DIGEST_SIZE * 2;
+
+/*!
+ * @brief ゲームデータをバイト列に書き込むクラス
+ */
+class CacheWriter {
+public:
+    std::vector<uint8_t> bytes;
+
+    template <typename T>
+    void visit(const T &value)
+        requires(std::is_integral_v<T> || std::is_enum_v<T>)
+    {
+        if constexpr (std::is_enum_v<T>) {
+            this->visit(static_cast<std::underlying_type_t<T>>(value));
+        } else if constexpr (std::is_same_v<T, bool>) {
+            this->bytes.push_back(value ? 1 : 0);
+        } else {
+            const auto unsigned_value = static_cast<std::make_unsigned_t<T>>(value);
+            for (auto i = 0U; i < sizeof(T); i++) {
+                this->bytes.push_back(static_cast<uint8_t>(unsigned_value >> (i * 8)));
+            }
+        }
+    }
+
+    void visit(const std::string &str)
+    {
+        this->visit(static_cast<uint32_t>(str.size()));
+        this->bytes.insert(this->bytes.end(), str.begin(), str.end());
+    }
+
+    template <typename FlagType, FlagType MAX>
+    void visit(const FlagGroup<FlagType, MAX> &flags)
+    {
+        wr_FlagGroup(flags, [this](uint8_t value) { this->bytes.push_back(value); });
+    }
+
+    void visit(const DisplaySymbol &symbol)
+    {
+        this->visit(symbol.color);
+        this->visit(symbol.character);
+    }
+
+    void visit(const BaseitemKey &bi_key)
+    {
+        const auto sval = bi_key.sval();
+        this->visit(bi_key.tval());
+        this->visit(sval.has_value());
+        this->visit(sval.value_or(0));
+    }
+
+    template <typename... Types>
+    void visit(const std::vector<std::tuple<Types...>> &tuples)
+    {
+        this->visit(static_cast<uint32_t>(tuples.size()));
+        for (const auto &tuple : tuples) {
+            std::apply([this](const auto &...values) { (this->visit(values), ...); }, tuple);
+        }
+    }
+};
+
+/*!
+ * @brief バイト列からゲームデータを読み込むクラス
+ * @details バイト列が途中で尽きた場合は以降の値を0として扱い、is_completed() が false を返すようになる
+ */
+class CacheReader {
+public:
+    CacheReader(const std::vector<uint8_t> &bytes)
+        : bytes(bytes)
+    {
+    }
+
+    bool is_completed() const
+    {
+        return !this->is_broken && (this->position == this->bytes.size());
+    }
+
+    uint32_t read_size()
+    {
+        uint32_t size;
+        this->visit(size);
+        if (size > this->bytes.size() - this->position) {
+            this->is_broken = true;
+            return 0;
+        }
+
+        return size;
+    }
+
+    template <typename T>
+    void visit(T &value)
+        requires(std::is_integral_v<T> || std::is_enum_v<T>)
+    {
+        if constexpr (std::is_enum_v<T>) {
+            std::underlying_type_t<T> underlying_value;
+            this->visit(underlying_value);
+            value = static_cast<T>(underlying_value);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            value = this->read_byte() != 0;
+        } else {
+            std::make_unsigned_t<T> unsigned_value = 0;
+            for (auto i = 0U; i < sizeof(T); i++) {
+                unsigned_value |= static_cast<std::make_unsigned_t<T>>(static_cast<std::make_unsigned_t<T>>(this->read_byte()) << (i * 8));
+            }
+
+            value = static_cast<T>(unsigned_value);
+        }
+    }
+
+    void visit(std::string &str)
+    {
+        const auto size = this->read_size();
+        const auto begin = this->bytes.begin() + this->position;
+        str.assign(begin, begin + size);
+        this->position += size;
+    }
+
+    template <typename FlagType, FlagType MAX>
+    void visit(FlagGroup<FlagType, MAX> &flags)
+    {
+        rd_FlagGroup(flags, [this] { return this->read_byte(); });
+    }
+
+    void visit(DisplaySymbol &symbol)
+    {
+        this->visit(symbol.color);
+        this->visit(symbol.character);
+    }
+
+    void visit(BaseitemKey &bi_key)
+    {
+        ItemKindType tval;
+        bool has_sval;
+        int sval;
+        this->visit(tval);
+        this->visit(has_sval);
+        this->visit(sval);
+        bi_key = has_sval ? BaseitemKey(tval, sval) : BaseitemKey(tval);
+    }
+
+    template <typename... Types>
+    void visit(std::vector<std::tuple<Types...>> &tuples)
+    {
+        tuples.resize(this->read_size());
+        for (auto &tuple : tuples) {
+            std::apply([this](auto &...values) { (this->visit(values), ...); }, tuple);
+        }
+    }
+
+private:
+    const std::vector<uint8_t> &bytes;
+    size_t position = 0;
+    bool is_broken = false;
+
+    uint8_t read_byte()
+    {
+        if (this->position >= this->bytes.size()) {
+            this->is_broken = true;
+            return 0;
+        }
+
+        return this->bytes[this->position++];
+    }
+};
+
+template <typename Stream, typename MonraceInfo>
+void visit_monrace(Stream &stream, MonraceInfo &monrace)
+{
+    stream.visit(monrace.idx);
+    stream.visit(monrace.name);
+#ifdef JP
+    stream.visit(monrace.E_name);
+#endif
+    stream.visit(monrace.text);
+    stream.visit(monrace.hdice);
+    stream.visit(monrace.hside);
+    stream.visit(monrace.ac);
+    stream.visit(monrace.sleep);
+    stream.visit(monrace.aaf);
+    stream.visit(monrace.speed);
+    stream.visit(monrace.mexp);
+    stream.visit(monrace.freq_spell);
+    stream.visit(monrace.sex);
+    stream.visit(monrace.ability_flags);
+    stream.visit(monrace.aura_flags);
+    stream.visit(monrace.behavior_flags);
+    stream.visit(monrace.visual_flags);
+    stream.visit(monrace.kind_flags);
+    stream.visit(monrace.resistance_flags);
+    stream.visit(monrace.drop_flags);
+    stream.visit(monrace.wilderness_flags);
+    stream.visit(monrace.feature_flags);
+    stream.visit(monrace.population_flags);
+    stream.visit(monrace.speak_flags);
+    stream.visit(monrace.brightness_flags);
+    stream.visit(monrace.special_flags);
+    stream.visit(monrace.misc_flags);
+    for (auto &blow : monrace.blows) {
+        stream.visit(blow.method);
+        stream.visit(blow.effect);
+        stream.visit(blow.d_dice);
+        stream.visit(blow.d_side);
+    }
+
+    stream.visit(monrace.shoot_dam_dice);
+    stream.visit(monrace.shoot_dam_side);
+    stream.visit(monrace.reinforces);
+    stream.visit(monrace.drop_artifacts);
+    stream.visit(monrace.arena_ratio);
+    stream.visit(monrace.next_r_idx);
+    stream.visit(monrace.next_exp);
+    stream.visit(monrace.level);
+    stream.visit(monrace.rarity);
+    stream.visit(monrace.symbol_definition);
+    stream.visit(monrace.cur_hp_per);
+}
+
+template <typename Stream, typename Baseitem>
+void visit_baseitem(Stream &stream, Baseitem &baseitem)
+{
+    stream.visit(baseitem.idx);
+    stream.visit(baseitem.name);
+    stream.visit(baseitem.text);
+    stream.visit(baseitem.flavor_name);
+    stream.visit(baseitem.bi_key);
+    stream.visit(baseitem.pval);
+    stream.visit(baseitem.to_h);
+    stream.visit(baseitem.to_d);
+    stream.visit(baseitem.to_a);
+    stream.visit(baseitem.ac);
+    stream.visit(baseitem.dd);
+    stream.visit(baseitem.ds);
+    stream.visit(baseitem.weight);
+    stream.visit(baseitem.cost);
+    stream.visit(baseitem.flags);
+    stream.visit(baseitem.gen_flags);
+    stream.visit(baseitem.level);
+    for (auto &table : baseitem.alloc_tables) {
+        stream.visit(table.level);
+        stream.visit(table.chance);
+    }
+
+    stream.visit(baseitem.symbol_definition);
+    stream.visit(baseitem.act_idx);
+}
+
+template <typename Stream, typename Artifact>
+void visit_artifact(Stream &stream, Artifact &artifact)
+{
+    stream.visit(artifact.name);
+    stream.visit(artifact.text);
+    stream.visit(artifact.bi_key);
+    stream.visit(artifact.pval);
+    stream.visit(artifact.to_h);
+    stream.visit(artifact.to_d);
+    stream.visit(artifact.to_a);
+    stream.visit(artifact.ac);
+    stream.visit(artifact.dd);
+    stream.visit(artifact.ds);
+    stream.visit(artifact.weight);
+    stream.visit(artifact.cost);
+    stream.visit(artifact.flags);
+    stream.visit(artifact.gen_flags);
+    stream.visit(artifact.level);
+    stream.visit(artifact.rarity);
+    stream.visit(artifact.act_idx);
+}
+
+/*!
+ * @brief バイト列からIDをキーとするゲームデータの連想配列を読み込む
+ * @param bytes バイト列
+ * @param info 読み込み先の連想配列
+ * @param visit_info ゲームデータの各フィールドを読み込む関数
+ * @return 最後まで正しく読み込めたか
+ */
+template <typename Id, typename Info, typename Visitor>
+bool read_info_map(const std::vector<uint8_t> &bytes, std::map<Id, Info> &info, Visitor visit_info)
+{
+    CacheReader reader(bytes);
+    std::map<Id, Info> read_info;
+    for (auto count = reader.read_size(); count > 0; count--) {
+        Id id;
+        reader.visit(id);
+        visit_info(reader, read_info.emplace_hint(read_info.end(), id, Info{})->second);
+    }
+
+    if (!reader.is_completed()) {
+        return false;
+    }
+
+    info = std::move(read_info);
+    return true;
+}
+
+template <typename Id, typename Info, typename Visitor>
+std::vector<uint8_t> write_info_map(const std::map<Id, Info> &info, Visitor visit_info)
+{
+    CacheWriter writer;
+    writer.visit(static_cast<uint32_t>(info.size()));
+    for (const auto &[id, entry] : info) {
+        writer.visit(id);
+        visit_info(writer, entry);
+    }
+
+    return std::move(writer.bytes);
+}
+}
+
+/*!
+ * @brief コンストラクタ
+ * @param filename 定義ファイル名
+ * @param source 定義ファイルの内容
+ */
+DefinitionCache::DefinitionCache(std::string_view filename, std::string_view source)
+    : path(path_build(ANGBAND_DIR_DATA, std::filesystem::path(filename).replace_extension(_("_j.cache", ".cache")).string()))
+    , source(source)
+{
+}
+
+bool DefinitionCache::load(util::SHA256::Digest &digest, std::map<MonsterRaceId, MonsterRaceInfo> &monraces) const
+{
+    const auto bytes = this->read_payload(digest, sizeof(MonsterRaceInfo));
+    return read_info_map(bytes, monraces, [](auto &reader, auto &monrace) { visit_monrace(reader, monrace); });
+}
+
+bool DefinitionCache::load(util::SHA256::Digest &digest, std::vector<BaseitemInfo> &baseitems) const
+{
+    const auto bytes = this->read_payload(digest, sizeof(BaseitemInfo));
+    CacheReader reader(bytes);
+    std::vector<BaseitemInfo> read_baseitems(reader.read_size());
+    for (auto &baseitem : read_baseitems) {
+        visit_baseitem(reader, baseitem);
+    }
+
+    if (!reader.is_completed()) {
+        return false;
+    }
+
+    baseitems = std::move(read_baseitems);
+    return true;
+}
+
+bool DefinitionCache::load(util::SHA256::Digest &digest, std::map<FixedArtifactId, ArtifactType> &artifacts) const
+{
+    const auto bytes = this->read_payload(digest, sizeof(ArtifactType));
+    return read_info_map(bytes, artifacts, [](auto &reader, auto &artifact) { visit_artifact(reader, artifact); });
+}
+
+void DefinitionCache::save(const util::SHA256::Digest &digest, const std::map<MonsterRaceId, MonsterRaceInfo> &monraces) const
+{
+    const auto payload = write_info_map(monraces, [](auto &writer, const auto &monrace) { visit_monrace(writer, monrace); });
+    this->write(digest, sizeof(MonsterRaceInfo), payload);
+}
+
+void DefinitionCache::save(const util::SHA256::Digest &digest, const std::vector<BaseitemInfo> &baseitems) const
+{
+    CacheWriter writer;
+    writer.visit(static_cast<uint32_t>(baseitems.size()));
+    for (const auto &baseitem : baseitems) {
+        visit_baseitem(writer, baseitem);
+    }
+
+    this->write(digest, sizeof(BaseitemInfo), writer.bytes);
+}
+
+void DefinitionCache::save(const util::SHA256::Digest &digest, const std::map<FixedArtifactId, ArtifactType> &artifacts) const
+{
+    const auto payload = write_info_map(artifacts, [](auto &writer, const auto &artifact) { visit_artifact(writer, artifact); });
+    this->write(digest, sizeof(ArtifactType), payload);
+}
+
+/*!
+ * @brief キャッシュファイルのキーを求める
+ * @param record_size ゲームデータ1件を表す構造体の大きさ
+ * @return キー
+ */
+util::SHA256::Digest DefinitionCache::calc_key(size_t record_size) const
+{
+    util::SHA256 sha256;
+    sha256.update(this->source);
+    sha256.update(get_version());
+    sha256.update(std::to_string(CACHE_FORMAT_VERSION));
+    sha256.update(std::to_string(record_size));
+    return sha256.digest();
+}
+
+/*!
+ * @brief キャッシュファイルを一度に読み込み、キーが一致すればゲームデータ本体を返す
+ * @param digest 解析済みのJSONオブジェクトのハッシュ値の格納先
+ * @param record_size ゲームデータ1件を表す構造体の大きさ
+ * @return ゲームデータ本体 (キャッシュファイルが存在しないか古い場合は空)
+ */
+std::vector<uint8_t> DefinitionCache::read_payload(util::SHA256::Digest &digest, size_t record_size) const
+{
+    std::ifstream ifs(this->path, std::ios::binary | std::ios::ate);
+    if (!ifs) {
+        return {};
+    }
+
+    const auto size = static_cast<size_t>(ifs.tellg());
+    if (size <= CACHE_HEADER_SIZE) {
+        return {};
+    }
+
+    std::vector<uint8_t> bytes(size);
+    ifs.seekg(0);
+    if (!ifs.read(reinterpret_cast<char *>(bytes.data()), size)) {
+        return {};
+    }
+
+    auto it = bytes.begin();
+    if (!std::equal(CACHE_SIGNATURE.begin(), CACHE_SIGNATURE.end(), it)) {
+        return {};
+    }
+
+    it += CACHE_SIGNATURE.size();
+    const auto key = this->calc_key(record_size);
+    if (!std::equal(key.begin(), key.end(), it, [](auto a, auto b) { return a == static_cast<std::byte>(b); })) {
+        return {};
+    }
+
+    it += key.size();
+    std::transform(it, it + digest.size(), digest.begin(), [](auto b) { return static_cast<std::byte>(b); });
+    return { it + digest.size(), bytes.end() };
+}
+
+/*!
+ * @brief キャッシュファイルを書き込む
+ * @param digest 解析済みのJSONオブジェクトのハッシュ値
+ * @param record_size ゲームデータ1件を表す構造体の大きさ
+ * @param payload ゲームデータ本体
+ * @details キャッシュファイルは起動を速くするためだけのものなので、書き込みに失敗しても無視する.
+ * 定義ファイルは並列に読み込むため、権限の取得から解放までは排他的に行う.
+ */
+void DefinitionCache::write(const util::SHA256::Digest &digest, size_t record_size, const std::vector<uint8_t> &payload) const
+{
+    std::vector<uint8_t> bytes(CACHE_SIGNATURE.begin(), CACHE_SIGNATURE.end());
+    const auto key = this->calc_key(record_size);
+    const auto to_uint8 = [](auto b) { return static_cast<uint8_t>(b); };
+    std::transform(key.begin(), key.end(), std::back_inserter(bytes), to_uint8);
+    std::transform(digest.begin(), digest.end(), std::back_inserter(bytes), to_uint8);
+    bytes.insert(bytes.end(), payload.begin(), payload.end());
+
+    static std::mutex setuid_mutex;
+    std::unique_lock lock(setuid_mutex);
+    safe_setuid_grab();
+    std::ofstream ofs(this->path, std::ios::binary | std::ios::trunc);
+    safe_setuid_drop();
+    lock.unlock();
+    ofs.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "util/sha256.h"
+#include <filesystem>
+#include <map>
+#include <string_view>
+#include <vector>
+
+enum class FixedArtifactId : short;
+enum class MonsterRaceId : int16_t;
+class ArtifactType;
+class BaseitemInfo;
+class MonsterRaceInfo;
+
+/*!
+ * @brief 解析済みのゲームデータのキャッシュファイルを読み書きするクラス
+ * @details JSON形式の定義ファイルを解析して得たゲームデータを、lib/data/ 以下のバイナリファイルに保存する.
+ * キャッシュファイルは定義ファイルの内容、ゲームのバージョン及びデータ構造の大きさから求めたキーを持ち、
+ * キーが一致しない場合は古いものとして読み込まない.
+ * 解析済みのJSONオブジェクトから求めたハッシュ値 (キャラクタダンプのチェックサムに使う) もあわせて保存する.
+ */
+class DefinitionCache {
+public:
+    DefinitionCache(std::string_view filename, std::string_view source);
+
+    bool load(util::SHA256::Digest &digest, std::map<MonsterRaceId, MonsterRaceInfo> &monraces) const;
+    bool load(util::SHA256::Digest &digest, std::vector<BaseitemInfo> &baseitems) const;
+    bool load(util::SHA256::Digest &digest, std::map<FixedArtifactId, ArtifactType> &artifacts) const;
+    void save(const util::SHA256::Digest &digest, const std::map<MonsterRaceId, MonsterRaceInfo> &monraces) const;
+    void save(const util::SHA256::Digest &digest, const std::vector<BaseitemInfo> &baseitems) const;
+    void save(const util::SHA256::Digest &digest, const std::map<FixedArtifactId, ArtifactType> &artifacts) const;
+
+private:
+    std::filesystem::path path;
+    std::string_view source;
+
+    util::SHA256::Digest calc_key(size_t record_size) const;
+    std::vector<uint8_t> read_payload(util::SHA256::Digest &digest, size_t record_size) const;
+    void write(const util::SHA256::Digest &digest, size_t record_size, const std::vector<uint8_t> &payload) const;
+};
@@ -5,6 +5,7 @@
  */
 
 #include "item-info/flavor-initializer.h"
+#include "flavor/item-description-cache.h"
 #include "object/tval-types.h"
 #include "system/angband-system.h"
 #include "system/baseitem-info.h"
@@ -40,4 +41,6 @@ void initialize_items_flavor()
 
         baseitem.decide_easy_know();
     }
+
+    ItemDescriptionCache::get_instance().invalidate();
 }
@@ -2,6 +2,7 @@
 #include "floor/floor-generator.h"
 #include "floor/floor-object.h"
 #include "floor/floor-save-util.h"
+#include "floor/saved-floor-cache.h"
 #include "game-option/birth-options.h"
 #include "grid/feature.h"
 #include "grid/grid.h"
@@ -29,6 +30,7 @@
 #include "term/z-form.h"
 #include "util/angband-files.h"
 #include "world/world-object.h"
+#include <utility>
 
 /*!
  * @brief 保存されたフロアを読み込む / Read the saved floor
@@ -273,6 +275,7 @@ bool load_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr, BIT_FLAGS mode
     byte old_h_ver_patch = 0;
     byte old_h_ver_extra = 0;
     uint32_t old_loading_savefile_version = 0;
+    SavefileReadBuffer old_buffer;
     auto &system = AngbandSystem::get_instance();
     if (mode & SLF_SECOND) {
         old_fff = loading_savefile;
@@ -284,6 +287,7 @@ bool load_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr, BIT_FLAGS mode
         old_h_ver_patch = system.version_patch;
         old_h_ver_extra = system.version_extra;
         old_loading_savefile_version = loading_savefile_version;
+        old_buffer = std::exchange(loading_savefile_buffer, {});
     }
 
     auto floor_savefile = savefile.string();
@@ -291,27 +295,39 @@ bool load_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr, BIT_FLAGS mode
     strnfmt(ext, sizeof(ext), ".F%02d", (int)sf_ptr->savefile_id);
     floor_savefile.append(ext);
 
-    safe_setuid_grab();
-    loading_savefile = angband_fopen(floor_savefile, FileOpenMode::READ, true);
-    safe_setuid_drop();
-
+    /* 最近保存したフロアであればテンポラリファイルを読まずにメモリ上から復元する */
+    auto &cache = SavedFloorCache::get_instance();
+    auto cached_bytes = cache.find(sf_ptr->savefile_id);
+    auto is_found = cached_bytes.has_value();
     bool is_save_successful = true;
-    if (!loading_savefile) {
-        is_save_successful = false;
-    }
-
-    if (is_save_successful) {
+    if (is_found) {
+        loading_savefile = nullptr;
+        loading_savefile_buffer = { std::move(*cached_bytes), 0 };
         is_save_successful = load_floor_aux(player_ptr, sf_ptr);
-        if (ferror(loading_savefile)) {
+    } else {
+        safe_setuid_grab();
+        loading_savefile = angband_fopen(floor_savefile, FileOpenMode::READ, true);
+        safe_setuid_drop();
+        loading_savefile_buffer = {};
+        is_found = loading_savefile != nullptr;
+        if (!is_found) {
             is_save_successful = false;
         }
 
-        angband_fclose(loading_savefile);
-        safe_setuid_grab();
-        if (!(mode & SLF_NO_KILL)) {
-            (void)fd_kill(floor_savefile);
+        if (is_save_successful) {
+            is_save_successful = load_floor_aux(player_ptr, sf_ptr);
+            if (ferror(loading_savefile)) {
+                is_save_successful = false;
+            }
+
+            angband_fclose(loading_savefile);
         }
+    }
 
+    if (is_found && !(mode & SLF_NO_KILL)) {
+        cache.erase(sf_ptr->savefile_id);
+        safe_setuid_grab();
+        (void)fd_kill(floor_savefile);
         safe_setuid_drop();
     }
 
@@ -325,6 +341,7 @@ bool load_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr, BIT_FLAGS mode
         system.version_patch = old_h_ver_patch;
         system.version_extra = old_h_ver_extra;
         loading_savefile_version = old_loading_savefile_version;
+        loading_savefile_buffer = std::move(old_buffer);
     }
 
     byte old_kanji_code = kanji_code;
@@ -8,6 +8,7 @@
 #include "system/angband.h"
 #include "view/display-messages.h"
 #include "world/world.h"
+#include <algorithm>
 
 /*!
  * @brief セーブファイルからバージョン情報及びセーブ情報を取得する
@@ -68,19 +69,30 @@ void rd_version_info(void)
 
 /*!
  * @brief 乱数状態を読み込む / Read RNG state (added in 2.8.0)
+ * @details 他の種類の乱数列を保存していない古いセーブデータでは、汎用の乱数列から分岐させる.
  */
 void rd_randomizer(void)
 {
     strip_bytes(4);
-    Xoshiro128StarStar::state_type state{};
-    for (auto &s : state) {
-        s = rd_u32b();
+    auto &system = AngbandSystem::get_instance();
+    auto rngs = system.snapshot_rngs();
+    auto num_read = 0;
+    for (auto &rng : rngs) {
+        Xoshiro128StarStar::state_type state{};
+        for (auto &s : state) {
+            s = rd_u32b();
+            num_read++;
+        }
+
+        rng.set_state(state);
     }
 
-    Xoshiro128StarStar game_rng;
-    game_rng.set_state(state);
-    AngbandSystem::get_instance().set_rng(game_rng);
-    strip_bytes(4 * (RAND_DEG - state.size()));
+    strip_bytes(4 * (RAND_DEG - num_read));
+    system.reset_rngs(rngs.front());
+    const auto is_saved = [](const auto &rng) { return std::any_of(rng.get_state().begin(), rng.get_state().end(), [](auto s) { return s != 0; }); };
+    if (std::all_of(rngs.begin() + 1, rngs.end(), is_saved)) {
+        system.restore_rngs(rngs);
+    }
 }
 
 /*!
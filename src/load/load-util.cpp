@@ -4,6 +4,7 @@
 #include "term/screen-processor.h"
 
 FILE *loading_savefile;
+SavefileReadBuffer loading_savefile_buffer;
 uint32_t loading_savefile_version;
 byte load_xor_byte; // Old "encryption" byte.
 uint32_t v_check = 0L; // Simple "checksum" on the actual values.
@@ -18,6 +19,11 @@ uint32_t x_check = 0L; // Simple "checksum" on the encoded bytes.
  */
 byte kanji_code = 0;
 
+/*!
+ * @brief ファイルから一度に読み込むバイト数
+ */
+static constexpr size_t SAVEFILE_BUFFER_SIZE = 64 * 1024;
+
 /*!
  * @brief ゲームスクリーンにメッセージを表示する / Hack -- Show information on the screen, one line at a time.
  * @param msg 表示文字列
@@ -44,7 +50,15 @@ void load_note(std::string_view msg)
  */
 byte sf_get(void)
 {
-    byte c = getc(loading_savefile) & 0xFF;
+    auto &buffer = loading_savefile_buffer;
+    if (buffer.position >= buffer.bytes.size()) {
+        buffer.bytes.resize(SAVEFILE_BUFFER_SIZE);
+        buffer.bytes.resize(loading_savefile ? fread(buffer.bytes.data(), 1, SAVEFILE_BUFFER_SIZE, loading_savefile) : 0);
+        buffer.position = 0;
+    }
+
+    /* ファイル末尾では従来の getc() と同じく EOF の下位8ビットを読んだものとする */
+    byte c = buffer.bytes.empty() ? static_cast<byte>(EOF & 0xFF) : buffer.bytes[buffer.position++];
     byte v = c ^ load_xor_byte;
     load_xor_byte = c;
 
@@ -6,8 +6,20 @@
 #include <bitset>
 #include <string>
 #include <string_view>
+#include <vector>
+
+/*!
+ * @brief セーブファイルの読み込みバッファ
+ * @details ファイルからブロック単位で読み込んだ、復号前のバイト列と読み込み位置を保持する.
+ * loading_savefile が nullptr の場合は、あらかじめ格納したバイト列のみを読み込む
+ */
+struct SavefileReadBuffer {
+    std::vector<byte> bytes;
+    size_t position = 0;
+};
 
 extern FILE *loading_savefile;
+extern SavefileReadBuffer loading_savefile_buffer;
 extern uint32_t loading_savefile_version;
 extern byte load_xor_byte;
 extern uint32_t v_check;
@@ -272,6 +272,7 @@ static errr rd_savefile(PlayerType *player_ptr)
     safe_setuid_grab();
     loading_savefile = angband_fopen(savefile, FileOpenMode::READ, true);
     safe_setuid_drop();
+    loading_savefile_buffer = {};
     if (!loading_savefile) {
         return -1;
     }
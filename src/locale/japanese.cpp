@@ -366,6 +366,7 @@ static bool is_ascii_str(concptr str)
 #include <algorithm>
 #include <iconv.h>
 #include <initializer_list>
+#include <mutex>
 #include <vector>
 
 // UTF-8 の文字列長は必ずしも3バイトとは限らないが、変愚蛮怒の仕様範囲では3固定.
@@ -461,7 +462,10 @@ static void ms_to_jis_unicode(char *str)
  */
 int utf8_to_euc(char *utf8_str, size_t utf8_str_len, char *euc_buf, size_t euc_buf_len)
 {
+    /* 定義ファイルは並列に読み込むため、変換状態を持つ記述子の使用は排他的に行う */
+    static std::mutex mutex;
     static iconv_t cd = nullptr;
+    std::lock_guard lock(mutex);
     if (!cd) {
         cd = iconv_open("EUC-JP", "UTF-8");
     }
@@ -491,7 +495,9 @@ int utf8_to_euc(char *utf8_str, size_t utf8_str_len, char *euc_buf, size_t euc_b
  */
 int euc_to_utf8(const char *euc_str, size_t euc_str_len, char *utf8_buf, size_t utf8_buf_len)
 {
+    static std::mutex mutex;
     static iconv_t cd = nullptr;
+    std::lock_guard lock(mutex);
     if (!cd) {
         cd = iconv_open("UTF-8", "EUC-JP");
     }
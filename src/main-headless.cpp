@@ -0,0 +1,645 @@
+/*!
+ * @file main-headless.cpp
+ * @brief 画面を持たないフロントエンドの実装
+ * @details 端末への出力は一切行わず、画面の内容は term_type 自身が保持する仮想画面にだけ残す.
+ * キー入力はキー入力スクリプトから与え、尽きたら組み込みの自動操作 (休憩/探索/戦闘) で作る.
+ * 乱数の種を固定すれば同じキー入力に対して同じゲームが進むため、
+ * TTYのない環境で長時間のシミュレーションを再現可能な形で実行し、ゲームターンの処理速度を測ることができる.
+ * -g を指定した場合はゲームを始めずに、フロア生成のベンチマークの結果をCSVで出力して終了する.
+ * -c を指定した場合はゲームを始めずに、下り階段の先のフロアの先行生成を検証して終了する (食い違いがあれば終了コードは1).
+ *
+ * 使い方: hengband -mheadless -n -- [-k<スクリプト>] [-a<rest|explore|fight>] [-t<ゲームターン数>] [-s<乱数の種>] [-p] [-g<フロア数>] [-c<フロア数>]
+ */
+
+#include "floor/floor-generation-benchmark.h"
+#include "floor/geometry.h"
+#include "floor/next-floor-preparation-check.h"
+#include "game-option/runtime-arguments.h"
+#include "inventory/inventory-slot-types.h"
+#include "object/tval-types.h"
+#include "player/digestion-processor.h"
+#include "system/angband.h"
+#include "system/baseitem-info.h"
+#include "system/floor-type-definition.h"
+#include "system/grid-type-definition.h"
+#include "system/item-entity.h"
+#include "system/monster-entity.h"
+#include "system/player-type-definition.h"
+#include "system/terrain-type-definition.h"
+#include "term/gameterm.h"
+#include "term/term-color-types.h"
+#include "term/z-form.h"
+#include "term/z-term.h"
+#include "util/string-processor.h"
+#include "world/world.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <queue>
+#include <random>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#ifdef USE_HEADLESS
+
+namespace {
+/*!
+ * @brief キー入力スクリプトが尽きた後の自動操作の種類
+ */
+enum class HeadlessDriverType {
+    NONE, //!< 自動操作なし (スクリプトが尽きたら終了する)
+    REST, //!< その場で休憩を繰り返す
+    EXPLORE, //!< 未踏の場所と下り階段を目指して歩く
+    FIGHT, //!< 見えているモンスターに近付いて攻撃し、いなければ探索する
+};
+
+constexpr auto STALL_LIMIT = 1000; //!< ゲームターンが進まないまま自動操作を続ける最大の回数
+constexpr auto SEEN_RADIUS = 20; //!< 視界に入ったマスを記録する、プレイヤーからの範囲
+
+term_type term_screen_body;
+
+std::deque<char> script_keys; //!< キー入力スクリプトの残り
+std::deque<char> driver_keys; //!< 自動操作で作ったキー入力の残り
+HeadlessDriverType driver_type = HeadlessDriverType::NONE;
+std::mt19937 driver_rng;
+bool should_print_screen = false;
+std::optional<int> benchmark_floors; //!< フロア生成のベンチマークで、深さの範囲毎に生成するフロアの数
+std::optional<int> check_floors; //!< 先行生成の検証で、検証するフロアの数
+bool is_benchmarking = false;
+
+std::optional<GAME_TURN> turn_limit;
+std::optional<GAME_TURN> start_turn; //!< 計測を始めた時のゲームターン (ダンジョンに入るまでは計測しない)
+std::chrono::steady_clock::time_point start_time;
+std::chrono::steady_clock::duration driver_time{}; //!< 計測を始めてから自動操作の判断に費やした時間
+
+GAME_TURN last_turn = 0;
+int stalled_actions = 0; //!< ゲームターンが進まないまま自動操作を行った回数
+
+std::vector<bool> seen_grids; //!< 自動操作で一度でも視界に入ったマス
+bool has_seen_stairs = false; //!< seen_grids に下り階段があるか
+std::optional<std::tuple<FLOOR_IDX, DEPTH, POSITION, POSITION>> seen_floor; //!< seen_grids を作ったフロア
+
+/*!
+ * @brief 仮想画面の内容を標準出力に書き出す
+ */
+void print_screen()
+{
+    const auto &scr = term_screen_body.scr;
+    for (const auto &line : scr->c) {
+        std::string str(line.begin(), line.end());
+        const auto last = str.find_last_not_of(' ');
+        str.erase((last == std::string::npos) ? 0 : last + 1);
+        std::cout << str << '\n';
+    }
+}
+
+/*!
+ * @brief シミュレーションの結果を書き出して終了する
+ * @param reason 終了した理由
+ */
+[[noreturn]] void finish_simulation(std::string_view reason)
+{
+    const auto turns = start_turn ? w_ptr->game_turn - *start_turn : 0;
+    const auto elapsed = start_turn ? std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count() : 0.0;
+    std::cout << "result: " << reason << '\n';
+    std::cout << "game turns: " << turns << '\n';
+    const auto game_elapsed = elapsed - std::chrono::duration<double>(driver_time).count();
+    std::cout << "elapsed seconds: " << elapsed << '\n';
+    std::cout << "elapsed seconds except the driver: " << game_elapsed << '\n';
+    if (game_elapsed > 0.0) {
+        std::cout << "game turns per second: " << turns / game_elapsed << '\n';
+    }
+
+    if (should_print_screen) {
+        print_screen();
+    }
+
+    std::cout.flush();
+    quit(nullptr);
+    std::exit(EXIT_SUCCESS);
+}
+
+/*!
+ * @brief 計測の開始と終了の条件を調べる
+ */
+void check_simulation()
+{
+    if (!w_ptr->character_generated) {
+        return;
+    }
+
+    if (!start_turn && w_ptr->character_dungeon) {
+        start_turn = w_ptr->game_turn;
+        start_time = std::chrono::steady_clock::now();
+    }
+
+    if (p_ptr->is_dead) {
+        finish_simulation("player died");
+    }
+
+    if (start_turn && turn_limit && (w_ptr->game_turn - *start_turn >= *turn_limit)) {
+        finish_simulation("turn limit reached");
+    }
+}
+
+/*!
+ * @brief キー入力スクリプトを読み込む
+ * @param path スクリプトのパス
+ * @details 各行をマクロと同じ記法 (\e や ^M 等) で解釈して連結する. '#' で始まる行は注釈とする.
+ */
+void load_script(std::string_view path)
+{
+    std::ifstream ifs{ std::string(path) };
+    if (!ifs) {
+        quit_fmt("Cannot open the key script: %s", std::string(path).data());
+    }
+
+    std::string line;
+    while (std::getline(ifs, line)) {
+        if (line.empty() || line.starts_with('#')) {
+            continue;
+        }
+
+        char buf[1024]{};
+        text_to_ascii(buf, line, sizeof(buf));
+        script_keys.insert(script_keys.end(), buf, buf + std::string_view(buf).length());
+    }
+}
+
+bool is_walkable(const FloorType &floor, const Pos2D &pos)
+{
+    const auto &flags = floor.get_grid(pos).get_terrain().flags;
+    return flags.has(TerrainCharacteristics::MOVE) || flags.has(TerrainCharacteristics::OPEN);
+}
+
+bool is_down_stairs(const FloorType &floor, const Pos2D &pos)
+{
+    return floor.get_grid(pos).get_terrain().flags.has(TerrainCharacteristics::MORE);
+}
+
+/*!
+ * @brief プレイヤーの周りで視界に入っているマスを記録する
+ * @details フロアが変わったら記録を捨てる.
+ */
+void update_seen_grids(const FloorType &floor)
+{
+    const auto floor_signature = std::make_tuple(p_ptr->floor_id, floor.dun_level, floor.height, floor.width);
+    if (seen_floor != floor_signature) {
+        seen_grids.assign(floor.height * floor.width, false);
+        seen_floor = floor_signature;
+        has_seen_stairs = false;
+    }
+
+    const auto p_pos = p_ptr->get_position();
+    for (auto y = std::max(0, p_pos.y - SEEN_RADIUS); y <= std::min(floor.height - 1, p_pos.y + SEEN_RADIUS); y++) {
+        for (auto x = std::max(0, p_pos.x - SEEN_RADIUS); x <= std::min(floor.width - 1, p_pos.x + SEEN_RADIUS); x++) {
+            const Pos2D pos(y, x);
+            const auto &grid = floor.get_grid(pos);
+            if (grid.is_view() || grid.is_mark()) {
+                seen_grids[y * floor.width + x] = true;
+                has_seen_stairs |= is_down_stairs(floor, pos);
+            }
+        }
+    }
+}
+
+/*!
+ * @brief 条件を満たす最寄りのマスへの最短経路の、最初の1歩の方向を求める
+ * @param floor フロアへの参照
+ * @param is_goal 目標のマスか否かを返す関数
+ * @return テンキーの方向 (見つからなければ nullopt)
+ * @details 地形はプレイヤーの記憶ではなく実際のものを用いる.
+ */
+template <typename F>
+std::optional<int> find_first_step(const FloorType &floor, F is_goal)
+{
+    static std::vector<int> first_steps;
+    const auto p_pos = p_ptr->get_position();
+    first_steps.assign(floor.height * floor.width, -1);
+    std::queue<Pos2D> queue;
+    first_steps[p_pos.y * floor.width + p_pos.x] = 5;
+    queue.push(p_pos);
+    while (!queue.empty()) {
+        const auto pos = queue.front();
+        queue.pop();
+        const auto first_step = first_steps[pos.y * floor.width + pos.x];
+        for (auto dir = 1; dir <= 9; dir++) {
+            if (dir == 5) {
+                continue;
+            }
+
+            const Pos2D next(pos.y + ddy[dir], pos.x + ddx[dir]);
+            if ((next.y < 0) || (next.y >= floor.height) || (next.x < 0) || (next.x >= floor.width)) {
+                continue;
+            }
+
+            auto &next_first_step = first_steps[next.y * floor.width + next.x];
+            if (next_first_step >= 0) {
+                continue;
+            }
+
+            next_first_step = (pos == p_pos) ? dir : first_step;
+            if (is_goal(next)) {
+                return next_first_step;
+            }
+
+            if (is_walkable(floor, next)) {
+                queue.push(next);
+            }
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::string make_walk_keys(int dir)
+{
+    return std::string(";") + static_cast<char>('0' + dir);
+}
+
+/*!
+ * @brief 最寄りの見えている敵対的なモンスターを探す
+ */
+const MonsterEntity *find_nearest_enemy(const FloorType &floor)
+{
+    const auto p_pos = p_ptr->get_position();
+    const MonsterEntity *nearest = nullptr;
+    auto nearest_distance = 0;
+    for (MONSTER_IDX m_idx = 1; m_idx < floor.m_max; m_idx++) {
+        const auto &monster = floor.m_list[m_idx];
+        if (!monster.is_valid() || !monster.ml || !monster.is_hostile()) {
+            continue;
+        }
+
+        const auto d = distance(p_pos.y, p_pos.x, monster.fy, monster.fx);
+        if (!nearest || (d < nearest_distance)) {
+            nearest = &monster;
+            nearest_distance = d;
+        }
+    }
+
+    return nearest;
+}
+
+/*!
+ * @brief 探索のための1歩を決める
+ */
+std::string make_explore_keys(const FloorType &floor)
+{
+    const auto p_pos = p_ptr->get_position();
+    const auto is_seen = [&floor](const Pos2D &pos) { return seen_grids[pos.y * floor.width + pos.x]; };
+    if (is_down_stairs(floor, p_pos)) {
+        return ">";
+    }
+
+    std::optional<int> dir;
+    if (has_seen_stairs) {
+        dir = find_first_step(floor, [&](const Pos2D &pos) { return is_seen(pos) && is_down_stairs(floor, pos); });
+    }
+
+    if (!dir) {
+        dir = find_first_step(floor, [&](const Pos2D &pos) { return !is_seen(pos) && is_walkable(floor, pos); });
+    }
+
+    if (!dir) {
+        dir = std::uniform_int_distribution<int>(1, 8)(driver_rng);
+        if (*dir >= 5) {
+            ++*dir;
+        }
+    }
+
+    return make_walk_keys(*dir);
+}
+
+/*!
+ * @brief 空腹なら食べる食料を探す
+ * @return 食べる食料の選択キー (なければ nullopt)
+ */
+std::optional<char> find_food_to_eat()
+{
+    if (p_ptr->food >= PY_FOOD_WEAK) {
+        return std::nullopt;
+    }
+
+    for (auto i = 0; i < INVEN_PACK; i++) {
+        const auto &item = p_ptr->inventory_list[i];
+        if (item.is_valid() && (item.bi_key.tval() == ItemKindType::FOOD)) {
+            return static_cast<char>('a' + i);
+        }
+    }
+
+    return std::nullopt;
+}
+
+/*!
+ * @brief 仮想画面の最上行 (メッセージやプロンプトの行) を返す
+ */
+std::string_view get_top_line()
+{
+    const auto &line = term_screen_body.scr->c[0];
+    return std::string_view(line.data(), line.size());
+}
+
+/*!
+ * @brief 仮想画面の最上行に [y/n] の確認が出ているか
+ */
+bool is_asking_yes_no()
+{
+    const auto line = get_top_line();
+    return (line.find("[y/n]") != std::string_view::npos) || (line.find("[Y/n]") != std::string_view::npos);
+}
+
+/*!
+ * @brief キャラクター作成中のキー入力を作る
+ * @details 確認には 'y' で答え、初期オプションの画面はそのまま抜け、それ以外は既定値で確定させる.
+ */
+std::string make_birth_keys()
+{
+    if (is_asking_yes_no()) {
+        return "y";
+    }
+
+    if (get_top_line().starts_with(_("初期オプション", "Birth Options"))) {
+        return "\x1b";
+    }
+
+    return "\r";
+}
+
+/*!
+ * @brief 自動操作の次の行動のキー入力を作る
+ * @details [y/n] の確認には 'y' で答え、-more- は流す. それ以外のプロンプトで呼ばれても良いように、行動の先頭でエスケープを入力する.
+ */
+std::string make_driver_keys()
+{
+    if (!w_ptr->character_generated) {
+        return make_birth_keys();
+    }
+
+    if (!w_ptr->character_dungeon) {
+        return "\x1b";
+    }
+
+    if (w_ptr->game_turn == last_turn) {
+        stalled_actions++;
+    } else {
+        last_turn = w_ptr->game_turn;
+        stalled_actions = 0;
+    }
+
+    if (stalled_actions >= STALL_LIMIT) {
+        finish_simulation("stalled");
+    }
+
+    // ダンジョンの入口に入る時等の確認
+    if (is_asking_yes_no()) {
+        return "y";
+    }
+
+    // 続くメッセージに確認が含まれ得るので、-more- は1つずつ流す
+    if (get_top_line().find(_("-続く-", "-more-")) != std::string_view::npos) {
+        return "\x1b";
+    }
+
+    std::string keys("\x1b");
+    if (const auto food = find_food_to_eat()) {
+        return keys + 'E' + *food;
+    }
+
+    // 同じ行動でゲームターンが進まなくなったら、乱数の方向へ歩いて抜け出す
+    if ((stalled_actions > 0) && (stalled_actions % 10 == 0)) {
+        auto dir = std::uniform_int_distribution<int>(1, 8)(driver_rng);
+        return keys + make_walk_keys((dir >= 5) ? dir + 1 : dir);
+    }
+
+    if (driver_type == HeadlessDriverType::REST) {
+        return keys + "R&\r";
+    }
+
+    const auto &floor = *p_ptr->current_floor_ptr;
+    update_seen_grids(floor);
+    const auto *enemy = find_nearest_enemy(floor);
+    if ((driver_type == HeadlessDriverType::FIGHT) && enemy) {
+        const Pos2D m_pos(enemy->fy, enemy->fx);
+        if (const auto dir = find_first_step(floor, [&m_pos](const Pos2D &pos) { return pos == m_pos; })) {
+            return keys + make_walk_keys(*dir);
+        }
+    }
+
+    if (!enemy && (p_ptr->chp < p_ptr->mhp / 2)) {
+        return keys + "R&\r";
+    }
+
+    return keys + make_explore_keys(floor);
+}
+
+/*!
+ * @brief 次のキー入力を取り出す
+ * @return キー入力 (スクリプトが尽きて自動操作もなければ nullopt)
+ */
+std::optional<char> next_key()
+{
+    if (!script_keys.empty()) {
+        const auto key = script_keys.front();
+        script_keys.pop_front();
+        return key;
+    }
+
+    if (driver_type == HeadlessDriverType::NONE) {
+        return std::nullopt;
+    }
+
+    if (driver_keys.empty()) {
+        const auto start = std::chrono::steady_clock::now();
+        const auto keys = make_driver_keys();
+        driver_keys.insert(driver_keys.end(), keys.begin(), keys.end());
+        if (start_turn) {
+            driver_time += std::chrono::steady_clock::now() - start;
+        }
+    }
+
+    const auto key = driver_keys.front();
+    driver_keys.pop_front();
+    return key;
+}
+
+/*!
+ * @brief フロア生成のベンチマークを実行して終了する
+ * @details 初期化を終えて最初に入力を待つ時に呼ぶ.
+ */
+[[noreturn]] void run_floor_generation_benchmark()
+{
+    is_benchmarking = true;
+    output_floor_generation_benchmark(p_ptr, *benchmark_floors, arg_random_seed.value_or(0), std::cout);
+    std::cout.flush();
+    quit(nullptr);
+    std::exit(EXIT_SUCCESS);
+}
+
+/*!
+ * @brief 下り階段の先のフロアの先行生成を検証して終了する
+ * @details 初期化を終えて最初に入力を待つ時に呼ぶ.
+ */
+[[noreturn]] void run_next_floor_preparation_check()
+{
+    is_benchmarking = true;
+    const auto is_passed = output_next_floor_preparation_check(p_ptr, *check_floors, arg_random_seed.value_or(0), std::cout);
+    std::cout.flush();
+    quit(is_passed ? nullptr : "The next floor preparation check failed.");
+    std::exit(EXIT_FAILURE);
+}
+
+/*!
+ * @brief キー入力のイベントを処理する
+ * @param v 入力を待つか否か
+ * @details 入力を待たない問い合わせ (休憩中の中断の確認等) には常にキー入力なしと答える.
+ * ベンチマーク中と検証中の -more- は全て流す.
+ */
+errr game_term_xtra_headless_event(int v)
+{
+    if (!v) {
+        return 1;
+    }
+
+    if (is_benchmarking) {
+        term_key_push('\x1b');
+        return 0;
+    }
+
+    if (benchmark_floors) {
+        run_floor_generation_benchmark();
+    }
+
+    if (check_floors) {
+        run_next_floor_preparation_check();
+    }
+
+    const auto key = next_key();
+    if (!key) {
+        finish_simulation("end of the key script");
+    }
+
+    term_key_push(*key);
+    return 0;
+}
+
+/*!
+ * @brief 特殊な要求を処理する
+ * @details 画面に関わる要求は全て何もせずに成功とする. 遅延の要求も待たずに返す.
+ */
+errr game_term_xtra_headless(int n, int v)
+{
+    check_simulation();
+    switch (n) {
+    case TERM_XTRA_EVENT:
+        return game_term_xtra_headless_event(v);
+    case TERM_XTRA_CLEAR:
+    case TERM_XTRA_NOISE:
+    case TERM_XTRA_SHAPE:
+    case TERM_XTRA_FLUSH:
+    case TERM_XTRA_FRESH:
+    case TERM_XTRA_DELAY:
+    case TERM_XTRA_REACT:
+        return 0;
+    default:
+        return 1;
+    }
+}
+
+errr game_term_curs_headless(int, int)
+{
+    return 0;
+}
+
+errr game_term_wipe_headless(int, int, int)
+{
+    return 0;
+}
+
+errr game_term_text_headless(int, int, int, TERM_COLOR, concptr)
+{
+    return 0;
+}
+
+/*!
+ * @brief サブオプションを解釈する
+ */
+void parse_sub_options(int argc, char **argv)
+{
+    for (auto i = 1; i < argc; i++) {
+        const std::string_view arg(argv[i]);
+        if ((arg.length() < 2) || (arg[0] != '-')) {
+            quit_fmt("Unknown headless option: %s", argv[i]);
+        }
+
+        const auto value = arg.substr(2);
+        switch (arg[1]) {
+        case 'k':
+            load_script(value);
+            break;
+        case 'a':
+            if (value == "rest") {
+                driver_type = HeadlessDriverType::REST;
+            } else if (value == "explore") {
+                driver_type = HeadlessDriverType::EXPLORE;
+            } else if (value == "fight") {
+                driver_type = HeadlessDriverType::FIGHT;
+            } else {
+                quit_fmt("Unknown headless driver: %s", argv[i]);
+            }
+
+            break;
+        case 't':
+            turn_limit = std::strtoul(argv[i] + 2, nullptr, 10);
+            break;
+        case 's':
+            arg_random_seed = static_cast<uint32_t>(std::strtoul(argv[i] + 2, nullptr, 10));
+            break;
+        case 'p':
+            should_print_screen = true;
+            break;
+        case 'g':
+            benchmark_floors = std::max(1, std::atoi(argv[i] + 2));
+            break;
+        case 'c':
+            check_floors = std::max(1, std::atoi(argv[i] + 2));
+            break;
+        default:
+            quit_fmt("Unknown headless option: %s", argv[i]);
+        }
+    }
+
+    driver_rng.seed(arg_random_seed.value_or(0));
+}
+}
+
+/*!
+ * @brief 画面を持たないフロントエンドを初期化する
+ * @param argc サブオプションの数
+ * @param argv サブオプション
+ * @return 成功したら0
+ */
+errr init_headless(int argc, char **argv)
+{
+    parse_sub_options(argc, argv);
+
+    auto *t = &term_screen_body;
+    term_init(t, TERM_DEFAULT_COLS, TERM_DEFAULT_ROWS, 256);
+    t->attr_blank = TERM_WHITE;
+    t->char_blank = ' ';
+    t->text_hook = game_term_text_headless;
+    t->wipe_hook = game_term_wipe_headless;
+    t->curs_hook = game_term_curs_headless;
+    t->xtra_hook = game_term_xtra_headless;
+    term_screen = t;
+    term_activate(term_screen);
+    return 0;
+}
+
+#endif /* USE_HEADLESS */
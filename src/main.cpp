@@ -204,6 +204,17 @@ static void display_usage(const char *program)
     puts("  -mcap    To use CAP (\"Termcap\" calls)");
 #endif /* USE_CAP */
 
+#ifdef USE_HEADLESS
+    puts("  -mheadless To run without any display");
+    puts("  --       Sub options");
+    puts("  -- -k<file>  Read keystrokes from <file>");
+    puts("  -- -a<mode>  Drive the game after the keystrokes (rest, explore or fight)");
+    puts("  -- -t<num>   Stop after <num> game turns of play");
+    puts("  -- -s<num>   Fix the random seed of a new game");
+    puts("  -- -p        Print the final screen");
+    puts("  -- -g<num>   Generate <num> floors per depth range of every dungeon and print the timings as CSV");
+#endif /* USE_HEADLESS */
+
     /* Actually abort the process */
     quit(nullptr);
 }
@@ -389,6 +400,16 @@ int main(int argc, char *argv[])
     process_player_name(p_ptr, true);
     quit_aux = quit_hook;
 
+#ifdef USE_HEADLESS
+    if (!done && mstr && streq(mstr, "headless")) {
+        extern errr init_headless(int, char **);
+        if (0 == init_headless(argc, argv)) {
+            ANGBAND_SYS = "headless";
+            done = true;
+        }
+    }
+#endif
+
 #ifdef USE_X11
     if (!done && (!mstr || (streq(mstr, "x11")))) {
         extern errr init_x11(int, char **);
@@ -32,7 +32,14 @@
 #include "term/term-color-types.h"
 #include "time.h"
 #include "util/angband-files.h"
+#include "view/display-messages.h"
 #include "world/world.h"
+#include <chrono>
+#include <future>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
 
 /*!
  * @brief 各データファイルを読み取るためのパスを取得する.
@@ -99,6 +106,141 @@ static void init_angband_aux(const std::string &why)
     quit(_("致命的なエラー。", "Fatal Error."));
 }
 
+/*!
+ * @brief 定義ファイルごとの読み込み時間を lib/user/ 以下のファイルに書き出す
+ * @param wall_clock 全ての定義ファイルの読み込みにかかった実時間
+ * @details 起動時間の計測用. 書き込みに失敗しても無視する.
+ * 定義ファイルは並列に読み込むため、各ファイルの読み込み時間の合計は実時間より長くなり得る.
+ */
+static void write_startup_timing_report(std::chrono::microseconds wall_clock)
+{
+    std::stringstream ss;
+    auto total = 0.0;
+    for (const auto &[filename, is_cached, elapsed] : get_definition_load_times()) {
+        const auto ms = elapsed.count() / 1000.0;
+        total += ms;
+        ss << filename << '\t' << (is_cached ? "cache" : "text") << '\t' << ms << " ms\n";
+    }
+
+    ss << "total\t-\t" << total << " ms\n";
+    ss << "wall-clock\t-\t" << wall_clock.count() / 1000.0 << " ms\n";
+    const auto path = path_build(ANGBAND_DIR_USER, "startup-timing.txt");
+    auto *fp = angband_fopen(path, FileOpenMode::WRITE);
+    if (fp == nullptr) {
+        return;
+    }
+
+    fputs(ss.str().data(), fp);
+    angband_fclose(fp);
+}
+
+/*!
+ * @brief 定義ファイルの読み込み処理の1段階
+ */
+struct DefinitionInitializer {
+    errr (*initialize)(); //!< 読み込み処理
+    concptr error_message; //!< 読み込みに失敗した時のメッセージ
+};
+
+/*!
+ * @brief 定義ファイルを読み込むスレッドの結果
+ */
+struct DefinitionTaskResult {
+    concptr error_message = nullptr; //!< 読み込みに失敗した時のメッセージ (成功したらnullptr)
+    std::optional<DefinitionLoadError> load_error; //!< 定義ファイルの読み込みエラー (なければnullopt)
+    std::vector<std::string> messages; //!< 読み込み中に表示しようとしたメッセージ
+};
+
+/*!
+ * @brief 定義ファイルの読み込みの進捗表示
+ */
+struct DefinitionNote {
+    concptr note; //!< 表示する文字列
+    size_t task_index; //!< 表示した後に終了を待つ読み込み処理
+};
+
+/*!
+ * @brief 各定義ファイルを並列に読み込む
+ * @param init_note 進捗を表示する関数
+ * @details 互いに依存しない定義ファイルは別々のスレッドで読み込み、依存関係のあるもの
+ * (地形の定義を参照するダンジョンの定義など) だけを同じスレッドで順に読み込む.
+ * 各スレッドは端末を操作せず、エラーや表示しようとしたメッセージを結果として返す.
+ * 進捗の表示と、全てのスレッドの終了を待ってからのエラーの表示と終了はメインスレッドで行う.
+ */
+static void init_definitions(void (*init_note)(concptr))
+{
+    const auto start = std::chrono::steady_clock::now();
+    const std::vector<std::vector<DefinitionInitializer>> tasks{
+        {
+            { init_terrains_info, _("地形初期化不能", "Cannot initialize features") },
+            { init_feat_variables, _("地形初期化不能", "Cannot initialize features") },
+            { init_dungeons_info, _("ダンジョン初期化不能", "Cannot initialize dungeon") },
+        },
+        { { init_baseitems_info, _("アイテム初期化不能", "Cannot initialize objects") } },
+        { { init_artifacts_info, _("伝説のアイテム初期化不能", "Cannot initialize artifacts") } },
+        { { init_egos_info, _("名のあるアイテム初期化不能", "Cannot initialize ego-items") } },
+        { { init_monrace_definitions, _("モンスター初期化不能", "Cannot initialize monsters") } },
+        { { init_class_magics_info, _("魔法初期化不能", "Cannot initialize magic") } },
+        { { init_class_skills_info, _("熟練度初期化不能", "Cannot initialize skill") } },
+        { { init_vaults_info, _("vault 初期化不能", "Cannot initialize vaults") } },
+    };
+
+    std::vector<std::future<DefinitionTaskResult>> results;
+    for (const auto &task : tasks) {
+        results.push_back(std::async(std::launch::async, [&task] {
+            MessageCapture message_capture;
+            DefinitionTaskResult result;
+            for (const auto &[initialize, error_message] : task) {
+                if (initialize()) {
+                    result.error_message = error_message;
+                    result.load_error = take_definition_load_error();
+                    break;
+                }
+            }
+
+            result.messages = message_capture.take_messages();
+            return result;
+        }));
+    }
+
+    static const std::vector<DefinitionNote> notes{
+        { _("[データの初期化中... (地形)]", "[Initializing arrays... (features)]"), 0 },
+        { _("[データの初期化中... (アイテム)]", "[Initializing arrays... (objects)]"), 1 },
+        { _("[データの初期化中... (伝説のアイテム)]", "[Initializing arrays... (artifacts)]"), 2 },
+        { _("[データの初期化中... (名のあるアイテム)]", "[Initializing arrays... (ego-items)]"), 3 },
+        { _("[データの初期化中... (モンスター)]", "[Initializing arrays... (monsters)]"), 4 },
+        { _("[データの初期化中... (ダンジョン)]", "[Initializing arrays... (dungeon)]"), 0 },
+        { _("[データの初期化中... (魔法)]", "[Initializing arrays... (magic)]"), 5 },
+        { _("[データの初期化中... (熟練度)]", "[Initializing arrays... (skill)]"), 6 },
+    };
+
+    for (const auto &[note, task_index] : notes) {
+        init_note(note);
+        results[task_index].wait();
+    }
+
+    std::vector<DefinitionTaskResult> task_results;
+    for (auto &result : results) {
+        task_results.push_back(result.get());
+    }
+
+    for (const auto &[error_message, load_error, messages] : task_results) {
+        for (const auto &message : messages) {
+            msg_print(message);
+        }
+
+        if (load_error) {
+            quit_by_definition_load_error(*load_error);
+        }
+
+        if (error_message != nullptr) {
+            quit(error_message);
+        }
+    }
+
+    write_startup_timing_report(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start));
+}
+
 /*!
  * @brief タイトル記述
  * @param なし
@@ -171,56 +313,13 @@ void init_angband(PlayerType *player_ptr, bool no_term)
 
     void (*init_note)(concptr) = (no_term ? init_note_no_term : init_note_term);
 
-    init_note(_("[データの初期化中... (地形)]", "[Initializing arrays... (features)]"));
-    if (init_terrains_info()) {
-        quit(_("地形初期化不能", "Cannot initialize features"));
-    }
-
-    if (init_feat_variables()) {
-        quit(_("地形初期化不能", "Cannot initialize features"));
-    }
-
-    init_note(_("[データの初期化中... (アイテム)]", "[Initializing arrays... (objects)]"));
-    if (init_baseitems_info()) {
-        quit(_("アイテム初期化不能", "Cannot initialize objects"));
-    }
-
-    init_note(_("[データの初期化中... (伝説のアイテム)]", "[Initializing arrays... (artifacts)]"));
-    if (init_artifacts_info()) {
-        quit(_("伝説のアイテム初期化不能", "Cannot initialize artifacts"));
-    }
-
-    init_note(_("[データの初期化中... (名のあるアイテム)]", "[Initializing arrays... (ego-items)]"));
-    if (init_egos_info()) {
-        quit(_("名のあるアイテム初期化不能", "Cannot initialize ego-items"));
-    }
-
-    init_note(_("[データの初期化中... (モンスター)]", "[Initializing arrays... (monsters)]"));
-    if (init_monrace_definitions()) {
-        quit(_("モンスター初期化不能", "Cannot initialize monsters"));
-    }
-
-    init_note(_("[データの初期化中... (ダンジョン)]", "[Initializing arrays... (dungeon)]"));
-    if (init_dungeons_info()) {
-        quit(_("ダンジョン初期化不能", "Cannot initialize dungeon"));
-    }
-
+    init_definitions(init_note);
     for (const auto &d_ref : dungeons_info) {
         if (d_ref.idx > 0 && MonsterRace(d_ref.final_guardian).is_valid()) {
             monraces_info[d_ref.final_guardian].misc_flags.set(MonsterMiscType::GUARDIAN);
         }
     }
 
-    init_note(_("[データの初期化中... (魔法)]", "[Initializing arrays... (magic)]"));
-    if (init_class_magics_info()) {
-        quit(_("魔法初期化不能", "Cannot initialize magic"));
-    }
-
-    init_note(_("[データの初期化中... (熟練度)]", "[Initializing arrays... (skill)]"));
-    if (init_class_skills_info()) {
-        quit(_("熟練度初期化不能", "Cannot initialize skill"));
-    }
-
     init_note(_("[配列を初期化しています... (荒野)]", "[Initializing arrays... (wilderness)]"));
     if (!init_wilderness()) {
         quit(_("荒野を初期化できません", "Cannot initialize wilderness"));
@@ -234,10 +333,6 @@ void init_angband(PlayerType *player_ptr, bool no_term)
 
     init_note(_("[配列を初期化しています... (クエスト)]", "[Initializing arrays... (quests)]"));
     QuestList::get_instance().initialize();
-    if (init_vaults_info()) {
-        quit(_("vault 初期化不能", "Cannot initialize vaults"));
-    }
-
     init_note(_("[データの初期化中... (その他)]", "[Initializing arrays... (other)]"));
     init_other(player_ptr);
     init_note(_("[データの初期化中... (モンスターアロケーション)]", "[Initializing arrays... (monsters alloc)]"));
@@ -55,7 +55,7 @@ void init_other(PlayerType *player_ptr)
     }
 
     max_dlv.assign(dungeons_info.size(), {});
-    floor_ptr->grid_array.assign(MAX_HGT, std::vector<Grid>(MAX_WID));
+    floor_ptr->grid_array.assign(MAX_HGT, MAX_WID);
     init_gf_colors();
 
     macro_patterns.assign(MACRO_MAX, {});
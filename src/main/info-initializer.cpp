@@ -8,6 +8,7 @@
 #include "floor/wild.h"
 #include "info-reader/artifact-reader.h"
 #include "info-reader/baseitem-reader.h"
+#include "info-reader/definition-cache.h"
 #include "info-reader/dungeon-reader.h"
 #include "info-reader/ego-reader.h"
 #include "info-reader/feature-reader.h"
@@ -35,12 +36,18 @@
 #include "system/player-type-definition.h"
 #include "system/terrain-type-definition.h"
 #include "util/angband-files.h"
+#include "util/finalizer.h"
 #include "util/string-processor.h"
 #include "view/display-messages.h"
 #include "world/world.h"
+#include <chrono>
 #include <fstream>
+#include <iterator>
+#include <mutex>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 #include <sys/stat.h>
 #ifndef WINDOWS
 #include <sys/types.h>
@@ -67,6 +74,25 @@ struct is_vector<std::vector<T, Alloc>> : std::true_type {
 template <typename T>
 constexpr bool is_vector_v = is_vector<T>::value;
 
+std::mutex definition_load_times_mutex;
+std::vector<DefinitionLoadTime> definition_load_times;
+
+/*! 定義ファイルを読み込んでいるスレッドで最後に起きた読み込みエラー (なければnullopt) */
+thread_local std::optional<DefinitionLoadError> definition_load_error;
+
+/*!
+ * @brief 定義ファイルの読み込みにかかった時間を記録する
+ * @param filename 定義ファイル名
+ * @param is_cached キャッシュファイルから読み込んだか
+ * @param start 読み込みを開始した時刻
+ */
+void record_definition_load_time(std::string_view filename, bool is_cached, std::chrono::steady_clock::time_point start)
+{
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    std::lock_guard lock(definition_load_times_mutex);
+    definition_load_times.push_back({ std::string(filename), is_cached, elapsed });
+}
+
 }
 
 /*!
@@ -97,10 +123,13 @@ static void init_header(angband_header *head, IDX num = 0)
 template <typename InfoType>
 static errr init_info(std::string_view filename, angband_header &head, InfoType &info, Parser parser, Retoucher retouch = nullptr)
 {
+    const auto start = std::chrono::steady_clock::now();
+    const auto recorder = util::make_finalizer([filename, start] { record_definition_load_time(filename, false, start); });
     const auto path = path_build(ANGBAND_DIR_EDIT, filename);
     auto *fp = angband_fopen(path, FileOpenMode::READ);
     if (!fp) {
-        quit_fmt(_("'%s'ファイルをオープンできません。", "Cannot open '%s' file."), filename.data());
+        definition_load_error = { DefinitionLoadErrorType::OPEN, std::string(filename) };
+        return PARSE_ERROR_GENERIC;
     }
 
     constexpr auto info_is_vector = is_vector_v<InfoType>;
@@ -113,16 +142,8 @@ static errr init_info(std::string_view filename, angband_header &head, InfoType
     const auto &[error_code, error_line] = init_info_txt(fp, buf, &head, parser);
     angband_fclose(fp);
     if (error_code != PARSE_ERROR_NONE) {
-        const auto oops = (((error_code > 0) && (error_code < PARSE_ERROR_MAX)) ? err_str[error_code] : _("未知の", "unknown"));
-#ifdef JP
-        msg_format("'%s'ファイルの %d 行目にエラー。", filename.data(), error_line);
-#else
-        msg_format("Error %d at line %d of '%s'.", error_code, error_line, filename.data());
-#endif
-        msg_format(_("レコード %d は '%s' エラーがあります。", "Record %d contains a '%s' error."), error_idx, oops);
-        msg_format(_("構文 '%s'。", "Parsing '%s'."), buf);
-        msg_print(nullptr);
-        quit_fmt(_("'%s'ファイルにエラー", "Error in '%s' file."), filename.data());
+        definition_load_error = { DefinitionLoadErrorType::TEXT_PARSE, std::string(filename), error_code, error_line, error_idx, buf };
+        return error_code;
     }
 
     if constexpr (info_is_vector) {
@@ -144,6 +165,9 @@ static errr init_info(std::string_view filename, angband_header &head, InfoType
  * @param head 処理に用いるヘッダ構造体
  * @param info データ保管先の構造体ポインタ
  * @return エラーコード
+ * @details
+ * JSONの解析は時間がかかるため、解析済みのゲームデータを lib/data/ 以下のキャッシュファイルに保存しておき、
+ * 定義ファイルの内容が変わっていなければそちらから読み込む. 変わっていれば定義ファイルを解析してキャッシュファイルを作り直す.
  * @note
  * Note that we let each entry have a unique "name" and "text" string,
  * even if the string happens to be empty (everyone has a unique '\0').
@@ -151,16 +175,25 @@ static errr init_info(std::string_view filename, angband_header &head, InfoType
 template <typename InfoType>
 static errr init_json(std::string_view filename, std::string_view keyname, angband_header &head, InfoType &info, JSONParser parser)
 {
+    const auto start = std::chrono::steady_clock::now();
+    auto is_cached = false;
+    const auto recorder = util::make_finalizer([filename, start, &is_cached] { record_definition_load_time(filename, is_cached, start); });
     const auto path = path_build(ANGBAND_DIR_EDIT, filename);
-    std::ifstream ifs(path);
+    std::ifstream ifs(path, std::ios::binary);
 
     if (!ifs) {
-        quit_fmt(_("'%s'ファイルをオープンできません。", "Cannot open '%s' file."), filename.data());
+        definition_load_error = { DefinitionLoadErrorType::OPEN, std::string(filename) };
+        return PARSE_ERROR_GENERIC;
+    }
+
+    const std::string source{ std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>() };
+    const DefinitionCache cache(filename, source);
+    is_cached = cache.load(head.digest, info);
+    if (is_cached) {
+        return PARSE_ERROR_NONE;
     }
 
-    std::istreambuf_iterator<char> ifs_iter(ifs);
-    std::istreambuf_iterator<char> ifs_end;
-    auto json_object = nlohmann::json::parse(ifs_iter, ifs_end, nullptr, true, true);
+    auto json_object = nlohmann::json::parse(source, nullptr, true, true);
 
     constexpr auto info_is_vector = is_vector_v<InfoType>;
     if constexpr (info_is_vector) {
@@ -172,18 +205,70 @@ static errr init_json(std::string_view filename, std::string_view keyname, angba
     for (auto &element : json_object[keyname]) {
         const auto error_code = parser(element, &head);
         if (error_code != PARSE_ERROR_NONE) {
-            msg_print(nullptr);
-            quit_fmt(_("'%s'ファイルにエラー", "Error in '%s' file."), filename.data());
+            definition_load_error = { DefinitionLoadErrorType::JSON_PARSE, std::string(filename), error_code, 0, error_idx };
+            return error_code;
         }
     }
 
     util::SHA256 sha256;
     sha256.update(json_object.dump());
     head.digest = sha256.digest();
+    cache.save(head.digest, info);
 
     return PARSE_ERROR_NONE;
 }
 
+/*!
+ * @brief 各定義ファイルの読み込みにかかった時間を読み込みが終わった順に取得する
+ * @return 定義ファイルごとの読み込み時間のリスト
+ * @details 全ての定義ファイルの読み込みが終わってから呼び出すこと
+ */
+const std::vector<DefinitionLoadTime> &get_definition_load_times()
+{
+    return definition_load_times;
+}
+
+/*!
+ * @brief 呼び出したスレッドで最後に起きた定義ファイルの読み込みエラーを取り出す
+ * @return 読み込みエラー (なければnullopt)
+ */
+std::optional<DefinitionLoadError> take_definition_load_error()
+{
+    return std::exchange(definition_load_error, std::nullopt);
+}
+
+/*!
+ * @brief 定義ファイルの読み込みエラーを表示して終了する
+ * @param error 読み込みエラー
+ * @details 端末を操作するため、メインスレッドから呼び出すこと
+ */
+void quit_by_definition_load_error(const DefinitionLoadError &error)
+{
+    const auto *filename = error.filename.data();
+    switch (error.type) {
+    case DefinitionLoadErrorType::OPEN:
+        quit_fmt(_("'%s'ファイルをオープンできません。", "Cannot open '%s' file."), filename);
+        return;
+    case DefinitionLoadErrorType::TEXT_PARSE: {
+        const auto error_code = error.error_code;
+        const auto oops = (((error_code > 0) && (error_code < PARSE_ERROR_MAX)) ? err_str[error_code] : _("未知の", "unknown"));
+#ifdef JP
+        msg_format("'%s'ファイルの %d 行目にエラー。", filename, error.error_line);
+#else
+        msg_format("Error %d at line %d of '%s'.", error_code, error.error_line, filename);
+#endif
+        msg_format(_("レコード %d は '%s' エラーがあります。", "Record %d contains a '%s' error."), error.error_idx, oops);
+        msg_format(_("構文 '%s'。", "Parsing '%s'."), error.line.data());
+        break;
+    }
+    case DefinitionLoadErrorType::JSON_PARSE:
+        break;
+    }
+
+    msg_print(nullptr);
+    quit_fmt(_("'%s'ファイルにエラー", "Error in '%s' file."), filename);
+}
+
 /*!
  * @brief 固定アーティファクト情報読み込みのメインルーチン
  * @return エラーコード
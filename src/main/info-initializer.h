@@ -5,6 +5,41 @@
  */
 
 #include "system/angband.h"
+#include <chrono>
+#include <optional>
+#include <string>
+#include <vector>
+
+/*!
+ * @brief 定義ファイルの読み込みにかかった時間
+ */
+struct DefinitionLoadTime {
+    std::string filename; //!< 定義ファイル名
+    bool is_cached; //!< キャッシュファイルから読み込んだか
+    std::chrono::microseconds elapsed; //!< 読み込みにかかった時間
+};
+
+/*!
+ * @brief 定義ファイルの読み込みエラーの種類
+ */
+enum class DefinitionLoadErrorType {
+    OPEN, //!< ファイルを開けなかった
+    TEXT_PARSE, //!< テキスト形式の定義ファイルの解析に失敗した
+    JSON_PARSE, //!< JSON形式の定義ファイルの解析に失敗した
+};
+
+/*!
+ * @brief 定義ファイルの読み込みエラー
+ * @details 定義ファイルは別スレッドで読み込むため、エラーはその場で表示せずに記録し、メインスレッドで表示する.
+ */
+struct DefinitionLoadError {
+    DefinitionLoadErrorType type;
+    std::string filename; //!< 定義ファイル名
+    errr error_code = 0; //!< エラーコード
+    int error_line = 0; //!< エラーのあった行番号
+    int error_idx = 0; //!< エラーのあったレコードのID
+    std::string line; //!< エラーのあった行
+};
 
 class PlayerType;
 errr init_artifacts_info();
@@ -17,3 +52,6 @@ errr init_monrace_definitions();
 errr init_terrains_info();
 errr init_vaults_info();
 bool init_wilderness();
+const std::vector<DefinitionLoadTime> &get_definition_load_times();
+std::optional<DefinitionLoadError> take_definition_load_error();
+void quit_by_definition_load_error(const DefinitionLoadError &error);
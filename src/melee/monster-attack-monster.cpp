@@ -27,6 +27,7 @@
 #include "monster/monster-status.h"
 #include "spell-kind/spells-teleport.h"
 #include "spell-realm/spells-hex.h"
+#include "system/angband-system.h"
 #include "system/dungeon-info.h"
 #include "system/floor-type-definition.h"
 #include "system/monster-entity.h"
@@ -344,6 +345,7 @@ void repeat_melee(PlayerType *player_ptr, mam_type *mam_ptr)
  */
 bool monst_attack_monst(PlayerType *player_ptr, MONSTER_IDX m_idx, MONSTER_IDX t_idx)
 {
+    RngStreamSelector rng_selector(RngStream::COMBAT);
     mam_type tmp_mam;
     mam_type *mam_ptr = initialize_mam_type(player_ptr, &tmp_mam, m_idx, t_idx);
 
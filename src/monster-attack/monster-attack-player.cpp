@@ -43,6 +43,7 @@
 #include "spell-realm/spells-hex.h"
 #include "status/action-setter.h"
 #include "status/bad-status-setter.h"
+#include "system/angband-system.h"
 #include "system/angband.h"
 #include "system/dungeon-info.h"
 #include "system/floor-type-definition.h"
@@ -76,6 +77,7 @@ MonsterAttackPlayer::MonsterAttackPlayer(PlayerType *player_ptr, short m_idx)
  */
 void MonsterAttackPlayer::make_attack_normal()
 {
+    RngStreamSelector rng_selector(RngStream::COMBAT);
     if (!this->check_no_blow()) {
         return;
     }
@@ -18,44 +18,91 @@
 #include "system/monster-race-info.h"
 #include "system/player-type-definition.h"
 #include "system/redrawing-flags-updater.h"
+#include "util/bit-flags-calculator.h"
+#include "util/enum-converter.h"
 #include "util/point-2d.h"
 #include "view/display-messages.h"
 #include "world/world.h"
+#include <optional>
 #include <vector>
 
+namespace {
 /*!
- * @brief モンスターによる光量状態更新 / Add a square to the changes array
+ * @brief モンスターの灯りの範囲を表すステンシルの要素
+ * @details conditions の相対座標の地形が全て灯りを通す (光源ならLOS、暗黒ならPROJECT) 場合に限り、cells の相対座標が灯りの範囲に入る
+ */
+struct MonsterLiteStencil {
+    int radius; //!< 必要な灯りの半径
+    std::vector<Pos2DVec> conditions;
+    std::vector<Pos2DVec> cells;
+};
+
+const std::vector<MonsterLiteStencil> MONSTER_LITE_STENCILS = {
+    { 1, {}, { { 0, 0 }, { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 } } },
+    { 2, { { 1, 0 } }, { { 2, 1 }, { 2, 0 }, { 2, -1 } } },
+    { 3, { { 1, 0 }, { 2, 0 } }, { { 3, 1 }, { 3, 0 }, { 3, -1 } } },
+    { 2, { { -1, 0 } }, { { -2, 1 }, { -2, 0 }, { -2, -1 } } },
+    { 3, { { -1, 0 }, { -2, 0 } }, { { -3, 1 }, { -3, 0 }, { -3, -1 } } },
+    { 2, { { 0, 1 } }, { { 1, 2 }, { 0, 2 }, { -1, 2 } } },
+    { 3, { { 0, 1 }, { 0, 2 } }, { { 1, 3 }, { 0, 3 }, { -1, 3 } } },
+    { 2, { { 0, -1 } }, { { 1, -2 }, { 0, -2 }, { -1, -2 } } },
+    { 3, { { 0, -1 }, { 0, -2 } }, { { 1, -3 }, { 0, -3 }, { -1, -3 } } },
+    { 3, { { 1, 1 } }, { { 2, 2 } } },
+    { 3, { { 1, -1 } }, { { 2, -2 } } },
+    { 3, { { -1, 1 } }, { { -2, 2 } } },
+    { 3, { { -1, -1 } }, { { -2, -2 } } },
+};
+
+/*!
+ * @brief モンスター1体分の灯りの範囲のキャッシュ
+ * @details 灯りの範囲はモンスターとプレイヤーの位置、灯りの半径と種類及び視界と地形だけで決まるため、
+ * これらが変わらない限り計算し直さずに使い回す. 視界と地形の変化は generation で検出する.
+ */
+struct MonsterLiteCache {
+    uint32_t generation = 0; //!< 0なら未計算
+    Pos2D monster_pos{ 0, 0 };
+    Pos2D player_pos{ 0, 0 };
+    int radius = 0;
+    bool is_dark = false;
+    bool mon_invis = false;
+    std::vector<Pos2D> cells; //!< 灯りの範囲に入るプレイヤーの視界内のグリッド
+};
+
+uint32_t mon_lite_cache_generation = 1;
+std::vector<MonsterLiteCache> mon_lite_caches;
+
+/*!
+ * @brief モンスターの灯りがグリッドに届くかを判定する
  * @param player_ptr プレイヤーへの参照ポインタ
- * @param points 座標たちを記録する配列
  * @param y Y座標
  * @param x X座標
+ * @param ml_ptr モンスターの灯りの情報
+ * @return プレイヤーの視界内で灯りが届くか
  */
-static void update_monster_lite(
-    PlayerType *const player_ptr, std::vector<Pos2D> &points, const POSITION y, const POSITION x, const monster_lite_type *const ml_ptr)
+bool is_lit_by_monster(PlayerType *const player_ptr, const POSITION y, const POSITION x, const monster_lite_type *const ml_ptr)
 {
-    Grid *g_ptr;
     int dpf, d;
     POSITION midpoint;
-    g_ptr = &player_ptr->current_floor_ptr->grid_array[y][x];
-    if ((g_ptr->info & (CAVE_MNLT | CAVE_VIEW)) != CAVE_VIEW) {
-        return;
+    const auto &grid = player_ptr->current_floor_ptr->grid_array[y][x];
+    if (none_bits(grid.info, CAVE_VIEW)) {
+        return false;
     }
 
-    if (!feat_supports_los(g_ptr->feat)) {
+    if (!feat_supports_los(grid.feat)) {
         if (((y < player_ptr->y) && (y > ml_ptr->mon_fy)) || ((y > player_ptr->y) && (y < ml_ptr->mon_fy))) {
             dpf = player_ptr->y - ml_ptr->mon_fy;
             d = y - ml_ptr->mon_fy;
             midpoint = ml_ptr->mon_fx + ((player_ptr->x - ml_ptr->mon_fx) * std::abs(d)) / std::abs(dpf);
             if (x < midpoint) {
                 if (!cave_los_bold(player_ptr->current_floor_ptr, y, x + 1)) {
-                    return;
+                    return false;
                 }
             } else if (x > midpoint) {
                 if (!cave_los_bold(player_ptr->current_floor_ptr, y, x - 1)) {
-                    return;
+                    return false;
                 }
             } else if (ml_ptr->mon_invis) {
-                return;
+                return false;
             }
         }
 
@@ -65,55 +112,52 @@ static void update_monster_lite(
             midpoint = ml_ptr->mon_fy + ((player_ptr->y - ml_ptr->mon_fy) * std::abs(d)) / std::abs(dpf);
             if (y < midpoint) {
                 if (!cave_los_bold(player_ptr->current_floor_ptr, y + 1, x)) {
-                    return;
+                    return false;
                 }
             } else if (y > midpoint) {
                 if (!cave_los_bold(player_ptr->current_floor_ptr, y - 1, x)) {
-                    return;
+                    return false;
                 }
             } else if (ml_ptr->mon_invis) {
-                return;
+                return false;
             }
         }
     }
 
-    if (!(g_ptr->info & CAVE_MNDK)) {
-        points.emplace_back(y, x);
-    } else {
-        g_ptr->info &= ~(CAVE_MNDK);
-    }
-
-    g_ptr->info |= CAVE_MNLT;
+    return true;
 }
 
-/*
- * Add a square to the changes array
+/*!
+ * @brief モンスターの暗黒がグリッドに届くかを判定する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param y Y座標
+ * @param x X座標
+ * @param ml_ptr モンスターの灯りの情報
+ * @return プレイヤーの視界内で暗黒が届くか
  */
-static void update_monster_dark(
-    PlayerType *const player_ptr, std::vector<Pos2D> &points, const POSITION y, const POSITION x, const monster_lite_type *const ml_ptr)
+bool is_darkened_by_monster(PlayerType *const player_ptr, const POSITION y, const POSITION x, const monster_lite_type *const ml_ptr)
 {
-    Grid *g_ptr;
     int midpoint, dpf, d;
-    g_ptr = &player_ptr->current_floor_ptr->grid_array[y][x];
-    if ((g_ptr->info & (CAVE_LITE | CAVE_MNLT | CAVE_MNDK | CAVE_VIEW)) != CAVE_VIEW) {
-        return;
+    const auto &grid = player_ptr->current_floor_ptr->grid_array[y][x];
+    if (none_bits(grid.info, CAVE_VIEW)) {
+        return false;
     }
 
-    if (!feat_supports_los(g_ptr->feat) && !g_ptr->cave_has_flag(TerrainCharacteristics::PROJECT)) {
+    if (!feat_supports_los(grid.feat) && !grid.cave_has_flag(TerrainCharacteristics::PROJECT)) {
         if (((y < player_ptr->y) && (y > ml_ptr->mon_fy)) || ((y > player_ptr->y) && (y < ml_ptr->mon_fy))) {
             dpf = player_ptr->y - ml_ptr->mon_fy;
             d = y - ml_ptr->mon_fy;
             midpoint = ml_ptr->mon_fx + ((player_ptr->x - ml_ptr->mon_fx) * std::abs(d)) / std::abs(dpf);
             if (x < midpoint) {
                 if (!cave_los_bold(player_ptr->current_floor_ptr, y, x + 1) && !cave_has_flag_bold(player_ptr->current_floor_ptr, y, x + 1, TerrainCharacteristics::PROJECT)) {
-                    return;
+                    return false;
                 }
             } else if (x > midpoint) {
                 if (!cave_los_bold(player_ptr->current_floor_ptr, y, x - 1) && !cave_has_flag_bold(player_ptr->current_floor_ptr, y, x - 1, TerrainCharacteristics::PROJECT)) {
-                    return;
+                    return false;
                 }
             } else if (ml_ptr->mon_invis) {
-                return;
+                return false;
             }
         }
 
@@ -123,20 +167,170 @@ static void update_monster_dark(
             midpoint = ml_ptr->mon_fy + ((player_ptr->y - ml_ptr->mon_fy) * std::abs(d)) / std::abs(dpf);
             if (y < midpoint) {
                 if (!cave_los_bold(player_ptr->current_floor_ptr, y + 1, x) && !cave_has_flag_bold(player_ptr->current_floor_ptr, y + 1, x, TerrainCharacteristics::PROJECT)) {
-                    return;
+                    return false;
                 }
             } else if (y > midpoint) {
                 if (!cave_los_bold(player_ptr->current_floor_ptr, y - 1, x) && !cave_has_flag_bold(player_ptr->current_floor_ptr, y - 1, x, TerrainCharacteristics::PROJECT)) {
-                    return;
+                    return false;
                 }
             } else if (ml_ptr->mon_invis) {
-                return;
+                return false;
             }
         }
     }
 
-    points.emplace_back(y, x);
-    g_ptr->info |= CAVE_MNDK;
+    return true;
+}
+
+/*!
+ * @brief モンスターの光源をグリッドに加える / Add a square to the changes array
+ * @param points 状態の変わりうる座標たちを記録する配列
+ * @param pos 灯りの届くグリッドの座標
+ * @param grid 灯りの届くグリッド
+ * @details 既に暗黒が加わっていたら光源で打ち消す
+ */
+void add_monster_lite(std::vector<Pos2D> &points, const Pos2D &pos, Grid &grid)
+{
+    if (any_bits(grid.info, CAVE_MNLT)) {
+        return;
+    }
+
+    if (none_bits(grid.info, CAVE_MNDK)) {
+        points.push_back(pos);
+    } else {
+        reset_bits(grid.info, CAVE_MNDK);
+    }
+
+    set_bits(grid.info, CAVE_MNLT);
+}
+
+/*!
+ * @brief モンスターの暗黒をグリッドに加える / Add a square to the changes array
+ * @param points 状態の変わりうる座標たちを記録する配列
+ * @param pos 暗黒の届くグリッドの座標
+ * @param grid 暗黒の届くグリッド
+ * @details プレイヤーやモンスターの光源に照らされていたら加えない
+ */
+void add_monster_dark(std::vector<Pos2D> &points, const Pos2D &pos, Grid &grid)
+{
+    if (any_bits(grid.info, CAVE_LITE | CAVE_MNLT | CAVE_MNDK)) {
+        return;
+    }
+
+    points.push_back(pos);
+    set_bits(grid.info, CAVE_MNDK);
+}
+
+/*!
+ * @brief モンスター種族の灯りの半径を計算する
+ * @param monrace モンスター種族
+ * @return 灯りの半径 (正なら光源、負なら暗黒)
+ */
+int calc_monrace_lite_radius(const MonsterRaceInfo &monrace)
+{
+    auto rad = 0;
+    if (monrace.brightness_flags.has_any_of({ MonsterBrightnessType::HAS_LITE_1, MonsterBrightnessType::SELF_LITE_1 })) {
+        rad++;
+    }
+
+    if (monrace.brightness_flags.has_any_of({ MonsterBrightnessType::HAS_LITE_2, MonsterBrightnessType::SELF_LITE_2 })) {
+        rad += 2;
+    }
+
+    if (monrace.brightness_flags.has_any_of({ MonsterBrightnessType::HAS_DARK_1, MonsterBrightnessType::SELF_DARK_1 })) {
+        rad--;
+    }
+
+    if (monrace.brightness_flags.has_any_of({ MonsterBrightnessType::HAS_DARK_2, MonsterBrightnessType::SELF_DARK_2 })) {
+        rad -= 2;
+    }
+
+    return rad;
+}
+
+/*!
+ * @brief モンスター種族の灯りの半径を取得する
+ * @param m_ptr モンスターへの参照ポインタ
+ * @return 灯りの半径 (正なら光源、負なら暗黒)
+ * @details 明暗のフラグはゲーム中に変わらないため、種族毎に一度だけ計算する
+ */
+int get_monrace_lite_radius(const MonsterEntity *m_ptr)
+{
+    static std::vector<std::optional<int>> radii;
+    const auto index = static_cast<size_t>(enum2i(m_ptr->r_idx));
+    if (index >= radii.size()) {
+        radii.resize(index + 1);
+    }
+
+    auto &radius = radii[index];
+    if (!radius) {
+        radius = calc_monrace_lite_radius(m_ptr->get_monrace());
+    }
+
+    return *radius;
+}
+
+/*!
+ * @brief モンスターの灯りの届くプレイヤーの視界内のグリッドを列挙する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param m_idx モンスターID
+ * @param rad 灯りの半径 (1～3)
+ * @param is_dark 暗黒か
+ * @return 灯りの届くグリッドの座標たち
+ * @details モンスターとプレイヤーの位置、灯りの半径と種類及び視界と地形が前回から変わっていなければ前回の結果を返す
+ */
+const std::vector<Pos2D> &calc_monster_lite_cells(PlayerType *player_ptr, MONSTER_IDX m_idx, int rad, bool is_dark)
+{
+    auto &floor = *player_ptr->current_floor_ptr;
+    auto &monster = floor.m_list[m_idx];
+    monster_lite_type tmp_ml;
+    const auto *ml_ptr = initialize_monster_lite_type(floor.grid_array[monster.fy][monster.fx].info, &tmp_ml, &monster);
+    const Pos2D monster_pos(ml_ptr->mon_fy, ml_ptr->mon_fx);
+    const Pos2D player_pos(player_ptr->y, player_ptr->x);
+    if (static_cast<size_t>(m_idx) >= mon_lite_caches.size()) {
+        mon_lite_caches.resize(m_idx + 1);
+    }
+
+    auto &cache = mon_lite_caches[m_idx];
+    auto is_cached = cache.generation == mon_lite_cache_generation;
+    is_cached &= (cache.monster_pos == monster_pos) && (cache.player_pos == player_pos);
+    is_cached &= (cache.radius == rad) && (cache.is_dark == is_dark) && (cache.mon_invis == ml_ptr->mon_invis);
+    if (is_cached) {
+        return cache.cells;
+    }
+
+    cache.generation = mon_lite_cache_generation;
+    cache.monster_pos = monster_pos;
+    cache.player_pos = player_pos;
+    cache.radius = rad;
+    cache.is_dark = is_dark;
+    cache.mon_invis = ml_ptr->mon_invis;
+    cache.cells.clear();
+    const auto f_flag = is_dark ? TerrainCharacteristics::PROJECT : TerrainCharacteristics::LOS;
+    const auto is_lit = is_dark ? is_darkened_by_monster : is_lit_by_monster;
+    for (const auto &stencil : MONSTER_LITE_STENCILS) {
+        if (stencil.radius > rad) {
+            continue;
+        }
+
+        const auto can_reach = std::all_of(stencil.conditions.begin(), stencil.conditions.end(), [&](const auto &vec) {
+            const auto pos = monster_pos + vec;
+            return cave_has_flag_bold(&floor, pos.y, pos.x, f_flag);
+        });
+        if (!can_reach) {
+            continue;
+        }
+
+        for (const auto &vec : stencil.cells) {
+            const auto pos = monster_pos + vec;
+            if (is_lit(player_ptr, pos.y, pos.x, ml_ptr)) {
+                cache.cells.push_back(pos);
+            }
+        }
+    }
+
+    return cache.cells;
+}
 }
 
 /*!
@@ -144,14 +338,16 @@ static void update_monster_dark(
  * The CAVE_TEMP and CAVE_XTRA flag are used to store the state during the
  * updating.  Only squares in view of the player, whos state
  * changes are drawn via lite_spot().
+ * @details 状態の変わりうる座標たちを記録する配列は呼び出しの度に確保し直さずに使い回す.
+ * 各モンスターの灯りの範囲は calc_monster_lite_cells() でキャッシュし、移動したモンスターの分だけ計算し直す.
  * @todo player-status からのみ呼ばれている。しかしあちらは行数が酷いので要調整
  */
 void update_mon_lite(PlayerType *player_ptr)
 {
     // 座標たちを記録する配列。
-    std::vector<Pos2D> points;
+    static std::vector<Pos2D> points;
+    points.clear();
 
-    void (*add_mon_lite)(PlayerType *, std::vector<Pos2D> &, const POSITION, const POSITION, const monster_lite_type *);
     auto *floor_ptr = player_ptr->current_floor_ptr;
     const auto &dungeon = floor_ptr->get_dungeon_definition();
     auto dis_lim = (dungeon.flags.has(DungeonFeatureType::DARKNESS) && !player_ptr->see_nocto) ? (MAX_PLAYER_SIGHT / 2 + 1) : (MAX_PLAYER_SIGHT + 3);
@@ -167,33 +363,17 @@ void update_mon_lite(PlayerType *player_ptr)
         MonsterRaceInfo *r_ptr;
         for (int i = 1; i < floor_ptr->m_max; i++) {
             m_ptr = &floor_ptr->m_list[i];
-            r_ptr = &m_ptr->get_monrace();
             if (!m_ptr->is_valid() || (m_ptr->cdis > dis_lim)) {
                 continue;
             }
 
-            int rad = 0;
-            if (r_ptr->brightness_flags.has_any_of({ MonsterBrightnessType::HAS_LITE_1, MonsterBrightnessType::SELF_LITE_1 })) {
-                rad++;
-            }
-
-            if (r_ptr->brightness_flags.has_any_of({ MonsterBrightnessType::HAS_LITE_2, MonsterBrightnessType::SELF_LITE_2 })) {
-                rad += 2;
-            }
-
-            if (r_ptr->brightness_flags.has_any_of({ MonsterBrightnessType::HAS_DARK_1, MonsterBrightnessType::SELF_DARK_1 })) {
-                rad--;
-            }
-
-            if (r_ptr->brightness_flags.has_any_of({ MonsterBrightnessType::HAS_DARK_2, MonsterBrightnessType::SELF_DARK_2 })) {
-                rad -= 2;
-            }
-
+            auto rad = get_monrace_lite_radius(m_ptr);
             if (!rad) {
                 continue;
             }
 
-            TerrainCharacteristics f_flag;
+            r_ptr = &m_ptr->get_monrace();
+            auto is_dark = false;
             if (rad > 0) {
                 auto should_lite = r_ptr->brightness_flags.has_none_of({ MonsterBrightnessType::SELF_LITE_1, MonsterBrightnessType::SELF_LITE_2 });
                 should_lite &= (m_ptr->is_asleep() || (!floor_ptr->dun_level && w_ptr->is_daytime()) || AngbandSystem::get_instance().is_phase_out());
@@ -204,101 +384,18 @@ void update_mon_lite(PlayerType *player_ptr)
                 if (dungeon.flags.has(DungeonFeatureType::DARKNESS)) {
                     rad = 1;
                 }
-
-                add_mon_lite = update_monster_lite;
-                f_flag = TerrainCharacteristics::LOS;
             } else {
                 if (r_ptr->brightness_flags.has_none_of({ MonsterBrightnessType::SELF_DARK_1, MonsterBrightnessType::SELF_DARK_2 }) && (m_ptr->is_asleep() || (!floor_ptr->dun_level && !w_ptr->is_daytime()))) {
                     continue;
                 }
 
-                add_mon_lite = update_monster_dark;
-                f_flag = TerrainCharacteristics::PROJECT;
+                is_dark = true;
                 rad = -rad;
             }
 
-            monster_lite_type tmp_ml;
-            monster_lite_type *ml_ptr = initialize_monster_lite_type(floor_ptr->grid_array[m_ptr->fy][m_ptr->fx].info, &tmp_ml, m_ptr);
-            add_mon_lite(player_ptr, points, ml_ptr->mon_fy, ml_ptr->mon_fx, ml_ptr);
-            add_mon_lite(player_ptr, points, ml_ptr->mon_fy + 1, ml_ptr->mon_fx, ml_ptr);
-            add_mon_lite(player_ptr, points, ml_ptr->mon_fy - 1, ml_ptr->mon_fx, ml_ptr);
-            add_mon_lite(player_ptr, points, ml_ptr->mon_fy, ml_ptr->mon_fx + 1, ml_ptr);
-            add_mon_lite(player_ptr, points, ml_ptr->mon_fy, ml_ptr->mon_fx - 1, ml_ptr);
-            add_mon_lite(player_ptr, points, ml_ptr->mon_fy + 1, ml_ptr->mon_fx + 1, ml_ptr);
-            add_mon_lite(player_ptr, points, ml_ptr->mon_fy + 1, ml_ptr->mon_fx - 1, ml_ptr);
-            add_mon_lite(player_ptr, points, ml_ptr->mon_fy - 1, ml_ptr->mon_fx + 1, ml_ptr);
-            add_mon_lite(player_ptr, points, ml_ptr->mon_fy - 1, ml_ptr->mon_fx - 1, ml_ptr);
-            if (rad < 2) {
-                continue;
-            }
-
-            Grid *g_ptr;
-            if (cave_has_flag_bold(player_ptr->current_floor_ptr, ml_ptr->mon_fy + 1, ml_ptr->mon_fx, f_flag)) {
-                add_mon_lite(player_ptr, points, ml_ptr->mon_fy + 2, ml_ptr->mon_fx + 1, ml_ptr);
-                add_mon_lite(player_ptr, points, ml_ptr->mon_fy + 2, ml_ptr->mon_fx, ml_ptr);
-                add_mon_lite(player_ptr, points, ml_ptr->mon_fy + 2, ml_ptr->mon_fx - 1, ml_ptr);
-                g_ptr = &floor_ptr->grid_array[ml_ptr->mon_fy + 2][ml_ptr->mon_fx];
-                if ((rad == 3) && g_ptr->cave_has_flag(f_flag)) {
-                    add_mon_lite(player_ptr, points, ml_ptr->mon_fy + 3, ml_ptr->mon_fx + 1, ml_ptr);
-                    add_mon_lite(player_ptr, points, ml_ptr->mon_fy + 3, ml_ptr->mon_fx, ml_ptr);
-                    add_mon_lite(player_ptr, points, ml_ptr->mon_fy + 3, ml_ptr->mon_fx - 1, ml_ptr);
-                }
-            }
-
-            if (cave_has_flag_bold(player_ptr->current_floor_ptr, ml_ptr->mon_fy - 1, ml_ptr->mon_fx, f_flag)) {
-                add_mon_lite(player_ptr, points, ml_ptr->mon_fy - 2, ml_ptr->mon_fx + 1, ml_ptr);
-                add_mon_lite(player_ptr, points, ml_ptr->mon_fy - 2, ml_ptr->mon_fx, ml_ptr);
-                add_mon_lite(player_ptr, points, ml_ptr->mon_fy - 2, ml_ptr->mon_fx - 1, ml_ptr);
-                g_ptr = &floor_ptr->grid_array[ml_ptr->mon_fy - 2][ml_ptr->mon_fx];
-                if ((rad == 3) && g_ptr->cave_has_flag(f_flag)) {
-                    add_mon_lite(player_ptr, points, ml_ptr->mon_fy - 3, ml_ptr->mon_fx + 1, ml_ptr);
-                    add_mon_lite(player_ptr, points, ml_ptr->mon_fy - 3, ml_ptr->mon_fx, ml_ptr);
-                    add_mon_lite(player_ptr, points, ml_ptr->mon_fy - 3, ml_ptr->mon_fx - 1, ml_ptr);
-                }
-            }
-
-            if (cave_has_flag_bold(player_ptr->current_floor_ptr, ml_ptr->mon_fy, ml_ptr->mon_fx + 1, f_flag)) {
-                add_mon_lite(player_ptr, points, ml_ptr->mon_fy + 1, ml_ptr->mon_fx + 2, ml_ptr);
-                add_mon_lite(player_ptr, points, ml_ptr->mon_fy, ml_ptr->mon_fx + 2, ml_ptr);
-                add_mon_lite(player_ptr, points, ml_ptr->mon_fy - 1, ml_ptr->mon_fx + 2, ml_ptr);
-                g_ptr = &floor_ptr->grid_array[ml_ptr->mon_fy][ml_ptr->mon_fx + 2];
-                if ((rad == 3) && g_ptr->cave_has_flag(f_flag)) {
-                    add_mon_lite(player_ptr, points, ml_ptr->mon_fy + 1, ml_ptr->mon_fx + 3, ml_ptr);
-                    add_mon_lite(player_ptr, points, ml_ptr->mon_fy, ml_ptr->mon_fx + 3, ml_ptr);
-                    add_mon_lite(player_ptr, points, ml_ptr->mon_fy - 1, ml_ptr->mon_fx + 3, ml_ptr);
-                }
-            }
-
-            if (cave_has_flag_bold(player_ptr->current_floor_ptr, ml_ptr->mon_fy, ml_ptr->mon_fx - 1, f_flag)) {
-                add_mon_lite(player_ptr, points, ml_ptr->mon_fy + 1, ml_ptr->mon_fx - 2, ml_ptr);
-                add_mon_lite(player_ptr, points, ml_ptr->mon_fy, ml_ptr->mon_fx - 2, ml_ptr);
-                add_mon_lite(player_ptr, points, ml_ptr->mon_fy - 1, ml_ptr->mon_fx - 2, ml_ptr);
-                g_ptr = &floor_ptr->grid_array[ml_ptr->mon_fy][ml_ptr->mon_fx - 2];
-                if ((rad == 3) && g_ptr->cave_has_flag(f_flag)) {
-                    add_mon_lite(player_ptr, points, ml_ptr->mon_fy + 1, ml_ptr->mon_fx - 3, ml_ptr);
-                    add_mon_lite(player_ptr, points, ml_ptr->mon_fy, ml_ptr->mon_fx - 3, ml_ptr);
-                    add_mon_lite(player_ptr, points, ml_ptr->mon_fy - 1, ml_ptr->mon_fx - 3, ml_ptr);
-                }
-            }
-
-            if (rad != 3) {
-                continue;
-            }
-
-            if (cave_has_flag_bold(player_ptr->current_floor_ptr, ml_ptr->mon_fy + 1, ml_ptr->mon_fx + 1, f_flag)) {
-                add_mon_lite(player_ptr, points, ml_ptr->mon_fy + 2, ml_ptr->mon_fx + 2, ml_ptr);
-            }
-
-            if (cave_has_flag_bold(player_ptr->current_floor_ptr, ml_ptr->mon_fy + 1, ml_ptr->mon_fx - 1, f_flag)) {
-                add_mon_lite(player_ptr, points, ml_ptr->mon_fy + 2, ml_ptr->mon_fx - 2, ml_ptr);
-            }
-
-            if (cave_has_flag_bold(player_ptr->current_floor_ptr, ml_ptr->mon_fy - 1, ml_ptr->mon_fx + 1, f_flag)) {
-                add_mon_lite(player_ptr, points, ml_ptr->mon_fy - 2, ml_ptr->mon_fx + 2, ml_ptr);
-            }
-
-            if (cave_has_flag_bold(player_ptr->current_floor_ptr, ml_ptr->mon_fy - 1, ml_ptr->mon_fx - 1, f_flag)) {
-                add_mon_lite(player_ptr, points, ml_ptr->mon_fy - 2, ml_ptr->mon_fx - 2, ml_ptr);
+            const auto add_mon_lite = is_dark ? add_monster_dark : add_monster_lite;
+            for (const auto &pos : calc_monster_lite_cells(player_ptr, i, rad, is_dark)) {
+                add_mon_lite(points, pos, floor_ptr->grid_array[pos.y][pos.x]);
             }
         }
     }
@@ -378,4 +475,20 @@ void clear_mon_lite(FloorType *floor_ptr)
     }
 
     floor_ptr->mon_lite_n = 0;
+    invalidate_mon_lite_cache();
+}
+
+/*!
+ * @brief モンスターの灯りの範囲のキャッシュを破棄する
+ * @details プレイヤーの視界や地形が変わった時に呼ぶ
+ */
+void invalidate_mon_lite_cache()
+{
+    mon_lite_cache_generation++;
+    if (mon_lite_cache_generation == 0) {
+        mon_lite_cache_generation = 1;
+        for (auto &cache : mon_lite_caches) {
+            cache.generation = 0;
+        }
+    }
 }
@@ -4,3 +4,4 @@ class FloorType;
 class PlayerType;
 void update_mon_lite(PlayerType *player_ptr);
 void clear_mon_lite(FloorType *floor_ptr);
+void invalidate_mon_lite_cache();
@@ -56,7 +56,7 @@ bool MonsterSweepGrid::get_movable_grid()
     auto x2 = this->player_ptr->x;
     this->will_run = this->mon_will_run();
     Pos2D pos_monster_from(monster_from.fy, monster_from.fx);
-    const auto no_flow = monster_from.mflag2.has(MonsterConstantFlagType::NOFLOW) && (floor.get_grid(pos_monster_from).get_cost(&monrace) > 2);
+    const auto no_flow = monster_from.mflag2.has(MonsterConstantFlagType::NOFLOW) && (floor.pathing_layer.get_cost(pos_monster_from, &monrace) > 2);
     this->can_pass_wall = monrace.feature_flags.has(MonsterFeatureType::PASS_WALL) && ((this->m_idx != this->player_ptr->riding) || has_pass_wall(this->player_ptr));
     if (!this->will_run && monster_from.target_y) {
         Pos2D pos_target(monster_from.target_y, monster_from.target_x);
@@ -143,13 +143,13 @@ void MonsterSweepGrid::check_hiding_grid(POSITION *y, POSITION *x, POSITION *y2,
     }
 
     if ((!los(this->player_ptr, m_ptr->fy, m_ptr->fx, this->player_ptr->y, this->player_ptr->x) || !projectable(this->player_ptr, m_ptr->fy, m_ptr->fx, this->player_ptr->y, this->player_ptr->x))) {
-        if (floor_ptr->grid_array[m_ptr->fy][m_ptr->fx].get_distance(r_ptr) >= MAX_PLAYER_SIGHT / 2) {
+        if (floor_ptr->pathing_layer.get_distance({ m_ptr->fy, m_ptr->fx }, r_ptr) >= MAX_PLAYER_SIGHT / 2) {
             return;
         }
     }
 
     this->search_room_to_run(y, x);
-    if (this->done || (floor_ptr->grid_array[m_ptr->fy][m_ptr->fx].get_distance(r_ptr) >= 3)) {
+    if (this->done || (floor_ptr->pathing_layer.get_distance({ m_ptr->fy, m_ptr->fx }, r_ptr) >= 3)) {
         return;
     }
 
@@ -262,17 +262,18 @@ void MonsterSweepGrid::sweep_movable_grid(POSITION *yp, POSITION *xp, bool no_fl
     const Pos2D pos(y1, x1);
     const auto &grid = floor.get_grid(pos);
     if (grid.has_los() && projectable(this->player_ptr, this->player_ptr->y, this->player_ptr->x, y1, x1)) {
-        if ((distance(y1, x1, this->player_ptr->y, this->player_ptr->x) == 1) || (monrace.freq_spell > 0) || (grid.get_cost(&monrace) > 5)) {
+        if ((distance(y1, x1, this->player_ptr->y, this->player_ptr->x) == 1) || (monrace.freq_spell > 0) || (floor.pathing_layer.get_cost(pos, &monrace) > 5)) {
             return;
         }
     }
 
     auto use_scent = false;
-    if (grid.get_cost(&monrace)) {
+    const auto when = floor.pathing_layer.get_when(pos);
+    if (floor.pathing_layer.get_cost(pos, &monrace)) {
         this->best = 999;
-    } else if (grid.when) {
+    } else if (when) {
         const auto p_pos = this->player_ptr->get_position();
-        if (floor.get_grid(p_pos).when - grid.when > 127) {
+        if (floor.pathing_layer.get_when(p_pos) - when > 127) {
             return;
         }
 
@@ -325,7 +326,7 @@ bool MonsterSweepGrid::sweep_ranged_attack_grid(POSITION *yp, POSITION *xp)
         return false;
     }
 
-    auto now_cost = (int)floor_ptr->grid_array[y1][x1].get_cost(r_ptr);
+    auto now_cost = (int)floor_ptr->pathing_layer.get_cost({ y1, x1 }, r_ptr);
     if (now_cost == 0) {
         now_cost = 999;
     }
@@ -344,8 +345,7 @@ bool MonsterSweepGrid::sweep_ranged_attack_grid(POSITION *yp, POSITION *xp)
             return false;
         }
 
-        const auto &grid = floor_ptr->get_grid(pos);
-        this->cost = grid.get_cost(r_ptr);
+        this->cost = floor_ptr->pathing_layer.get_cost(pos, r_ptr);
         if (!this->is_best_cost(pos.y, pos.x, now_cost)) {
             continue;
         }
@@ -420,7 +420,7 @@ bool MonsterSweepGrid::sweep_runnable_away_grid(POSITION *yp, POSITION *xp)
         }
 
         auto dis = distance(y, x, y1, x1);
-        auto s = 5000 / (dis + 3) - 500 / (floor_ptr->grid_array[y][x].get_distance(r_ptr) + 1);
+        auto s = 5000 / (dis + 3) - 500 / (floor_ptr->pathing_layer.get_distance({ y, x }, r_ptr) + 1);
         if (s < 0) {
             s = 0;
         }
@@ -453,9 +453,9 @@ void MonsterSweepGrid::determine_when_cost(POSITION *yp, POSITION *xp, POSITION
             continue;
         }
 
-        auto *g_ptr = &floor_ptr->grid_array[y][x];
+        const Pos2D pos(y, x);
         if (use_scent) {
-            int when = g_ptr->when;
+            int when = floor_ptr->pathing_layer.get_when(pos);
             if (this->best > when) {
                 continue;
             }
@@ -463,7 +463,7 @@ void MonsterSweepGrid::determine_when_cost(POSITION *yp, POSITION *xp, POSITION
             this->best = when;
         } else {
             const auto &monrace = floor_ptr->m_list[this->m_idx].get_monrace();
-            this->cost = monrace.behavior_flags.has_any_of({ MonsterBehaviorType::BASH_DOOR, MonsterBehaviorType::OPEN_DOOR }) ? g_ptr->get_distance(&monrace) : g_ptr->get_cost(&monrace);
+            this->cost = monrace.behavior_flags.has_any_of({ MonsterBehaviorType::BASH_DOOR, MonsterBehaviorType::OPEN_DOOR }) ? floor_ptr->pathing_layer.get_distance(pos, &monrace) : floor_ptr->pathing_layer.get_cost(pos, &monrace);
             if ((this->cost == 0) || (this->best < this->cost)) {
                 continue;
             }
@@ -76,6 +76,7 @@ static void compact_monsters_aux(PlayerType *player_ptr, MONSTER_IDX i1, MONSTER
 
     floor_ptr->m_list[i2] = floor_ptr->m_list[i1];
     floor_ptr->m_list[i1] = {};
+    floor_ptr->active_monster_index.invalidate();
 
     for (int i = 0; i < MAX_MTIMED; i++) {
         int mproc_idx = get_mproc_idx(floor_ptr, i1, i);
@@ -40,11 +40,14 @@
 #include "system/player-type-definition.h"
 #include "system/redrawing-flags-updater.h"
 #include "util/bit-flags-calculator.h"
-#include "util/probability-table.h"
+#include "util/fenwick-tree.h"
 #include "view/display-messages.h"
 #include "world/world.h"
+#include <algorithm>
 #include <cmath>
 #include <iterator>
+#include <map>
+#include <tuple>
 
 #define HORDE_NOGOOD 0x01 /*!< (未実装フラグ)HORDE生成でGOODなモンスターの生成を禁止する？ */
 #define HORDE_NOEVIL 0x02 /*!< (未実装フラグ)HORDE生成でEVILなモンスターの生成を禁止する？ */
@@ -62,6 +65,7 @@ MONSTER_IDX m_pop(FloorType *floor_ptr)
         const auto i = floor_ptr->m_max;
         floor_ptr->m_max++;
         floor_ptr->m_cnt++;
+        floor_ptr->active_monster_index.add(i);
         return i;
     }
 
@@ -73,6 +77,7 @@ MONSTER_IDX m_pop(FloorType *floor_ptr)
         }
 
         floor_ptr->m_cnt++;
+        floor_ptr->active_monster_index.add(i);
         return i;
     }
 
@@ -83,6 +88,169 @@ MONSTER_IDX m_pop(FloorType *floor_ptr)
     return 0;
 }
 
+namespace {
+/*!
+ * @brief get_mon_num() の抽選テーブル
+ * @details alloc_race_table は階層順に並んでいるため、生成階の範囲は連続した区間となる.
+ * 区間内の各要素の重み (prob2) をフェニック木で保持し、抽選を O(log n) で行う.
+ * ユニーク等の出現数制限を受ける要素のみを記録しておき、出現数の変化による重みの変化は差分更新する.
+ */
+class MonraceAllocationTable {
+public:
+    MonraceAllocationTable(DEPTH min_level, DEPTH max_level, bool is_restricted, bool is_clone);
+
+    void update(const MonraceList &monraces);
+    int total_prob() const;
+    size_t item_count() const;
+    bool empty() const;
+    int pick_one_at_random() const;
+
+private:
+    int begin_index = 0; //!< 区間の先頭要素の alloc_race_table 上の位置
+    bool is_restricted; //!< 出現数制限を適用するか
+    bool is_clone; //!< クローン生成か (ユニークの出現数制限を適用しない)
+    FenwickTree<int> weights;
+    std::vector<int> limited_indices; //!< 出現数制限を受ける要素の区間内の位置
+    size_t positive_count = 0; //!< 重みが正の要素数
+
+    bool is_allowed(const MonraceList &monraces, int index) const;
+    void set_weight(int index, int weight);
+};
+
+MonraceAllocationTable::MonraceAllocationTable(DEPTH min_level, DEPTH max_level, bool is_restricted, bool is_clone)
+    : is_restricted(is_restricted)
+    , is_clone(is_clone)
+{
+    const auto begin = std::partition_point(alloc_race_table.begin(), alloc_race_table.end(), [min_level](const auto &entry) { return entry.level < min_level; });
+    const auto end = std::partition_point(begin, alloc_race_table.end(), [max_level](const auto &entry) { return entry.level <= max_level; });
+    this->begin_index = static_cast<int>(std::distance(alloc_race_table.begin(), begin));
+    this->weights.assign(std::distance(begin, end));
+
+    const auto &monraces = MonraceList::get_instance();
+    for (auto i = 0; i < static_cast<int>(this->weights.size()); i++) {
+        const auto &entry = alloc_race_table[this->begin_index + i];
+        if (entry.prob2 <= 0) {
+            continue;
+        }
+
+        const auto r_idx = i2enum<MonsterRaceId>(entry.index);
+        const auto &monrace = monraces[r_idx];
+        auto is_limited = monrace.population_flags.has(MonsterPopulationType::ONLY_ONE) || monraces.is_unified(r_idx);
+        is_limited |= !is_clone && (monrace.kind_flags.has(MonsterKindType::UNIQUE) || monrace.population_flags.has(MonsterPopulationType::NAZGUL));
+        if (is_restricted && is_limited) {
+            this->limited_indices.push_back(i);
+            continue;
+        }
+
+        this->set_weight(i, entry.prob2);
+    }
+
+    this->update(monraces);
+}
+
+/*!
+ * @brief 出現数制限を受ける要素の重みを現在の出現数に合わせて更新する
+ * @param monraces モンスター種族一覧への参照
+ */
+void MonraceAllocationTable::update(const MonraceList &monraces)
+{
+    for (const auto i : this->limited_indices) {
+        const auto weight = this->is_allowed(monraces, i) ? alloc_race_table[this->begin_index + i].prob2 : 0;
+        this->set_weight(i, weight);
+    }
+}
+
+int MonraceAllocationTable::total_prob() const
+{
+    return this->weights.total();
+}
+
+size_t MonraceAllocationTable::item_count() const
+{
+    return this->positive_count;
+}
+
+bool MonraceAllocationTable::empty() const
+{
+    return this->positive_count == 0;
+}
+
+/*!
+ * @brief 重みに従って要素を1つ選択する
+ * @return 選択された要素の alloc_race_table 上の位置
+ * @details ProbabilityTable::pick_one_at_random() と同じく乱数を1回消費し、同じ乱数値に対して同じ要素を返す
+ */
+int MonraceAllocationTable::pick_one_at_random() const
+{
+    const auto key = randint0(this->weights.total());
+    return this->begin_index + static_cast<int>(this->weights.find(key));
+}
+
+bool MonraceAllocationTable::is_allowed(const MonraceList &monraces, int index) const
+{
+    const auto r_idx = i2enum<MonsterRaceId>(alloc_race_table[this->begin_index + index].index);
+    const auto &monrace = monraces[r_idx];
+    const auto is_unique = monrace.kind_flags.has(MonsterKindType::UNIQUE) || monrace.population_flags.has(MonsterPopulationType::NAZGUL);
+    if (is_unique && (monrace.cur_num >= monrace.max_num) && !this->is_clone) {
+        return false;
+    }
+
+    if (monrace.population_flags.has(MonsterPopulationType::ONLY_ONE) && (monrace.cur_num >= 1)) {
+        return false;
+    }
+
+    return monraces.is_selectable(r_idx);
+}
+
+void MonraceAllocationTable::set_weight(int index, int weight)
+{
+    const auto prev_weight = this->weights.get(index);
+    if (prev_weight == weight) {
+        return;
+    }
+
+    if (prev_weight == 0) {
+        this->positive_count++;
+    } else if (weight == 0) {
+        this->positive_count--;
+    }
+
+    this->weights.set(index, weight);
+}
+
+/*!
+ * @brief 条件に合う抽選テーブルを取得する
+ * @param min_level 最小生成階
+ * @param max_level 最大生成階
+ * @param mode 生成オプション
+ * @return 抽選テーブルへの参照
+ * @details 抽選テーブルは get_mon_num_prep() 系関数によって重みが変化するまで再利用する.
+ * モンスターの出現数 (cur_num / max_num) は書き換え箇所が多岐にわたるため、取得のたびに出現数制限を受ける要素のみを再判定する.
+ */
+MonraceAllocationTable &get_mon_num_table(DEPTH min_level, DEPTH max_level, BIT_FLAGS mode)
+{
+    using Key = std::tuple<DEPTH, DEPTH, bool, bool>;
+    static std::map<Key, MonraceAllocationTable> tables;
+    static auto revision = get_mon_num_prep_revision();
+    if (revision != get_mon_num_prep_revision()) {
+        tables.clear();
+        revision = get_mon_num_prep_revision();
+    }
+
+    const auto is_restricted = none_bits(mode, PM_ARENA) && !chameleon_change_m_idx;
+    const auto is_clone = any_bits(mode, PM_CLONE);
+    const Key key(min_level, max_level, is_restricted, is_clone);
+    auto it = tables.find(key);
+    if (it == tables.end()) {
+        it = tables.try_emplace(key, min_level, max_level, is_restricted, is_clone).first;
+        return it->second;
+    }
+
+    it->second.update(MonraceList::get_instance());
+    return it->second;
+}
+}
+
 /*!
  * @brief 生成モンスター種族を1種生成テーブルから選択する
  * @param player_ptr プレイヤーへの参照ポインタ
@@ -141,37 +309,7 @@ MonsterRaceId get_mon_num(PlayerType *player_ptr, DEPTH min_level, DEPTH max_lev
         }
     }
 
-    ProbabilityTable<int> prob_table;
-
-    /* Process probabilities */
-    const auto &monraces = MonraceList::get_instance();
-    for (auto i = 0U; i < alloc_race_table.size(); i++) {
-        const auto &entry = alloc_race_table[i];
-        if (entry.level < min_level) {
-            continue;
-        }
-        if (max_level < entry.level) {
-            break;
-        } // sorted by depth array,
-        auto r_idx = i2enum<MonsterRaceId>(entry.index);
-        auto r_ptr = &monraces_info[r_idx];
-        if (none_bits(mode, PM_ARENA) && !chameleon_change_m_idx) {
-            if ((r_ptr->kind_flags.has(MonsterKindType::UNIQUE) || r_ptr->population_flags.has(MonsterPopulationType::NAZGUL)) && (r_ptr->cur_num >= r_ptr->max_num) && none_bits(mode, PM_CLONE)) {
-                continue;
-            }
-
-            if (r_ptr->population_flags.has(MonsterPopulationType::ONLY_ONE) && (r_ptr->cur_num >= 1)) {
-                continue;
-            }
-
-            if (!monraces.is_selectable(r_idx)) {
-                continue;
-            }
-        }
-
-        prob_table.entry_item(i, entry.prob2);
-    }
-
+    auto &prob_table = get_mon_num_table(min_level, max_level, mode);
     if (cheat_hear) {
         msg_format(_("モンスター第3次候補数:%lu(%d-%dF)%d ", "monster third selection:%lu(%d-%dF)%d "), prob_table.item_count(), min_level, max_level,
             prob_table.total_prob());
@@ -193,7 +331,7 @@ MonsterRaceId get_mon_num(PlayerType *player_ptr, DEPTH min_level, DEPTH max_lev
     }
 
     std::vector<int> result;
-    ProbabilityTable<int>::lottery(std::back_inserter(result), prob_table, n);
+    std::generate_n(std::back_inserter(result), n, [&prob_table] { return prob_table.pick_one_at_random(); });
 
     auto it = std::max_element(result.begin(), result.end(), [](int a, int b) { return alloc_race_table[a].level < alloc_race_table[b].level; });
 
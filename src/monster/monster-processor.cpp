@@ -65,6 +65,8 @@
 #include "system/redrawing-flags-updater.h"
 #include "target/projection-path-calculator.h"
 #include "view/display-messages.h"
+#include "world/idle-turn-counter.h"
+#include <optional>
 
 void decide_drop_from_monster(PlayerType *player_ptr, MONSTER_IDX m_idx, bool is_riding_mon);
 bool process_stealth(PlayerType *player_ptr, MONSTER_IDX m_idx);
@@ -79,6 +81,8 @@ bool cast_spell(PlayerType *player_ptr, MONSTER_IDX m_idx, bool aware);
 bool process_monster_fear(PlayerType *player_ptr, turn_flags *turn_flags_ptr, MONSTER_IDX m_idx);
 
 void sweep_monster_process(PlayerType *player_ptr);
+bool sweep_monster(PlayerType *player_ptr, MONSTER_IDX m_idx);
+std::optional<int> calc_monster_energy_gain(PlayerType *player_ptr, MONSTER_IDX m_idx);
 bool decide_process_continue(PlayerType *player_ptr, MonsterEntity *m_ptr);
 
 /*!
@@ -577,6 +581,7 @@ bool process_monster_fear(PlayerType *player_ptr, turn_flags *turn_flags_ptr, MO
  */
 void process_monsters(PlayerType *player_ptr)
 {
+    RngStreamSelector rng_selector(RngStream::MONSTER_AI);
     const auto old_monrace_id = player_ptr->monster_race_idx;
     old_race_flags tmp_flags(old_monrace_id);
     old_race_flags *old_race_flags_ptr = &tmp_flags;
@@ -593,47 +598,158 @@ void process_monsters(PlayerType *player_ptr)
 /*!
  * @brief フロア内のモンスターについてターン終了時の処理を繰り返す
  * @param player_ptr プレイヤーへの参照ポインタ
+ * @details m_list を末尾から走査する代わりに、生存しているモンスターの索引を降順に辿る.
+ * 処理中に索引に載っていない空きスロットへモンスターが置かれた場合は、残りを m_list から直接走査する.
  */
 void sweep_monster_process(PlayerType *player_ptr)
 {
-    auto *floor_ptr = player_ptr->current_floor_ptr;
-    for (MONSTER_IDX i = floor_ptr->m_max - 1; i >= 1; i--) {
-        MonsterEntity *m_ptr;
-        m_ptr = &floor_ptr->m_list[i];
+    auto &floor = *player_ptr->current_floor_ptr;
+    auto &active_monster_index = floor.active_monster_index;
+    active_monster_index.update(floor);
+    const auto &m_idx_list = active_monster_index.get_list();
+    const auto m_max = floor.m_max;
+    for (int n = std::ssize(m_idx_list) - 1; n >= 0; n--) {
+        const auto m_idx = m_idx_list[n];
+        if (m_idx >= m_max) {
+            continue;
+        }
 
-        if (player_ptr->leaving) {
+        if (!sweep_monster(player_ptr, m_idx)) {
             return;
         }
 
-        if (!m_ptr->is_valid() || player_ptr->wild_mode) {
-            continue;
+        if (active_monster_index.is_invalidated()) {
+            for (MONSTER_IDX i = m_idx - 1; i >= 1; i--) {
+                if (!sweep_monster(player_ptr, i)) {
+                    return;
+                }
+            }
+
+            return;
         }
+    }
+
+    active_monster_index.prune(floor);
+}
+
+/*!
+ * @brief モンスター1体についてターン終了時の処理を行う
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param m_idx モンスターのインデックス
+ * @return 後続のモンスターの処理を続けるならtrue
+ */
+bool sweep_monster(PlayerType *player_ptr, MONSTER_IDX m_idx)
+{
+    auto *m_ptr = &player_ptr->current_floor_ptr->m_list[m_idx];
+    if (player_ptr->leaving) {
+        return false;
+    }
+
+    if (!m_ptr->is_valid() || player_ptr->wild_mode) {
+        return true;
+    }
+
+    if (m_ptr->mflag.has(MonsterTemporaryFlagType::BORN)) {
+        m_ptr->mflag.reset(MonsterTemporaryFlagType::BORN);
+        return true;
+    }
+
+    const auto energy_gain = calc_monster_energy_gain(player_ptr, m_idx);
+    if (!energy_gain) {
+        return true;
+    }
+
+    m_ptr->energy_need -= static_cast<ACTION_ENERGY>(*energy_gain);
+    if (m_ptr->energy_need > 0) {
+        return true;
+    }
+
+    m_ptr->energy_need += ENERGY_NEED();
+    hack_m_idx = m_idx;
+    process_monster(player_ptr, m_idx);
+    reset_target(m_ptr);
+    if (player_ptr->no_flowed && one_in_(3)) {
+        m_ptr->mflag2.set(MonsterConstantFlagType::NOFLOW);
+    }
+
+    return player_ptr->playing && !player_ptr->is_dead && !player_ptr->leaving;
+}
 
-        if (m_ptr->mflag.has(MonsterTemporaryFlagType::BORN)) {
-            m_ptr->mflag.reset(MonsterTemporaryFlagType::BORN);
+/*!
+ * @brief モンスターがこのゲームターンに得る行動エネルギーを返す
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param m_idx モンスターのインデックス
+ * @return 行動エネルギー (プレイヤーから遠い等の理由で処理しないモンスターならstd::nullopt)
+ */
+std::optional<int> calc_monster_energy_gain(PlayerType *player_ptr, MONSTER_IDX m_idx)
+{
+    auto *m_ptr = &player_ptr->current_floor_ptr->m_list[m_idx];
+    if ((m_ptr->cdis >= MAX_MONSTER_SENSING) || !decide_process_continue(player_ptr, m_ptr)) {
+        return std::nullopt;
+    }
+
+    byte speed = (player_ptr->riding == m_idx) ? player_ptr->pspeed : m_ptr->get_temporary_speed();
+    return speed_to_energy(speed);
+}
+
+/*!
+ * @brief フロア内のモンスターが誰も行動せずに経過するゲームターン数を数える
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param counter ゲームターン数を数えるカウンタ
+ * @details sweep_monster() が行動エネルギーを減らす以外に何もしない間を数える.
+ * 処理するモンスターか否かの判定は、誰かが行動するかゲーム世界全体の処理が起こるまで変わらない.
+ */
+void count_monster_idle_turns(PlayerType *player_ptr, IdleTurnCounter &counter)
+{
+    if (player_ptr->wild_mode) {
+        return;
+    }
+
+    auto &floor = *player_ptr->current_floor_ptr;
+    floor.active_monster_index.update(floor);
+    for (const auto m_idx : floor.active_monster_index.get_list()) {
+        if (m_idx >= floor.m_max) {
             continue;
         }
 
-        if ((m_ptr->cdis >= MAX_MONSTER_SENSING) || !decide_process_continue(player_ptr, m_ptr)) {
+        const auto &monster = floor.m_list[m_idx];
+        if (!monster.is_valid()) {
             continue;
         }
 
-        byte speed = (player_ptr->riding == i) ? player_ptr->pspeed : m_ptr->get_temporary_speed();
-        m_ptr->energy_need -= speed_to_energy(speed);
-        if (m_ptr->energy_need > 0) {
-            continue;
+        if (monster.mflag.has(MonsterTemporaryFlagType::BORN)) {
+            counter.limit(0);
+            return;
         }
 
-        m_ptr->energy_need += ENERGY_NEED();
-        hack_m_idx = i;
-        process_monster(player_ptr, i);
-        reset_target(m_ptr);
-        if (player_ptr->no_flowed && one_in_(3)) {
-            m_ptr->mflag2.set(MonsterConstantFlagType::NOFLOW);
+        const auto energy_gain = calc_monster_energy_gain(player_ptr, m_idx);
+        if (energy_gain) {
+            counter.add_energy(monster.energy_need, *energy_gain);
         }
+    }
+}
 
-        if (!player_ptr->playing || player_ptr->is_dead || player_ptr->leaving) {
-            return;
+/*!
+ * @brief フロア内のモンスターが誰も行動しないゲームターンを一括で経過させる
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param turns 経過させるゲームターン数 (count_monster_idle_turns() で数えた数以下であること)
+ */
+void skip_monster_idle_turns(PlayerType *player_ptr, int turns)
+{
+    auto &floor = *player_ptr->current_floor_ptr;
+    floor.monster_noise = false;
+    if (player_ptr->wild_mode) {
+        return;
+    }
+
+    for (const auto m_idx : floor.active_monster_index.get_list()) {
+        if ((m_idx >= floor.m_max) || !floor.m_list[m_idx].is_valid()) {
+            continue;
+        }
+
+        const auto energy_gain = calc_monster_energy_gain(player_ptr, m_idx);
+        if (energy_gain) {
+            floor.m_list[m_idx].energy_need -= static_cast<ACTION_ENERGY>(turns * *energy_gain);
         }
     }
 }
@@ -2,6 +2,9 @@
 
 #include "system/angband.h"
 
+class IdleTurnCounter;
 class PlayerType;
 void process_monsters(PlayerType *player_ptr);
 void process_monster(PlayerType *player_ptr, MONSTER_IDX m_idx);
+void count_monster_idle_turns(PlayerType *player_ptr, IdleTurnCounter &counter);
+void skip_monster_idle_turns(PlayerType *player_ptr, int turns);
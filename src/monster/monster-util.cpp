@@ -19,6 +19,7 @@
 #include "system/player-type-definition.h"
 #include "system/terrain-type-definition.h"
 #include "util/bit-flags-calculator.h"
+#include "util/finalizer.h"
 #include "view/display-messages.h"
 #include <algorithm>
 #include <iterator>
@@ -40,6 +41,12 @@ MONSTER_IDX hack_m_idx_ii = 0;
  */
 int chameleon_change_m_idx = 0;
 
+/*!
+ * @brief モンスター生成テーブルの重み (prob2) が変化した回数
+ * @details get_mon_num() の抽選テーブルのキャッシュが有効かどうかの判定に用いる
+ */
+static uint32_t mon_num_prep_revision = 0;
+
 /**
  * @brief モンスターがダンジョンに出現できる条件を満たしているかのフラグ判定関数(AND)
  *
@@ -239,6 +246,7 @@ static errr do_get_mon_num_prep(PlayerType *player_ptr, const monsterrace_hook_t
     DEPTH lev_min = MAX_DEPTH; // 重みが正の要素のうち最小階
     DEPTH lev_max = 0; // 重みが正の要素のうち最大階
     int prob2_total = 0; // 重みの総和
+    auto is_changed = false; // いずれかの要素の重みが前回から変化したか
 
     // モンスター生成テーブルの各要素について重みを修正する。
     const auto &system = AngbandSystem::get_instance();
@@ -246,6 +254,9 @@ static errr do_get_mon_num_prep(PlayerType *player_ptr, const monsterrace_hook_t
         alloc_entry *const entry = &alloc_race_table[i];
         const auto entry_r_idx = i2enum<MonsterRaceId>(entry->index);
         const MonsterRaceInfo *const r_ptr = &monraces_info[entry_r_idx];
+        const auto finalizer = util::make_finalizer([entry, prev_prob2 = entry->prob2, &is_changed] {
+            is_changed |= entry->prob2 != prev_prob2;
+        });
 
         // 生成を禁止する要素は重み 0 とする。
         entry->prob2 = 0;
@@ -324,6 +335,10 @@ static errr do_get_mon_num_prep(PlayerType *player_ptr, const monsterrace_hook_t
         }
     }
 
+    if (is_changed) {
+        mon_num_prep_revision++;
+    }
+
     // チートオプションが有効なら統計情報を出力。
     if (cheat_hear) {
         msg_format(_("モンスター第2次候補数:%d(%d-%dF)%d ", "monster second selection:%d(%d-%dF)%d "), mon_num, lev_min, lev_max, prob2_total);
@@ -358,6 +373,44 @@ errr get_mon_num_prep_bounty(PlayerType *player_ptr)
     return do_get_mon_num_prep(player_ptr, nullptr, nullptr, false, std::nullopt);
 }
 
+/*!
+ * @brief モンスター生成テーブルの重みの版数を取得する
+ * @return get_mon_num_prep() 系関数によって重みが変化するたびに増加する値
+ */
+uint32_t get_mon_num_prep_revision()
+{
+    return mon_num_prep_revision;
+}
+
+/*!
+ * @brief モンスター生成テーブルの重みを取得する
+ * @return alloc_race_table の各要素の重み (prob2)
+ * @details フロアの先行生成のように、生成テーブルを一時的に書き換える処理の前後で退避・復元するために用いる
+ */
+std::vector<PROB> get_mon_num_weights()
+{
+    std::vector<PROB> weights;
+    weights.reserve(alloc_race_table.size());
+    for (const auto &entry : alloc_race_table) {
+        weights.push_back(entry.prob2);
+    }
+
+    return weights;
+}
+
+/*!
+ * @brief モンスター生成テーブルの重みを get_mon_num_weights() で取得したものに戻す
+ * @param weights alloc_race_table の各要素の重み (prob2)
+ */
+void set_mon_num_weights(const std::vector<PROB> &weights)
+{
+    for (size_t i = 0; i < alloc_race_table.size(); i++) {
+        alloc_race_table[i].prob2 = weights[i];
+    }
+
+    mon_num_prep_revision++;
+}
+
 bool is_player(MONSTER_IDX m_idx)
 {
     return m_idx == 0;
@@ -3,6 +3,7 @@
 #include "system/angband.h"
 #include <functional>
 #include <optional>
+#include <vector>
 
 enum class MonsterRaceId : int16_t;
 class PlayerType;
@@ -17,5 +18,8 @@ monsterrace_hook_type get_monster_hook(PlayerType *player_ptr);
 monsterrace_hook_type get_monster_hook2(PlayerType *player_ptr, POSITION y, POSITION x);
 errr get_mon_num_prep(PlayerType *player_ptr, const monsterrace_hook_type &hook1, const monsterrace_hook_type &hook2, std::optional<summon_type> summon_specific_type = std::nullopt);
 errr get_mon_num_prep_bounty(PlayerType *player_ptr);
+uint32_t get_mon_num_prep_revision();
+std::vector<PROB> get_mon_num_weights();
+void set_mon_num_weights(const std::vector<PROB> &weights);
 bool is_player(MONSTER_IDX m_idx);
 bool is_monster(MONSTER_IDX m_idx);
@@ -155,13 +155,11 @@ bool breath_direct(PlayerType *player_ptr, POSITION y1, POSITION x1, POSITION y2
             }
         }
     } else {
-        int grids = 0;
-        POSITION gx[1024], gy[1024];
-        POSITION gm[32];
-        POSITION gm_rad = rad;
-        breath_shape(player_ptr, grid_g, path_n, &grids, gx, gy, gm, &gm_rad, rad, y1, x1, y, x, typ);
-        for (auto i = 0; i < grids; i++) {
-            const Pos2D pos(gy[i], gx[i]);
+        // 判定の度にメモリを確保しないよう、効果範囲は使い回す.
+        static thread_local ProjectionArea area;
+        area.clear();
+        breath_shape(player_ptr, grid_g, path_n, area, rad, y1, x1, y, x, typ);
+        for (const auto &pos : area.positions) {
             if ((pos.y == y2) && (pos.x == x2)) {
                 hit2 = true;
             }
@@ -12,6 +12,7 @@
 #include "object-enchant/object-curse.h"
 #include "object-enchant/special-object-flags.h"
 #include "player/player-status-flags.h"
+#include "system/angband-system.h"
 #include "system/artifact-type-definition.h"
 #include "system/baseitem-info.h"
 #include "system/dungeon-info.h"
@@ -49,6 +50,7 @@ ItemMagicApplier::ItemMagicApplier(PlayerType *player_ptr, ItemEntity *o_ptr, DE
  */
 void ItemMagicApplier::execute()
 {
+    RngStreamSelector rng_selector(RngStream::ITEM_GENERATION);
     auto [chance_good, chance_great] = this->calculate_chances();
     auto power = this->calculate_power(chance_good, chance_great);
     auto rolls = this->calculate_rolls(power);
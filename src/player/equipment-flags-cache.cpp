@@ -0,0 +1,102 @@
+#include "player/equipment-flags-cache.h"
+#include "player/player-status-flags.h"
+#include "util/bit-flags-calculator.h"
+#include "util/enum-converter.h"
+#include <iterator>
+#include <vector>
+
+EquipmentFlagsCache::Key::Key(const ItemEntity &item)
+    : bi_id(item.bi_id)
+    , fa_id(item.fa_id)
+    , ego_idx(item.ego_idx)
+    , is_fuel_empty(item.fuel == 0)
+    , art_flags(item.art_flags)
+    , smith_effect(item.smith_effect)
+    , smith_act_idx(item.smith_act_idx)
+{
+}
+
+bool EquipmentFlagsCache::Key::matches(const ItemEntity &item) const
+{
+    auto is_same = this->bi_id == item.bi_id;
+    is_same &= this->fa_id == item.fa_id;
+    is_same &= this->ego_idx == item.ego_idx;
+    is_same &= this->is_fuel_empty == (item.fuel == 0);
+    is_same &= this->smith_effect == item.smith_effect;
+    is_same &= this->smith_act_idx == item.smith_act_idx;
+    return is_same && (this->art_flags == item.art_flags);
+}
+
+/*!
+ * @brief 装備品の特性フラグを取得する
+ * @param item 装備品
+ * @param slot 装備スロット (INVEN_MAIN_HAND～INVEN_FEET)
+ * @return item.get_flags() と同じ特性フラグ
+ */
+const TrFlags &EquipmentFlagsCache::get_flags(const ItemEntity &item, int slot)
+{
+    if (this->update(item, slot)) {
+        this->is_cause_flags_valid = false;
+    }
+
+    return this->entries[slot - INVEN_MAIN_HAND].flags;
+}
+
+/*!
+ * @brief 所定の特性フラグを持つ装備スロットの集合を取得する
+ * @param inventory_list 装備品を含む所持品の配列
+ * @param tr_flag 特性フラグ
+ * @return tr_flag を持つ装備スロットに対応する flag_cause の集合
+ */
+BIT_FLAGS EquipmentFlagsCache::get_cause_flags(const ItemEntity *inventory_list, tr_type tr_flag)
+{
+    for (auto i = 0; i < INVEN_TOTAL - INVEN_MAIN_HAND; i++) {
+        if (this->update(inventory_list[INVEN_MAIN_HAND + i], INVEN_MAIN_HAND + i)) {
+            this->is_cause_flags_valid = false;
+        }
+    }
+
+    if (!this->is_cause_flags_valid) {
+        this->rebuild_cause_flags();
+    }
+
+    return this->cause_flags[tr_flag];
+}
+
+/*!
+ * @brief 装備スロットのキャッシュが古ければ特性フラグを計算し直す
+ * @param item 装備品
+ * @param slot 装備スロット
+ * @return 計算し直したか
+ */
+bool EquipmentFlagsCache::update(const ItemEntity &item, int slot)
+{
+    auto &entry = this->entries[slot - INVEN_MAIN_HAND];
+    if (entry.key && entry.key->matches(item)) {
+        return false;
+    }
+
+    entry.flags = item.get_flags();
+    entry.key = Key(item);
+    return true;
+}
+
+void EquipmentFlagsCache::rebuild_cause_flags()
+{
+    this->cause_flags.fill(0);
+    for (auto i = 0; i < INVEN_TOTAL - INVEN_MAIN_HAND; i++) {
+        const auto &entry = this->entries[i];
+        if (entry.key->bi_id == 0) {
+            continue;
+        }
+
+        const auto flag_cause = convert_inventory_slot_type_to_flag_cause(INVEN_MAIN_HAND + i);
+        std::vector<tr_type> tr_flags;
+        TrFlags::get_flags(entry.flags, std::back_inserter(tr_flags));
+        for (const auto tr_flag : tr_flags) {
+            set_bits(this->cause_flags[tr_flag], flag_cause);
+        }
+    }
+
+    this->is_cause_flags_valid = true;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "inventory/inventory-slot-types.h"
+#include "object-enchant/tr-flags.h"
+#include "system/angband.h"
+#include "system/item-entity.h"
+#include <array>
+#include <optional>
+
+/*!
+ * @brief 装備品の特性フラグのキャッシュ
+ * @details 装備スロット毎に ItemEntity::get_flags() の結果を保持し、
+ * 特性フラグ毎にそれを持つ装備スロット (flag_cause) の集合もあわせて保持する.
+ * 各スロットには get_flags() の結果を左右するアイテムの情報 (ベースアイテム、アーティファクト、エゴ、
+ * 追加特性フラグ、鍛冶の効果及び光源の燃料切れ) を控えておき、参照の都度それと比較して
+ * 装備の入れ替えや呪い・鍛冶による変化を検出したスロットだけを再計算する.
+ * ItemEntity::get_flags() の結果を左右する情報を増やした場合は Key にも加えること.
+ */
+class EquipmentFlagsCache {
+public:
+    EquipmentFlagsCache() = default;
+
+    const TrFlags &get_flags(const ItemEntity &item, int slot);
+    BIT_FLAGS get_cause_flags(const ItemEntity *inventory_list, tr_type tr_flag);
+
+private:
+    /*!
+     * @brief 特性フラグの計算に用いたアイテムの情報
+     */
+    struct Key {
+        short bi_id = 0;
+        FixedArtifactId fa_id{};
+        EgoType ego_idx{};
+        bool is_fuel_empty = false;
+        TrFlags art_flags{};
+        std::optional<SmithEffectType> smith_effect;
+        std::optional<RandomArtActType> smith_act_idx;
+
+        Key(const ItemEntity &item);
+        bool matches(const ItemEntity &item) const;
+    };
+
+    /*!
+     * @brief 装備スロット毎のキャッシュの要素
+     */
+    struct Entry {
+        std::optional<Key> key; //!< 未計算ならstd::nullopt
+        TrFlags flags{};
+    };
+
+    std::array<Entry, INVEN_TOTAL - INVEN_MAIN_HAND> entries{};
+    std::array<BIT_FLAGS, TR_FLAG_MAX> cause_flags{};
+    bool is_cause_flags_valid = false;
+
+    bool update(const ItemEntity &item, int slot);
+    void rebuild_cause_flags();
+};
@@ -26,6 +26,7 @@
 #include "player-status/player-stealth.h"
 #include "player/attack-defense-types.h"
 #include "player/digestion-processor.h"
+#include "player/equipment-flags-cache.h"
 #include "player/player-skill.h"
 #include "player/player-status.h"
 #include "player/race-info-table.h"
@@ -113,24 +114,11 @@ BIT_FLAGS convert_inventory_slot_type_to_flag_cause(inventory_slot_type inventor
 
 /*!
  * @brief 装備による所定の特性フラグを得ているかを一括して取得する関数。
+ * @details 装備品の特性フラグはキャッシュから引き、装備が変わったスロットだけ計算し直す.
  */
 BIT_FLAGS check_equipment_flags(PlayerType *player_ptr, tr_type tr_flag)
 {
-    ItemEntity *o_ptr;
-    BIT_FLAGS result = 0L;
-    for (int i = INVEN_MAIN_HAND; i < INVEN_TOTAL; i++) {
-        o_ptr = &player_ptr->inventory_list[i];
-        if (!o_ptr->is_valid()) {
-            continue;
-        }
-
-        const auto flags = o_ptr->get_flags();
-
-        if (flags.has(tr_flag)) {
-            set_bits(result, convert_inventory_slot_type_to_flag_cause(i2enum<inventory_slot_type>(i)));
-        }
-    }
-    return result;
+    return player_ptr->equipment_flags()->get_cause_flags(player_ptr->inventory_list.get(), tr_flag);
 }
 
 BIT_FLAGS player_flags_brand_pois(PlayerType *player_ptr)
@@ -792,7 +780,7 @@ BIT_FLAGS has_warning(PlayerType *player_ptr)
             continue;
         }
 
-        const auto flags = o_ptr->get_flags();
+        const auto &flags = player_ptr->equipment_flags()->get_flags(*o_ptr, i);
 
         if (flags.has(TR_WARNING)) {
             if (!o_ptr->is_inscribed() || !angband_strchr(o_ptr->inscription->data(), '$')) {
@@ -1058,7 +1046,7 @@ void update_curses(PlayerType *player_ptr)
         if (!o_ptr->is_valid()) {
             continue;
         }
-        const auto flags = o_ptr->get_flags();
+        const auto &flags = player_ptr->equipment_flags()->get_flags(*o_ptr, i);
         if (flags.has(TR_AGGRAVATE)) {
             player_ptr->cursed.set(CurseTraitType::AGGRAVATE);
         }
@@ -1169,7 +1157,7 @@ void update_extra_blows(PlayerType *player_ptr)
             continue;
         }
 
-        const auto flags = o_ptr->get_flags();
+        const auto &flags = player_ptr->equipment_flags()->get_flags(*o_ptr, i);
         if (flags.has(TR_BLOWS)) {
             if ((i == INVEN_MAIN_HAND || i == INVEN_MAIN_RING) && !two_handed) {
                 player_ptr->extra_blows[0] += o_ptr->pval;
@@ -1472,7 +1460,7 @@ BIT_FLAGS has_vuln_curse(PlayerType *player_ptr)
             continue;
         }
 
-        const auto flags = o_ptr->get_flags();
+        const auto &flags = player_ptr->equipment_flags()->get_flags(*o_ptr, i);
 
         if (flags.has(TR_VUL_CURSE) || o_ptr->curse_flags.has(CurseTraitType::VUL_CURSE)) {
             set_bits(result, convert_inventory_slot_type_to_flag_cause(i2enum<inventory_slot_type>(i)));
@@ -1497,7 +1485,7 @@ BIT_FLAGS has_heavy_vuln_curse(PlayerType *player_ptr)
             continue;
         }
 
-        const auto flags = o_ptr->get_flags();
+        const auto &flags = player_ptr->equipment_flags()->get_flags(*o_ptr, i);
 
         if ((flags.has(TR_VUL_CURSE) || o_ptr->curse_flags.has(CurseTraitType::VUL_CURSE)) && o_ptr->curse_flags.has(CurseTraitType::HEAVY_CURSE)) {
             set_bits(result, convert_inventory_slot_type_to_flag_cause(i2enum<inventory_slot_type>(i)));
@@ -1714,7 +1702,7 @@ bool has_disable_two_handed_bonus(PlayerType *player_ptr, int i)
 bool is_wielding_icky_weapon(PlayerType *player_ptr, int i)
 {
     const auto *o_ptr = &player_ptr->inventory_list[INVEN_MAIN_HAND + i];
-    const auto flags = o_ptr->get_flags();
+    const auto &flags = player_ptr->equipment_flags()->get_flags(*o_ptr, INVEN_MAIN_HAND + i);
 
     const auto tval = o_ptr->bi_key.tval();
     const auto has_no_weapon = (tval == ItemKindType::NONE) || (tval == ItemKindType::SHIELD);
@@ -1742,7 +1730,7 @@ bool is_wielding_icky_weapon(PlayerType *player_ptr, int i)
 bool is_wielding_icky_riding_weapon(PlayerType *player_ptr, int i)
 {
     const auto *o_ptr = &player_ptr->inventory_list[INVEN_MAIN_HAND + i];
-    const auto flags = o_ptr->get_flags();
+    const auto &flags = player_ptr->equipment_flags()->get_flags(*o_ptr, INVEN_MAIN_HAND + i);
     const auto tval = o_ptr->bi_key.tval();
     const auto has_no_weapon = (tval == ItemKindType::NONE) || (tval == ItemKindType::SHIELD);
     const auto is_suitable = o_ptr->is_lance() || flags.has(TR_RIDING);
@@ -69,6 +69,7 @@
 #include "player-status/player-stealth.h"
 #include "player/attack-defense-types.h"
 #include "player/digestion-processor.h"
+#include "player/equipment-flags-cache.h"
 #include "player/patron.h"
 #include "player/player-damage.h"
 #include "player/player-move.h"
@@ -95,6 +96,7 @@
 #include "status/base-status.h"
 #include "sv-definition/sv-lite-types.h"
 #include "sv-definition/sv-weapon-types.h"
+#include "system/angband-exceptions.h"
 #include "system/dungeon-info.h"
 #include "system/floor-type-definition.h"
 #include "system/grid-type-definition.h"
@@ -108,9 +110,13 @@
 #include "timed-effect/timed-effects.h"
 #include "util/bit-flags-calculator.h"
 #include "util/enum-converter.h"
+#include "util/enum-range.h"
 #include "util/string-processor.h"
 #include "view/display-messages.h"
 #include "world/world.h"
+#include <array>
+#include <map>
+#include <tuple>
 
 static const int extra_magic_glove_reduce_mana = 1;
 
@@ -226,56 +232,88 @@ static void update_ability_scores(PlayerType *player_ptr)
     }
 }
 
+namespace {
 /*!
- * @brief プレイヤーの全ステータスを更新する /
- * Calculate the players current "state", taking into account
- * not only race/class intrinsics, but also objects being worn
- * and temporary spell effects.
- * @details
- * <pre>
- * See also update_max_mana() and update_max_hitpoints().
- *
- * Take note of the new "speed code", in particular, a very strong
- * player will start slowing down as soon as he reaches 150 pounds,
- * but not until he reaches 450 pounds will he be half as fast as
- * a normal kobold.  This both hurts and helps the player, hurts
- * because in the old days a player could just avoid 300 pounds,
- * and helps because now carrying 300 pounds is not very painful.
- *
- * The "weapon" and "bow" do *not* add to the bonuses to hit or to
- * damage, since that would affect non-combat things.  These values
- * are actually added in later, at the appropriate place.
- *
- * This function induces various "status" messages.
- * </pre>
- * @todo ここで計算していた各値は一部の状態変化メッセージ処理を除き、今後必要な時に適示計算する形に移行するためほぼすべて削られる。
+ * @brief 能力値修正の区分 (update_bonuses() で計算する順)
+ * @details 後の区分の計算は前の区分の計算結果を参照しうるため、
+ * ある区分の計算結果が変わった場合はそれより後の区分を全て再計算する.
  */
-static void update_bonuses(PlayerType *player_ptr)
+enum class PlayerBonusType {
+    FLAGS, /*!< 装備・種族・職業等による特性 */
+    ABILITY_SCORES, /*!< 能力値 */
+    WEAPONS, /*!< 武器・射撃武器の扱い */
+    SPEED, /*!< 加速 */
+    SKILLS, /*!< 技能 */
+    HIT_AND_DAMAGE, /*!< 命中・ダメージ修正 */
+    AC, /*!< AC */
+    MAX,
+};
+
+/*!
+ * @brief 能力値修正の再計算の要因と、それに依存する能力値修正の区分の対応表
+ * @details BONUS はあらゆる入力の変化を表し、全ての区分を再計算する.
+ */
+const std::map<StatusRecalculatingFlag, EnumClassFlagGroup<PlayerBonusType>> BONUS_DEPENDENCIES = {
+    { StatusRecalculatingFlag::BONUS, EnumClassFlagGroup<PlayerBonusType>(EnumRange(PlayerBonusType::FLAGS, PlayerBonusType::AC)) },
+    { StatusRecalculatingFlag::SKILL_EXP, { PlayerBonusType::WEAPONS, PlayerBonusType::SPEED, PlayerBonusType::HIT_AND_DAMAGE, PlayerBonusType::AC } },
+};
+
+auto get_flag_bonuses(const PlayerType *player_ptr)
 {
-    auto empty_hands_status = empty_hands(player_ptr, true);
-    ItemEntity *o_ptr;
+    const auto *p = player_ptr;
+    return std::make_tuple(p->xtra_might, p->esp_evil, p->esp_animal, p->esp_undead, p->esp_demon, p->esp_orc, p->esp_troll, p->esp_giant,
+        p->esp_dragon, p->esp_human, p->esp_good, p->esp_nonliving, p->esp_unique, p->telepathy, p->bless_blade, p->easy_2weapon,
+        p->down_saving, p->yoiyami, p->mighty_throw, p->dec_mana, p->see_nocto, p->warning, p->anti_magic, p->anti_tele, p->easy_spell,
+        p->hard_spell, p->hold_exp, p->see_inv, p->free_act, p->levitation, p->can_swim, p->slow_digest, p->regenerate, p->cursed,
+        p->cursed_special, p->impact, p->earthquake, std::to_array(p->extra_blows), p->lite);
+}
 
-    /* Save the old vision stuff */
-    BIT_FLAGS old_telepathy = player_ptr->telepathy;
-    BIT_FLAGS old_esp_animal = player_ptr->esp_animal;
-    BIT_FLAGS old_esp_undead = player_ptr->esp_undead;
-    BIT_FLAGS old_esp_demon = player_ptr->esp_demon;
-    BIT_FLAGS old_esp_orc = player_ptr->esp_orc;
-    BIT_FLAGS old_esp_troll = player_ptr->esp_troll;
-    BIT_FLAGS old_esp_giant = player_ptr->esp_giant;
-    BIT_FLAGS old_esp_dragon = player_ptr->esp_dragon;
-    BIT_FLAGS old_esp_human = player_ptr->esp_human;
-    BIT_FLAGS old_esp_evil = player_ptr->esp_evil;
-    BIT_FLAGS old_esp_good = player_ptr->esp_good;
-    BIT_FLAGS old_esp_nonliving = player_ptr->esp_nonliving;
-    BIT_FLAGS old_esp_unique = player_ptr->esp_unique;
-    BIT_FLAGS old_see_inv = player_ptr->see_inv;
-    BIT_FLAGS old_mighty_throw = player_ptr->mighty_throw;
-    int16_t old_speed = player_ptr->pspeed;
+auto get_ability_score_bonuses(const PlayerType *player_ptr)
+{
+    return std::make_tuple(std::to_array(player_ptr->stat_add), std::to_array(player_ptr->stat_top), std::to_array(player_ptr->stat_use),
+        std::to_array(player_ptr->stat_index));
+}
 
-    ARMOUR_CLASS old_dis_ac = player_ptr->dis_ac;
-    ARMOUR_CLASS old_dis_to_a = player_ptr->dis_to_a;
+auto get_weapon_bonuses(const PlayerType *player_ptr)
+{
+    const auto *p = player_ptr;
+    return std::make_tuple(p->tval_ammo, p->num_fire, std::to_array(p->is_icky_wield), std::to_array(p->is_icky_riding_wield),
+        std::to_array(p->heavy_wield), std::to_array(p->num_blow), std::to_array(p->to_dd), std::to_array(p->to_ds));
+}
+
+auto get_speed_bonuses(const PlayerType *player_ptr)
+{
+    return std::make_tuple(player_ptr->pspeed);
+}
+
+auto get_skill_bonuses(const PlayerType *player_ptr)
+{
+    const auto *p = player_ptr;
+    return std::make_tuple(p->see_infra, p->skill_stl, p->skill_dis, p->skill_dev, p->skill_sav, p->skill_srh, p->skill_fos, p->skill_thn,
+        p->skill_thb, p->skill_tht, p->riding_ryoute, p->skill_dig, p->to_m_chance);
+}
+
+auto get_hit_and_damage_bonuses(const PlayerType *player_ptr)
+{
+    const auto *p = player_ptr;
+    return std::make_tuple(std::to_array(p->to_d), std::to_array(p->dis_to_d), std::to_array(p->to_h), std::to_array(p->dis_to_h), p->to_h_b,
+        p->dis_to_h_b, p->to_d_m, p->to_h_m);
+}
+
+auto get_ac_bonuses(const PlayerType *player_ptr)
+{
+    return std::make_tuple(player_ptr->ac, player_ptr->to_a, player_ptr->dis_ac, player_ptr->dis_to_a);
+}
+
+auto get_all_bonuses(const PlayerType *player_ptr)
+{
+    return std::make_tuple(get_flag_bonuses(player_ptr), get_ability_score_bonuses(player_ptr), get_weapon_bonuses(player_ptr),
+        get_speed_bonuses(player_ptr), get_skill_bonuses(player_ptr), get_hit_and_damage_bonuses(player_ptr), get_ac_bonuses(player_ptr));
+}
+}
 
+static void update_flag_bonuses(PlayerType *player_ptr)
+{
     player_ptr->xtra_might = has_xtra_might(player_ptr);
     player_ptr->esp_evil = has_esp_evil(player_ptr);
     player_ptr->esp_animal = has_esp_animal(player_ptr);
@@ -317,13 +355,15 @@ static void update_bonuses(PlayerType *player_ptr)
     player_ptr->lite = has_lite(player_ptr);
 
     if (!PlayerClass(player_ptr).monk_stance_is(MonkStanceType::NONE)) {
-        if (none_bits(empty_hands_status, EMPTY_HAND_MAIN)) {
+        if (none_bits(empty_hands(player_ptr, true), EMPTY_HAND_MAIN)) {
             set_action(player_ptr, ACTION_NONE);
         }
     }
+}
 
-    update_ability_scores(player_ptr);
-    o_ptr = &player_ptr->inventory_list[INVEN_BOW];
+static void update_weapon_bonuses(PlayerType *player_ptr)
+{
+    const auto *o_ptr = &player_ptr->inventory_list[INVEN_BOW];
     if (o_ptr->is_valid()) {
         player_ptr->tval_ammo = o_ptr->get_arrow_kind();
         player_ptr->num_fire = calc_num_fire(player_ptr, o_ptr);
@@ -337,8 +377,15 @@ static void update_bonuses(PlayerType *player_ptr)
         player_ptr->to_dd[i] = calc_to_weapon_dice_num(player_ptr, INVEN_MAIN_HAND + i);
         player_ptr->to_ds[i] = 0;
     }
+}
 
+static void update_speed_bonuses(PlayerType *player_ptr)
+{
     player_ptr->pspeed = PlayerSpeed(player_ptr).get_value();
+}
+
+static void update_skill_bonuses(PlayerType *player_ptr)
+{
     player_ptr->see_infra = PlayerInfravision(player_ptr).get_value();
     player_ptr->skill_stl = PlayerStealth(player_ptr).get_value();
     player_ptr->skill_dis = calc_disarming(player_ptr);
@@ -350,6 +397,12 @@ static void update_bonuses(PlayerType *player_ptr)
     player_ptr->skill_thb = calc_to_hit_shoot(player_ptr);
     player_ptr->skill_tht = calc_to_hit_throw(player_ptr);
     player_ptr->riding_ryoute = is_riding_two_hands(player_ptr);
+    player_ptr->skill_dig = calc_skill_dig(player_ptr);
+    player_ptr->to_m_chance = calc_to_magic_chance(player_ptr);
+}
+
+static void update_hit_and_damage_bonuses(PlayerType *player_ptr)
+{
     player_ptr->to_d[0] = calc_to_damage(player_ptr, INVEN_MAIN_HAND, true);
     player_ptr->to_d[1] = calc_to_damage(player_ptr, INVEN_SUB_HAND, true);
     player_ptr->dis_to_d[0] = calc_to_damage(player_ptr, INVEN_MAIN_HAND, false);
@@ -362,12 +415,125 @@ static void update_bonuses(PlayerType *player_ptr)
     player_ptr->dis_to_h_b = calc_to_hit_bow(player_ptr, false);
     player_ptr->to_d_m = calc_to_damage_misc(player_ptr);
     player_ptr->to_h_m = calc_to_hit_misc(player_ptr);
-    player_ptr->skill_dig = calc_skill_dig(player_ptr);
-    player_ptr->to_m_chance = calc_to_magic_chance(player_ptr);
+}
+
+static void update_ac_bonuses(PlayerType *player_ptr)
+{
     player_ptr->ac = calc_base_ac(player_ptr);
     player_ptr->to_a = calc_to_ac(player_ptr, true);
     player_ptr->dis_ac = calc_base_ac(player_ptr);
     player_ptr->dis_to_a = calc_to_ac(player_ptr, false);
+}
+
+/*!
+ * @brief 能力値修正の区分を1つ計算し直す
+ * @param update 計算処理
+ * @param get_bonuses 計算結果を取得する処理
+ * @return 計算結果が変わったか
+ */
+template <typename Update, typename GetBonuses>
+static bool recalculate_bonuses(PlayerType *player_ptr, Update update, GetBonuses get_bonuses)
+{
+    const auto old_bonuses = get_bonuses(player_ptr);
+    update(player_ptr);
+    return get_bonuses(player_ptr) != old_bonuses;
+}
+
+/*!
+ * @brief 能力値修正のうち、再計算が必要な区分だけを計算し直す
+ * @param types 再計算が必要な区分 (計算結果が変わった区分より後の区分を追加する)
+ */
+static void recalculate_bonuses(PlayerType *player_ptr, EnumClassFlagGroup<PlayerBonusType> &types)
+{
+    const auto recalculate = [player_ptr, &types](PlayerBonusType type, auto update, auto get_bonuses) {
+        if (types.has_not(type) || !recalculate_bonuses(player_ptr, update, get_bonuses)) {
+            return;
+        }
+
+        for (auto later_type = static_cast<int>(type) + 1; later_type < enum2i(PlayerBonusType::MAX); later_type++) {
+            types.set(i2enum<PlayerBonusType>(later_type));
+        }
+    };
+
+    recalculate(PlayerBonusType::FLAGS, update_flag_bonuses, get_flag_bonuses);
+    recalculate(PlayerBonusType::ABILITY_SCORES, update_ability_scores, get_ability_score_bonuses);
+    recalculate(PlayerBonusType::WEAPONS, update_weapon_bonuses, get_weapon_bonuses);
+    recalculate(PlayerBonusType::SPEED, update_speed_bonuses, get_speed_bonuses);
+    recalculate(PlayerBonusType::SKILLS, update_skill_bonuses, get_skill_bonuses);
+    recalculate(PlayerBonusType::HIT_AND_DAMAGE, update_hit_and_damage_bonuses, get_hit_and_damage_bonuses);
+    recalculate(PlayerBonusType::AC, update_ac_bonuses, get_ac_bonuses);
+}
+
+/*!
+ * @brief 部分的に再計算した能力値修正が、全てを再計算した結果と一致することを検証する (デバッグモード用)
+ */
+static void verify_bonuses(PlayerType *player_ptr)
+{
+    const auto bonuses = get_all_bonuses(player_ptr);
+    auto types = BONUS_DEPENDENCIES.at(StatusRecalculatingFlag::BONUS);
+    recalculate_bonuses(player_ptr, types);
+    if (get_all_bonuses(player_ptr) != bonuses) {
+        THROW_EXCEPTION(std::logic_error, "Partially recalculated player bonuses differ from fully recalculated ones!");
+    }
+}
+
+/*!
+ * @brief プレイヤーの全ステータスを更新する /
+ * Calculate the players current "state", taking into account
+ * not only race/class intrinsics, but also objects being worn
+ * and temporary spell effects.
+ * @details
+ * <pre>
+ * See also update_max_mana() and update_max_hitpoints().
+ *
+ * Take note of the new "speed code", in particular, a very strong
+ * player will start slowing down as soon as he reaches 150 pounds,
+ * but not until he reaches 450 pounds will he be half as fast as
+ * a normal kobold.  This both hurts and helps the player, hurts
+ * because in the old days a player could just avoid 300 pounds,
+ * and helps because now carrying 300 pounds is not very painful.
+ *
+ * The "weapon" and "bow" do *not* add to the bonuses to hit or to
+ * damage, since that would affect non-combat things.  These values
+ * are actually added in later, at the appropriate place.
+ *
+ * This function induces various "status" messages.
+ * </pre>
+ * 再計算の要因 (StatusRecalculatingFlag) に依存する区分だけを計算し直し、
+ * その結果が変わった場合は後の区分も計算し直す.
+ * デバッグモードでは部分的に再計算した結果を、全てを再計算した結果と照合する.
+ * @param types 再計算する能力値修正の区分
+ * @todo ここで計算していた各値は一部の状態変化メッセージ処理を除き、今後必要な時に適示計算する形に移行するためほぼすべて削られる。
+ */
+static void update_bonuses(PlayerType *player_ptr, EnumClassFlagGroup<PlayerBonusType> types)
+{
+    /* Save the old vision stuff */
+    BIT_FLAGS old_telepathy = player_ptr->telepathy;
+    BIT_FLAGS old_esp_animal = player_ptr->esp_animal;
+    BIT_FLAGS old_esp_undead = player_ptr->esp_undead;
+    BIT_FLAGS old_esp_demon = player_ptr->esp_demon;
+    BIT_FLAGS old_esp_orc = player_ptr->esp_orc;
+    BIT_FLAGS old_esp_troll = player_ptr->esp_troll;
+    BIT_FLAGS old_esp_giant = player_ptr->esp_giant;
+    BIT_FLAGS old_esp_dragon = player_ptr->esp_dragon;
+    BIT_FLAGS old_esp_human = player_ptr->esp_human;
+    BIT_FLAGS old_esp_evil = player_ptr->esp_evil;
+    BIT_FLAGS old_esp_good = player_ptr->esp_good;
+    BIT_FLAGS old_esp_nonliving = player_ptr->esp_nonliving;
+    BIT_FLAGS old_esp_unique = player_ptr->esp_unique;
+    BIT_FLAGS old_see_inv = player_ptr->see_inv;
+    BIT_FLAGS old_mighty_throw = player_ptr->mighty_throw;
+    int16_t old_speed = player_ptr->pspeed;
+
+    ARMOUR_CLASS old_dis_ac = player_ptr->dis_ac;
+    ARMOUR_CLASS old_dis_to_a = player_ptr->dis_to_a;
+
+    const auto is_partial = !types.has_all_of(BONUS_DEPENDENCIES.at(StatusRecalculatingFlag::BONUS));
+    recalculate_bonuses(player_ptr, types);
+    if (w_ptr->wizard && is_partial) {
+        verify_bonuses(player_ptr);
+    }
+
 
     auto &rfu = RedrawingFlagsUpdater::get_instance();
     if (old_mighty_throw != player_ptr->mighty_throw) {
@@ -829,7 +995,7 @@ static void update_max_mana(PlayerType *player_ptr)
     if (any_bits(mp_ptr->spell_xtra, extra_magic_glove_reduce_mana)) {
         player_ptr->cumber_glove = false;
         const auto *o_ptr = &player_ptr->inventory_list[INVEN_ARMS];
-        const auto flags = o_ptr->get_flags();
+        const auto &flags = player_ptr->equipment_flags()->get_flags(*o_ptr, INVEN_ARMS);
         auto should_mp_decrease = o_ptr->is_valid();
         should_mp_decrease &= flags.has_not(TR_FREE_ACT);
         should_mp_decrease &= flags.has_not(TR_DEC_MANA);
@@ -1054,7 +1220,7 @@ short calc_num_fire(PlayerType *player_ptr, const ItemEntity *o_ptr)
             continue;
         }
 
-        if (q_ptr->get_flags().has(TR_XTRA_SHOTS)) {
+        if (player_ptr->equipment_flags()->get_flags(*q_ptr, i).has(TR_XTRA_SHOTS)) {
             extra_shots++;
         }
     }
@@ -1170,7 +1336,7 @@ static ACTION_SKILL_POWER calc_device_ability(PlayerType *player_ptr)
             continue;
         }
 
-        if (o_ptr->get_flags().has(TR_MAGIC_MASTERY)) {
+        if (player_ptr->equipment_flags()->get_flags(*o_ptr, i).has(TR_MAGIC_MASTERY)) {
             pow += 8 * o_ptr->pval;
         }
     }
@@ -1299,7 +1465,7 @@ static ACTION_SKILL_POWER calc_search(PlayerType *player_ptr)
             continue;
         }
 
-        if (o_ptr->get_flags().has(TR_SEARCH)) {
+        if (player_ptr->equipment_flags()->get_flags(*o_ptr, i).has(TR_SEARCH)) {
             pow += (o_ptr->pval * 5);
         }
     }
@@ -1350,7 +1516,7 @@ static ACTION_SKILL_POWER calc_search_freq(PlayerType *player_ptr)
             continue;
         }
 
-        if (o_ptr->get_flags().has(TR_SEARCH)) {
+        if (player_ptr->equipment_flags()->get_flags(*o_ptr, i).has(TR_SEARCH)) {
             pow += (o_ptr->pval * 5);
         }
     }
@@ -1488,7 +1654,7 @@ static ACTION_SKILL_POWER calc_skill_dig(PlayerType *player_ptr)
             continue;
         }
 
-        if (o_ptr->get_flags().has(TR_TUNNEL)) {
+        if (player_ptr->equipment_flags()->get_flags(*o_ptr, i).has(TR_TUNNEL)) {
             pow += (o_ptr->pval * 20);
         }
     }
@@ -1543,7 +1709,7 @@ static int16_t calc_num_blow(PlayerType *player_ptr, int i)
             wgt = info.wgt;
             mul = info.mul;
 
-            if (pc.equals(PlayerClassType::CAVALRY) && player_ptr->riding && o_ptr->get_flags().has(TR_RIDING)) {
+            if (pc.equals(PlayerClassType::CAVALRY) && player_ptr->riding && player_ptr->equipment_flags()->get_flags(*o_ptr, INVEN_MAIN_HAND + i).has(TR_RIDING)) {
                 num = 5;
                 wgt = 70;
                 mul = 4;
@@ -1777,7 +1943,7 @@ static ARMOUR_CLASS calc_to_ac(PlayerType *player_ptr, bool is_real_value)
 
     for (int i = INVEN_MAIN_HAND; i < INVEN_TOTAL; i++) {
         const auto *o_ptr = &player_ptr->inventory_list[i];
-        const auto flags = o_ptr->get_flags();
+        const auto &flags = player_ptr->equipment_flags()->get_flags(*o_ptr, i);
         if (!o_ptr->is_valid()) {
             continue;
         }
@@ -1933,7 +2099,7 @@ int16_t calc_double_weapon_penalty(PlayerType *player_ptr, INVENTORY_IDX slot)
     int penalty = 0;
 
     if (has_melee_weapon(player_ptr, INVEN_MAIN_HAND) && has_melee_weapon(player_ptr, INVEN_SUB_HAND)) {
-        const auto flags = player_ptr->inventory_list[INVEN_SUB_HAND].get_flags();
+        const auto &flags = player_ptr->equipment_flags()->get_flags(player_ptr->inventory_list[INVEN_SUB_HAND], INVEN_SUB_HAND);
 
         penalty = ((100 - player_ptr->skill_exp[PlayerSkillKindType::TWO_WEAPON] / 160) - (130 - player_ptr->inventory_list[slot].weight) / 8);
         if (set_quick_and_tiny(player_ptr) || set_icing_and_twinkle(player_ptr) || set_anubis_and_chariot(player_ptr)) {
@@ -2133,7 +2299,7 @@ static short calc_to_damage(PlayerType *player_ptr, INVENTORY_IDX slot, bool is_
     damage -= player_ptr->effects()->stun().get_damage_penalty();
     PlayerClass pc(player_ptr);
     const auto tval = o_ptr->bi_key.tval();
-    if (pc.equals(PlayerClassType::PRIEST) && (o_ptr->get_flags().has_not(TR_BLESSED)) && ((tval == ItemKindType::SWORD) || (tval == ItemKindType::POLEARM))) {
+    if (pc.equals(PlayerClassType::PRIEST) && (player_ptr->equipment_flags()->get_flags(*o_ptr, slot).has_not(TR_BLESSED)) && ((tval == ItemKindType::SWORD) || (tval == ItemKindType::POLEARM))) {
         damage -= 2;
     } else if (pc.equals(PlayerClassType::BERSERKER)) {
         damage += player_ptr->lev / 6;
@@ -2349,7 +2515,7 @@ static short calc_to_hit(PlayerType *player_ptr, INVENTORY_IDX slot, bool is_rea
         }
 
         /* Riding bonus and penalty */
-        const auto flags = o_ptr->get_flags();
+        const auto &flags = player_ptr->equipment_flags()->get_flags(*o_ptr, slot);
         if (player_ptr->riding > 0) {
             if (o_ptr->is_lance()) {
                 hit += 15;
@@ -2697,13 +2863,24 @@ void update_creature(PlayerType *player_ptr)
         reorder_pack(player_ptr);
     }
 
-    if (rfu.has(StatusRecalculatingFlag::BONUS)) {
-        rfu.reset_flag(StatusRecalculatingFlag::BONUS);
-        PlayerAlignment(player_ptr).update_alignment();
+    const auto should_update_alignment = rfu.has(StatusRecalculatingFlag::BONUS);
+    EnumClassFlagGroup<PlayerBonusType> bonus_types;
+    for (const auto &[flag, types] : BONUS_DEPENDENCIES) {
+        if (rfu.has(flag)) {
+            rfu.reset_flag(flag);
+            bonus_types.set(types);
+        }
+    }
+
+    if (bonus_types.any()) {
+        if (should_update_alignment) {
+            PlayerAlignment(player_ptr).update_alignment();
+        }
+
         PlayerSkill ps(player_ptr);
         ps.apply_special_weapon_skill_max_values();
         ps.limit_weapon_skills_by_max_value();
-        update_bonuses(player_ptr);
+        update_bonuses(player_ptr, bonus_types);
     }
 
     if (rfu.has(StatusRecalculatingFlag::TORCH)) {
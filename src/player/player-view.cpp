@@ -3,6 +3,7 @@
 #include "floor/line-of-sight.h"
 #include "game-option/map-screen-options.h"
 #include "grid/grid.h"
+#include "monster-floor/monster-lite.h"
 #include "system/floor-type-definition.h"
 #include "system/grid-type-definition.h"
 #include "system/player-type-definition.h"
@@ -123,6 +124,7 @@ void update_view(PlayerType *player_ptr)
         over = MAX_PLAYER_SIGHT * 3 / 2;
     }
 
+    invalidate_mon_lite_cache();
     for (n = 0; n < floor_ptr->view_n; n++) {
         y = floor_ptr->view_y[n];
         x = floor_ptr->view_x[n];
@@ -3,6 +3,7 @@
 #include "floor/floor-events.h"
 #include "floor/floor-save-util.h"
 #include "floor/floor-save.h"
+#include "floor/saved-floor-cache.h"
 #include "grid/grid.h"
 #include "io/files-util.h"
 #include "io/uid-checker.h"
@@ -19,8 +20,44 @@
 #include "system/redrawing-flags-updater.h"
 #include "term/z-form.h"
 #include "util/angband-files.h"
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace {
+/*!
+ * @brief グリッドテンプレートの検索キー
+ */
+struct GridTemplateKey {
+    BIT_FLAGS info;
+    FEAT_IDX feat;
+    FEAT_IDX mimic;
+    short special;
+
+    bool operator==(const GridTemplateKey &) const = default;
+};
+
+struct GridTemplateKeyHash {
+    size_t operator()(const GridTemplateKey &key) const
+    {
+        auto hash = static_cast<uint64_t>(key.info);
+        hash = (hash << 16) ^ static_cast<uint16_t>(key.feat);
+        hash = (hash << 16) ^ static_cast<uint16_t>(key.mimic);
+        hash ^= static_cast<uint64_t>(static_cast<uint16_t>(key.special)) << 48;
+        return std::hash<uint64_t>()(hash);
+    }
+};
+
+/*!
+ * @brief 出現数順に並べたグリッドテンプレートと、各グリッドのテンプレートID
+ */
+struct GridTemplateTable {
+    std::vector<GridTemplate> templates;
+    std::vector<uint16_t> template_ids; //!< 行優先に並べた各グリッドのテンプレートID
+};
+
 /*
  * Usually number of templates are fewer than 255.  Even if
  * more than 254 are exist, the occurrence of each template
@@ -30,34 +67,49 @@ namespace {
  *
  * Ex: 256 will be "0xff" "0x01".
  *     515 will be "0xff" "0xff" "0x03"
+ *
+ * テンプレートはハッシュで検索し、全グリッドを1回走査するだけで
+ * テンプレートの一覧と各グリッドのテンプレートIDを同時に求める.
  */
-std::vector<GridTemplate> generate_sorted_grid_templates(const FloorType &floor)
+GridTemplateTable generate_sorted_grid_templates(const FloorType &floor)
 {
     std::vector<GridTemplate> templates;
+    std::vector<uint16_t> first_seen_ids;
+    first_seen_ids.reserve(floor.height * floor.width);
+    std::unordered_map<GridTemplateKey, uint16_t, GridTemplateKeyHash> indices;
     for (auto y = 0; y < floor.height; y++) {
-        for (auto x = 0; x < floor.width; x++) {
-            const auto &grid = floor.get_grid({ y, x });
-            int i;
-            const int size = std::ssize(templates);
-            for (i = 0; i < size; i++) {
-                auto &gt = templates[i];
-                if (gt.matches(grid)) {
-                    gt.occurrence++;
-                    break;
-                }
-            }
-
-            if (i < size) {
-                continue;
+        for (const auto &grid : floor.grid_array[y].first(floor.width)) {
+            const GridTemplateKey key{ grid.info, grid.feat, grid.mimic, grid.special };
+            const auto [it, is_inserted] = indices.try_emplace(key, static_cast<uint16_t>(templates.size()));
+            if (is_inserted) {
+                templates.emplace_back(grid.info, grid.feat, grid.mimic, grid.special, static_cast<uint16_t>(1));
+            } else {
+                templates[it->second].occurrence++;
             }
 
-            templates.emplace_back(grid.info, grid.feat, grid.mimic, grid.special, static_cast<uint16_t>(1));
+            first_seen_ids.push_back(it->second);
         }
     }
 
-    std::stable_sort(templates.begin(), templates.end(),
-        [](const auto &x, const auto &y) { return x.occurrence < y.occurrence; });
-    return templates;
+    std::vector<uint16_t> order(templates.size());
+    std::iota(order.begin(), order.end(), static_cast<uint16_t>(0));
+    std::stable_sort(order.begin(), order.end(),
+        [&templates](const auto x, const auto y) { return templates[x].occurrence < templates[y].occurrence; });
+
+    GridTemplateTable table;
+    std::vector<uint16_t> sorted_ids(templates.size());
+    table.templates.reserve(templates.size());
+    for (const auto id : order) {
+        sorted_ids[id] = static_cast<uint16_t>(table.templates.size());
+        table.templates.push_back(templates[id]);
+    }
+
+    table.template_ids.reserve(first_seen_ids.size());
+    for (const auto id : first_seen_ids) {
+        table.template_ids.push_back(sorted_ids[id]);
+    }
+
+    return table;
 }
 }
 
@@ -87,7 +139,7 @@ void wr_saved_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr)
     wr_u16b((uint16_t)floor.height);
     wr_u16b((uint16_t)floor.width);
     wr_byte(player_ptr->feeling);
-    const auto templates = generate_sorted_grid_templates(floor);
+    const auto [templates, template_ids] = generate_sorted_grid_templates(floor);
 
     /*** Dump templates ***/
     wr_u16b(static_cast<uint16_t>(templates.size()));
@@ -100,32 +152,21 @@ void wr_saved_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr)
 
     byte count = 0;
     uint16_t prev_u16b = 0;
-    for (int y = 0; y < floor.height; y++) {
-        for (int x = 0; x < floor.width; x++) {
-            const auto &grid = floor.get_grid({ y, x });
-            uint i;
-            for (i = 0; i < templates.size(); i++) {
-                if (templates[i].matches(grid)) {
-                    break;
-                }
-            }
-
-            uint16_t tmp16u = (uint16_t)i;
-            if ((tmp16u == prev_u16b) && (count != MAX_UCHAR)) {
-                count++;
-                continue;
-            }
-
-            wr_byte((byte)count);
-            while (prev_u16b >= MAX_UCHAR) {
-                wr_byte(MAX_UCHAR);
-                prev_u16b -= MAX_UCHAR;
-            }
+    for (const auto tmp16u : template_ids) {
+        if ((tmp16u == prev_u16b) && (count != MAX_UCHAR)) {
+            count++;
+            continue;
+        }
 
-            wr_byte((byte)prev_u16b);
-            prev_u16b = tmp16u;
-            count = 1;
+        wr_byte((byte)count);
+        while (prev_u16b >= MAX_UCHAR) {
+            wr_byte(MAX_UCHAR);
+            prev_u16b -= MAX_UCHAR;
         }
+
+        wr_byte((byte)prev_u16b);
+        prev_u16b = tmp16u;
+        count = 1;
     }
 
     if (count > 0) {
@@ -222,8 +263,9 @@ bool wr_dungeon(PlayerType *player_ptr)
  * @brief ゲームプレイ中のフロア一時保存出力処理サブルーチン / Actually write a temporary saved floor file
  * @param player_ptr プレイヤーへの参照ポインタ
  * @param sf_ptr 保存フロア参照ポインタ
+ * @details saving_savefile を nullptr にしておき、符号化したデータを全て saving_savefile_buffer に書き込む
  */
-static bool save_floor_aux(PlayerType *player_ptr, saved_floor_type *sf_ptr)
+static void save_floor_aux(PlayerType *player_ptr, saved_floor_type *sf_ptr)
 {
     compact_objects(player_ptr, 0);
     compact_monsters(player_ptr, 0);
@@ -239,8 +281,6 @@ static bool save_floor_aux(PlayerType *player_ptr, saved_floor_type *sf_ptr)
     wr_saved_floor(player_ptr, sf_ptr);
     wr_u32b(v_stamp);
     wr_u32b(x_stamp);
-
-    return !ferror(saving_savefile) && (fflush(saving_savefile) != EOF);
 }
 /*!
  * @brief ゲームプレイ中のフロア一時保存出力処理メインルーチン / Attempt to save the temporarily saved-floor data
@@ -254,18 +294,22 @@ bool save_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr, BIT_FLAGS mode
     byte old_xor_byte = 0;
     uint32_t old_v_stamp = 0;
     uint32_t old_x_stamp = 0;
+    std::vector<byte> old_buffer;
 
     if ((mode & SLF_SECOND) != 0) {
         old_fff = saving_savefile;
         old_xor_byte = save_xor_byte;
         old_v_stamp = v_stamp;
         old_x_stamp = x_stamp;
+        old_buffer = std::exchange(saving_savefile_buffer, {});
     }
 
     auto floor_savefile = savefile.string();
     char ext[32];
     strnfmt(ext, sizeof(ext), ".F%02d", (int)sf_ptr->savefile_id);
     floor_savefile.append(ext);
+    auto &cache = SavedFloorCache::get_instance();
+    cache.erase(sf_ptr->savefile_id);
     safe_setuid_grab();
     fd_kill(floor_savefile);
     safe_setuid_drop();
@@ -278,16 +322,13 @@ bool save_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr, BIT_FLAGS mode
     if (fd >= 0) {
         (void)fd_close(fd);
         safe_setuid_grab();
-        saving_savefile = angband_fopen(floor_savefile, FileOpenMode::WRITE, true);
+        auto *fp = angband_fopen(floor_savefile, FileOpenMode::WRITE, true);
         safe_setuid_drop();
-        if (saving_savefile) {
-            if (save_floor_aux(player_ptr, sf_ptr)) {
-                is_save_successful = true;
-            }
-
-            if (angband_fclose(saving_savefile)) {
-                is_save_successful = false;
-            }
+        saving_savefile_buffer.clear();
+        if (fp) {
+            /* メモリ上にシリアライズし、ファイルへの書き込みはキャッシュに任せる */
+            save_floor_aux(player_ptr, sf_ptr);
+            is_save_successful = cache.store(sf_ptr->savefile_id, std::exchange(saving_savefile_buffer, {}), fp, floor_savefile);
         }
 
         if (!is_save_successful) {
@@ -302,6 +343,7 @@ bool save_floor(PlayerType *player_ptr, saved_floor_type *sf_ptr, BIT_FLAGS mode
         save_xor_byte = old_xor_byte;
         v_stamp = old_v_stamp;
         x_stamp = old_x_stamp;
+        saving_savefile_buffer = std::move(old_buffer);
     }
 
     return is_save_successful;
@@ -36,16 +36,21 @@ void wr_store(store_type *store_ptr)
 /*!
  * @brief セーブデータに乱数情報を書き込む / Write RNG state
  * @param なし
+ * @details 汎用の乱数列に続けて、他の種類の乱数列を旧来の乱数表の空き領域に書き込む.
  */
 void wr_randomizer(void)
 {
     wr_u16b(0);
     wr_u16b(0);
-    const auto &state = AngbandSystem::get_instance().get_rng().get_state();
-    for (const auto s : state) {
-        wr_u32b(s);
+    auto num_written = 0;
+    for (const auto &rng : AngbandSystem::get_instance().snapshot_rngs()) {
+        for (const auto s : rng.get_state()) {
+            wr_u32b(s);
+            num_written++;
+        }
     }
-    for (int i = state.size(); i < RAND_DEG; i++) {
+
+    for (int i = num_written; i < RAND_DEG; i++) {
         wr_u32b(0);
     }
 }
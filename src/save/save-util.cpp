@@ -1,23 +1,52 @@
 #include "save/save-util.h"
 
 FILE *saving_savefile; /* Current save "file" */
+std::vector<byte> saving_savefile_buffer; /* Encoded bytes not yet written to the file */
 byte save_xor_byte; /* Simple encryption */
 uint32_t v_stamp = 0L; /* A simple "checksum" on the actual values */
 uint32_t x_stamp = 0L; /* A simple "checksum" on the encoded bytes */
 
+/*!
+ * @brief ファイルへ書き込む前に溜めておく符号化済みバイト列の大きさ
+ */
+static constexpr size_t SAVEFILE_BUFFER_SIZE = 64 * 1024;
+
 /*!
  * @brief 1バイトをファイルに書き込む / These functions place information into a savefile a byte at a time
  * @param v 書き込むバイト値
+ * @details 符号化したバイトはバッファに溜め、一杯になった時にまとめてファイルへ書き込む.
+ * saving_savefile が nullptr の場合はファイルへ書き込まず、全てバッファに溜める.
  */
 static void sf_put(byte v)
 {
     /* Encode the value, write a character */
     save_xor_byte ^= v;
-    (void)putc((int)save_xor_byte, saving_savefile);
+    saving_savefile_buffer.push_back(save_xor_byte);
 
     /* Maintain the checksum info */
     v_stamp += v;
     x_stamp += save_xor_byte;
+
+    if ((saving_savefile != nullptr) && (saving_savefile_buffer.size() >= SAVEFILE_BUFFER_SIZE)) {
+        (void)flush_savefile_buffer();
+    }
+}
+
+/*!
+ * @brief バッファに溜まっている符号化済みバイト列をファイルに書き込む
+ * @return 全て書き込めたらtrue
+ * @details 書き込みに失敗した場合は ferror(saving_savefile) でも検出できる
+ */
+bool flush_savefile_buffer()
+{
+    if ((saving_savefile == nullptr) || saving_savefile_buffer.empty()) {
+        return true;
+    }
+
+    const auto size = saving_savefile_buffer.size();
+    const auto written = fwrite(saving_savefile_buffer.data(), 1, size, saving_savefile);
+    saving_savefile_buffer.clear();
+    return written == size;
 }
 
 /*!
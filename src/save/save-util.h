@@ -2,8 +2,10 @@
 
 #include "system/angband.h"
 #include <string_view>
+#include <vector>
 
 extern FILE *saving_savefile;
+extern std::vector<byte> saving_savefile_buffer;
 extern byte save_xor_byte;
 extern uint32_t v_stamp;
 extern uint32_t x_stamp;
@@ -15,3 +17,4 @@ void wr_s16b(int16_t v);
 void wr_u32b(uint32_t v);
 void wr_s32b(int32_t v);
 void wr_string(std::string_view sv);
+bool flush_savefile_buffer();
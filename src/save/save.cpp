@@ -245,7 +245,7 @@ static bool wr_savefile_new(PlayerType *player_ptr)
 
     wr_u32b(v_stamp);
     wr_u32b(x_stamp);
-    return !ferror(saving_savefile) && (fflush(saving_savefile) != EOF);
+    return flush_savefile_buffer() && !ferror(saving_savefile) && (fflush(saving_savefile) != EOF);
 }
 
 /*!
@@ -268,6 +268,7 @@ static bool save_player_aux(PlayerType *player_ptr, const std::filesystem::path
         safe_setuid_grab();
         saving_savefile = angband_fopen(path, FileOpenMode::WRITE, true);
         safe_setuid_drop();
+        saving_savefile_buffer.clear();
         if (saving_savefile) {
             if (wr_savefile_new(player_ptr)) {
                 is_save_successful = true;
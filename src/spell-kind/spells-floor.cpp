@@ -18,6 +18,7 @@
 #include "floor/floor-save.h"
 #include "floor/floor-util.h"
 #include "floor/geometry.h"
+#include "floor/line-of-sight.h"
 #include "game-option/birth-options.h"
 #include "game-option/cheat-options.h"
 #include "game-option/map-screen-options.h"
@@ -429,6 +430,7 @@ bool destroy_area(PlayerType *player_ptr, const POSITION y1, const POSITION x1,
         }
     }
 
+    SightCache::invalidate_all();
     if (in_generate) {
         return true;
     }
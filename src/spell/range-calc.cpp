@@ -15,6 +15,242 @@
 #include "system/player-type-definition.h"
 #include "target/projection-path-calculator.h"
 #include "util/bit-flags-calculator.h"
+#include <algorithm>
+
+namespace {
+constexpr auto RING_TABLE_RADIUS = 32; //!< 事前計算しておく同心円の半径の上限
+constexpr auto BREATH_CONE_CACHE_SIZE = 64; //!< 保持しておくブレスの形状の数
+
+/*!
+ * @brief 中心からの距離がちょうどdistとなる相対座標を求める
+ * @param dist 中心からの距離
+ * @return 相対座標の一覧 (距離distの正方形をY座標、X座標の順に走査した時の順)
+ */
+std::vector<Pos2DVec> calc_ring(int dist)
+{
+    std::vector<Pos2DVec> ring;
+    for (auto dy = -dist; dy <= dist; dy++) {
+        for (auto dx = -dist; dx <= dist; dx++) {
+            if (distance(0, 0, dy, dx) == dist) {
+                ring.emplace_back(dy, dx);
+            }
+        }
+    }
+
+    return ring;
+}
+
+const std::vector<std::vector<Pos2DVec>> &get_ring_table()
+{
+    static const auto rings = [] {
+        std::vector<std::vector<Pos2DVec>> table;
+        for (auto dist = 0; dist <= RING_TABLE_RADIUS; dist++) {
+            table.push_back(calc_ring(dist));
+        }
+
+        return table;
+    }();
+    return rings;
+}
+
+/*!
+ * @brief 中心からの距離がちょうどdistとなる相対座標を順に処理する
+ * @param dist 中心からの距離
+ * @param func 相対座標を受け取る関数オブジェクト
+ * @details 正方形を走査して距離で篩い落とす代わりに、事前計算した同心円を辿る.
+ */
+template <typename F>
+void scan_ring(int dist, F func)
+{
+    if (dist > RING_TABLE_RADIUS) {
+        for (const auto &vec : calc_ring(dist)) {
+            func(vec);
+        }
+
+        return;
+    }
+
+    for (const auto &vec : get_ring_table()[dist]) {
+        func(vec);
+    }
+}
+
+/*!
+ * @brief ボール・ブレスの中心から対象のグリッドまで効果が届くかを判定する
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param typ 効果属性
+ * @param pos_center 中心座標
+ * @param pos 対象の座標
+ * @return 効果が届くか
+ */
+bool is_in_blast(PlayerType *player_ptr, AttributeType typ, const Pos2D &pos_center, const Pos2D &pos)
+{
+    switch (typ) {
+    case AttributeType::LITE:
+    case AttributeType::LITE_WEAK:
+        /* Lights are stopped by opaque terrains */
+        return los(player_ptr, pos_center.y, pos_center.x, pos.y, pos.x);
+    case AttributeType::DISINTEGRATE:
+        /* Disintegration are stopped only by perma-walls */
+        return in_disintegration_range(player_ptr->current_floor_ptr, pos_center.y, pos_center.x, pos.y, pos.x);
+    default:
+        /* Ball explosions are stopped by walls */
+        return projectable(player_ptr, pos_center.y, pos_center.x, pos.y, pos.x);
+    }
+}
+
+/*!
+ * @brief 地形を考慮しないブレスの形状 (円錐)
+ * @details 座標は全てブレスの始点からの相対座標で持つ.
+ */
+struct BreathCone {
+    /*!
+     * @brief 円錐に含まれる1グリッド
+     */
+    struct Cell {
+        Pos2DVec vec_center; //!< このグリッドを含めた時の爆発の中心
+        Pos2DVec vec; //!< グリッドの位置
+    };
+
+    int rad = 0; //!< 効果半径
+    Pos2DVec vec_dst{ 0, 0 }; //!< 射線の終点
+    std::vector<Pos2DVec> path; //!< 射線の経路
+    std::vector<Cell> cells; //!< 始点からの距離の順に並べたグリッド
+    std::vector<int> layer_ends; //!< layer_ends[d] は始点からの距離がd以下のグリッドの数
+
+    BreathCone(const std::vector<Pos2DVec> &path, int rad, const Pos2DVec &vec_dst);
+    bool matches(const std::vector<Pos2DVec> &other_path, int other_rad, const Pos2DVec &other_vec_dst) const;
+};
+
+/*!
+ * @brief ブレスの形状を計算する
+ * @param path 始点からの相対座標で表した射線の経路 (空であってはならない)
+ * @param rad 効果半径
+ * @param vec_dst 始点からの相対座標で表した射線の終点
+ * @details 射線を辿りながら始点からの距離毎に爆発の中心を進め、その中心からの距離が
+ * 経路上の位置に比例して広がる同心円を重ねていく.
+ */
+BreathCone::BreathCone(const std::vector<Pos2DVec> &path, int rad, const Pos2DVec &vec_dst)
+    : rad(rad)
+    , vec_dst(vec_dst)
+    , path(path)
+{
+    const int dist = path.size();
+    const auto brev = rad * rad / dist;
+    const auto mdis = distance(0, 0, vec_dst.y, vec_dst.x) + rad;
+    Pos2DVec vec_center(0, 0);
+    auto brad = 0;
+    auto path_n = 0;
+    for (auto bdis = 0; bdis <= mdis; bdis++) {
+        if (path_n < dist) {
+            const auto &vec = path[path_n];
+            if (bdis >= distance(vec.y, vec.x, 0, 0)) {
+                vec_center = vec;
+                path_n++;
+            }
+        }
+
+        /* Travel from center outward */
+        for (auto cdis = 0; cdis <= brad; cdis++) {
+            scan_ring(cdis, [this, &vec_center, bdis](const Pos2DVec &offset) {
+                const auto vec = vec_center + offset;
+                if (distance(0, 0, vec.y, vec.x) == bdis) {
+                    this->cells.push_back({ vec_center, vec });
+                }
+            });
+        }
+
+        this->layer_ends.push_back(this->cells.size());
+        brad = rad * (path_n + brev) / (dist + brev);
+    }
+}
+
+bool BreathCone::matches(const std::vector<Pos2DVec> &other_path, int other_rad, const Pos2DVec &other_vec_dst) const
+{
+    const auto is_same = [](const Pos2DVec &vec1, const Pos2DVec &vec2) {
+        return (vec1.y == vec2.y) && (vec1.x == vec2.x);
+    };
+    if ((this->rad != other_rad) || !is_same(this->vec_dst, other_vec_dst)) {
+        return false;
+    }
+
+    return std::equal(this->path.begin(), this->path.end(), other_path.begin(), other_path.end(), is_same);
+}
+
+/*!
+ * @brief 最近使ったブレスの形状の置き場
+ * @details 同じモンスターが同じ位置関係でブレスを吐き続けることが多いため、
+ * 射線の経路と効果半径が同じであれば形状を計算し直さずに使い回す.
+ */
+class BreathConeCache {
+public:
+    const BreathCone &get(const ProjectionPath &path, int dist, int rad, const Pos2D &pos_src, const Pos2D &pos_dst);
+
+private:
+    std::vector<BreathCone> cones;
+    std::vector<Pos2DVec> path_buffer;
+    size_t next_index = 0; //!< 次に置き換える要素
+};
+
+const BreathCone &BreathConeCache::get(const ProjectionPath &path, int dist, int rad, const Pos2D &pos_src, const Pos2D &pos_dst)
+{
+    this->path_buffer.clear();
+    for (auto i = 0; i < dist; i++) {
+        this->path_buffer.push_back(path[i] - pos_src);
+    }
+
+    const auto vec_dst = pos_dst - pos_src;
+    for (const auto &cone : this->cones) {
+        if (cone.matches(this->path_buffer, rad, vec_dst)) {
+            return cone;
+        }
+    }
+
+    if (this->cones.size() < BREATH_CONE_CACHE_SIZE) {
+        return this->cones.emplace_back(this->path_buffer, rad, vec_dst);
+    }
+
+    auto &cone = this->cones[this->next_index];
+    this->next_index = (this->next_index + 1) % BREATH_CONE_CACHE_SIZE;
+    cone = BreathCone(this->path_buffer, rad, vec_dst);
+    return cone;
+}
+
+BreathConeCache breath_cone_cache;
+}
+
+void ProjectionArea::clear()
+{
+    this->positions.clear();
+    this->boundaries.clear();
+}
+
+/*!
+ * @brief 現在までに加えたグリッドを距離dist以下のグリッドとして区切る
+ * @param dist 中心からの距離
+ */
+void ProjectionArea::set_boundary(int dist)
+{
+    if (std::ssize(this->boundaries) < dist + 2) {
+        this->boundaries.resize(dist + 2);
+    }
+
+    this->boundaries[dist + 1] = this->positions.size();
+}
+
+/*!
+ * @brief 距離毎の区切りを得る
+ * @param index 区切りの番号 (距離+1)
+ * @return 区切りの位置 (区切っていなければ0)
+ */
+int ProjectionArea::get_boundary(int index) const
+{
+    if (index >= std::ssize(this->boundaries)) {
+        return 0;
+    }
+
+    return this->boundaries[index];
+}
 
 /*
  * Find the distance from (x, y) to a line.
@@ -195,80 +431,64 @@ bool in_disintegration_range(FloorType *floor_ptr, POSITION y1, POSITION x1, POS
     return true;
 }
 
-/*
- * breath shape
+/*!
+ * @brief ボールの効果範囲を求める
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param area 効果範囲を加える先
+ * @param rad 効果半径
+ * @param y 中心のY座標
+ * @param x 中心のX座標
+ * @param typ 効果属性
  */
-void breath_shape(PlayerType *player_ptr, const ProjectionPath &path, int dist, int *pgrids, POSITION *gx, POSITION *gy, POSITION *gm, POSITION *pgm_rad, POSITION rad, POSITION y1, POSITION x1, POSITION y2, POSITION x2, AttributeType typ)
+void ball_shape(PlayerType *player_ptr, ProjectionArea &area, POSITION rad, POSITION y, POSITION x, AttributeType typ)
 {
-    POSITION by = y1;
-    POSITION bx = x1;
-    int brad = 0;
-    int brev = rad * rad / dist;
-    int bdis = 0;
-    int cdis;
-    int path_n = 0;
-    int mdis = distance(y1, x1, y2, x2) + rad;
-
-    auto *floor_ptr = player_ptr->current_floor_ptr;
-    while (bdis <= mdis) {
-        if ((0 < dist) && (path_n < dist)) {
-            const auto &[ny, nx] = path[path_n];
-            POSITION nd = distance(ny, nx, y1, x1);
-
-            if (bdis >= nd) {
-                by = ny;
-                bx = nx;
-                path_n++;
+    const Pos2D pos_center(y, x);
+    const auto *floor_ptr = player_ptr->current_floor_ptr;
+    for (auto dist = 0; dist <= rad; dist++) {
+        scan_ring(dist, [&](const Pos2DVec &vec) {
+            const auto pos = pos_center + vec;
+            if (in_bounds2(floor_ptr, pos.y, pos.x) && is_in_blast(player_ptr, typ, pos_center, pos)) {
+                area.positions.push_back(pos);
             }
-        }
+        });
 
-        /* Travel from center outward */
-        for (cdis = 0; cdis <= brad; cdis++) {
-            for (POSITION y = by - cdis; y <= by + cdis; y++) {
-                for (POSITION x = bx - cdis; x <= bx + cdis; x++) {
-                    if (!in_bounds(floor_ptr, y, x)) {
-                        continue;
-                    }
-                    if (distance(y1, x1, y, x) != bdis) {
-                        continue;
-                    }
-                    if (distance(by, bx, y, x) != cdis) {
-                        continue;
-                    }
-
-                    switch (typ) {
-                    case AttributeType::LITE:
-                    case AttributeType::LITE_WEAK:
-                        /* Lights are stopped by opaque terrains */
-                        if (!los(player_ptr, by, bx, y, x)) {
-                            continue;
-                        }
-                        break;
-                    case AttributeType::DISINTEGRATE:
-                        /* Disintegration are stopped only by perma-walls */
-                        if (!in_disintegration_range(floor_ptr, by, bx, y, x)) {
-                            continue;
-                        }
-                        break;
-                    default:
-                        /* Ball explosions are stopped by walls */
-                        if (!projectable(player_ptr, by, bx, y, x)) {
-                            continue;
-                        }
-                        break;
-                    }
-
-                    gy[*pgrids] = y;
-                    gx[*pgrids] = x;
-                    (*pgrids)++;
-                }
+        area.set_boundary(dist);
+    }
+}
+
+/*!
+ * @brief ブレスの効果範囲を求める
+ * @param player_ptr プレイヤーへの参照ポインタ
+ * @param path 射線
+ * @param dist 射線のうち実際に届いたグリッドの数 (1以上)
+ * @param area 効果範囲を加える先
+ * @param rad 効果半径
+ * @param y1 始点のY座標
+ * @param x1 始点のX座標
+ * @param y2 終点のY座標
+ * @param x2 終点のX座標
+ * @param typ 効果属性
+ * @return 効果範囲の距離の区切りの数
+ * @details 地形を考慮しない円錐形は射線の経路毎に使い回し、ここでは地形による遮断のみを判定する.
+ */
+int breath_shape(PlayerType *player_ptr, const ProjectionPath &path, int dist, ProjectionArea &area, POSITION rad, POSITION y1, POSITION x1, POSITION y2, POSITION x2, AttributeType typ)
+{
+    const Pos2D pos_src(y1, x1);
+    const auto &cone = breath_cone_cache.get(path, dist, rad, pos_src, { y2, x2 });
+    const auto *floor_ptr = player_ptr->current_floor_ptr;
+    auto i = 0;
+    const int layer_num = cone.layer_ends.size();
+    for (auto bdis = 0; bdis < layer_num; bdis++) {
+        for (; i < cone.layer_ends[bdis]; i++) {
+            const auto &cell = cone.cells[i];
+            const auto pos = pos_src + cell.vec;
+            if (in_bounds(floor_ptr, pos.y, pos.x) && is_in_blast(player_ptr, typ, pos_src + cell.vec_center, pos)) {
+                area.positions.push_back(pos);
             }
         }
 
-        gm[bdis + 1] = *pgrids;
-        brad = rad * (path_n + brev) / (dist + brev);
-        bdis++;
+        area.set_boundary(bdis);
     }
 
-    *pgm_rad = bdis;
+    return layer_num;
 }
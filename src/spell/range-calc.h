@@ -2,10 +2,31 @@
 
 #include "effect/attribute-types.h"
 #include "system/angband.h"
+#include "util/point-2d.h"
+#include <vector>
 
 class FloorType;
 class PlayerType;
 class ProjectionPath;
+
+/*!
+ * @brief ボール・ブレスの効果範囲
+ * @details グリッドは中心 (ブレスは始点) からの距離の順に並ぶ.
+ * clear() しても確保したメモリは解放しないので、使い回せば効果範囲の計算毎にメモリを確保せずに済む.
+ */
+class ProjectionArea {
+public:
+    std::vector<Pos2D> positions; //!< 効果範囲のグリッド
+
+    void clear();
+    void set_boundary(int dist);
+    int get_boundary(int index) const;
+
+private:
+    std::vector<int> boundaries; //!< boundaries[d + 1] は距離d以下のグリッドの数 (0番目は常に0)
+};
+
 bool in_disintegration_range(FloorType *floor_ptr, POSITION y1, POSITION x1, POSITION y2, POSITION x2);
-void breath_shape(PlayerType *player_ptr, const ProjectionPath &path, int dist, int *pgrids, POSITION *gx, POSITION *gy, POSITION *gm, POSITION *pgm_rad, POSITION rad, POSITION y1, POSITION x1, POSITION y2, POSITION x2, AttributeType typ);
+void ball_shape(PlayerType *player_ptr, ProjectionArea &area, POSITION rad, POSITION y, POSITION x, AttributeType typ);
+int breath_shape(PlayerType *player_ptr, const ProjectionPath &path, int dist, ProjectionArea &area, POSITION rad, POSITION y1, POSITION x1, POSITION y2, POSITION x2, AttributeType typ);
 POSITION dist_to_line(POSITION y, POSITION x, POSITION y1, POSITION x1, POSITION y2, POSITION x2);
@@ -0,0 +1,72 @@
+#include "system/active-monster-index.h"
+#include "system/floor-type-definition.h"
+#include "system/monster-entity.h"
+
+/*!
+ * @brief モンスターを置くスロットを登録する
+ * @param m_idx スロットのインデックス
+ * @details 末尾より大きいインデックス (m_pop() が m_max を伸ばした場合) はそのまま追加し、
+ * それ以外 (空きスロットの再利用等) は索引を作り直させる.
+ */
+void ActiveMonsterIndex::add(MONSTER_IDX m_idx)
+{
+    if (this->is_dirty || (!this->m_idx_list.empty() && (m_idx <= this->m_idx_list.back()))) {
+        this->is_dirty = true;
+        return;
+    }
+
+    this->m_idx_list.push_back(m_idx);
+}
+
+/*!
+ * @brief 索引に載っていないスロットにモンスターが置かれた可能性があることを記録する
+ */
+void ActiveMonsterIndex::invalidate()
+{
+    this->is_dirty = true;
+}
+
+bool ActiveMonsterIndex::is_invalidated() const
+{
+    return this->is_dirty;
+}
+
+/*!
+ * @brief 索引が無効になっていたら m_list を走査して作り直す
+ * @param floor フロアへの参照
+ */
+void ActiveMonsterIndex::update(const FloorType &floor)
+{
+    if (!this->is_dirty) {
+        return;
+    }
+
+    this->m_idx_list.clear();
+    for (MONSTER_IDX m_idx = 1; m_idx < floor.m_max; m_idx++) {
+        if (floor.m_list[m_idx].is_valid()) {
+            this->m_idx_list.push_back(m_idx);
+        }
+    }
+
+    this->is_dirty = false;
+}
+
+/*!
+ * @brief 死亡したモンスターのスロットを索引から取り除く
+ * @param floor フロアへの参照
+ */
+void ActiveMonsterIndex::prune(const FloorType &floor)
+{
+    if (this->is_dirty) {
+        return;
+    }
+
+    std::erase_if(this->m_idx_list, [&floor](MONSTER_IDX m_idx) {
+        return (m_idx >= floor.m_max) || !floor.m_list[m_idx].is_valid();
+    });
+}
+
+const std::vector<MONSTER_IDX> &ActiveMonsterIndex::get_list() const
+{
+    return this->m_idx_list;
+}
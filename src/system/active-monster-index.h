@@ -0,0 +1,29 @@
+#pragma once
+
+#include "system/angband.h"
+#include <vector>
+
+class FloorType;
+
+/*!
+ * @brief フロア上で生存しているモンスターのインデックスをフロア単位で保持するクラス
+ * @details m_list のうちモンスターが置かれているスロットを昇順に保持し、ゲームターン毎のモンスター処理で
+ * 空きスロットを走査せずに済むようにする.
+ * m_pop() で確保したスロットは add() で登録し、m_pop() を経ずに空きスロットへモンスターを書き込んだ時は
+ * invalidate() を呼ぶこと. 死亡したモンスターのスロットは索引に残り、走査の後に prune() で取り除く.
+ */
+class ActiveMonsterIndex {
+public:
+    ActiveMonsterIndex() = default;
+
+    void add(MONSTER_IDX m_idx);
+    void invalidate();
+    bool is_invalidated() const;
+    void update(const FloorType &floor);
+    void prune(const FloorType &floor);
+    const std::vector<MONSTER_IDX> &get_list() const;
+
+private:
+    std::vector<MONSTER_IDX> m_idx_list; //!< モンスターが置かれている (または置かれていた) スロット (昇順)
+    bool is_dirty = true; //!< 索引に載っていないスロットにモンスターが置かれた可能性があるか
+};
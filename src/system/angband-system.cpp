@@ -1,4 +1,5 @@
 #include "system/angband-system.h"
+#include "util/enum-converter.h"
 
 AngbandSystem AngbandSystem::instance{};
 
@@ -46,12 +47,83 @@ void AngbandSystem::set_seed_town(const uint32_t seed)
     this->seed_town = seed;
 }
 
+/*!
+ * @brief 現在用いている乱数列の乱数生成器を取得する
+ */
 Xoshiro128StarStar &AngbandSystem::get_rng()
 {
-    return this->rng;
+    return this->rngs[enum2i(this->rng_stream)];
 }
 
+/*!
+ * @brief 指定した種類の乱数列の乱数生成器を取得する
+ * @param stream 乱数列の種類
+ */
+Xoshiro128StarStar &AngbandSystem::get_rng(RngStream stream)
+{
+    return this->rngs[enum2i(stream)];
+}
+
+/*!
+ * @brief 現在用いている乱数列の乱数生成器を差し替える
+ * @param rng_ 乱数生成器
+ */
 void AngbandSystem::set_rng(const Xoshiro128StarStar &rng_)
 {
-    this->rng = rng_;
+    this->get_rng() = rng_;
+}
+
+/*!
+ * @brief 全ての乱数列を初期化する
+ * @param rng_ 汎用の乱数列の乱数生成器
+ * @details 他の種類の乱数列は、汎用の乱数列から fork() で順に分岐させる.
+ */
+void AngbandSystem::reset_rngs(const Xoshiro128StarStar &rng_)
+{
+    this->rngs[enum2i(RngStream::GENERAL)] = rng_;
+    auto rng = rng_;
+    rng.jump();
+    for (auto i = enum2i(RngStream::GENERAL) + 1; i < enum2i(RngStream::MAX); i++) {
+        this->rngs[i] = rng.fork();
+    }
+}
+
+RngStream AngbandSystem::get_rng_stream() const
+{
+    return this->rng_stream;
+}
+
+void AngbandSystem::select_rng_stream(RngStream stream)
+{
+    this->rng_stream = stream;
+}
+
+/*!
+ * @brief 全ての乱数列の状態を退避する
+ * @return 乱数列の状態
+ * @details 乱数生成器は内部状態の16バイトをコピーするだけなので、先行した処理の前後で気軽に退避・復元して良い.
+ */
+AngbandSystem::RngSnapshot AngbandSystem::snapshot_rngs() const
+{
+    return this->rngs;
+}
+
+/*!
+ * @brief 退避した全ての乱数列の状態を戻す
+ * @param snapshot snapshot_rngs() で退避した乱数列の状態
+ */
+void AngbandSystem::restore_rngs(const RngSnapshot &snapshot)
+{
+    this->rngs = snapshot;
+}
+
+RngStreamSelector::RngStreamSelector(RngStream stream)
+    : previous_stream(AngbandSystem::get_instance().get_rng_stream())
+{
+    AngbandSystem::get_instance().select_rng_stream(stream);
+}
+
+RngStreamSelector::~RngStreamSelector()
+{
+    AngbandSystem::get_instance().select_rng_stream(this->previous_stream);
 }
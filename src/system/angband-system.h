@@ -1,10 +1,24 @@
 #pragma once
 
 #include "util/rng-xoshiro.h"
+#include <array>
 #include <stdint.h>
 #include <string>
 #include <string_view>
 
+/*!
+ * @brief 乱数列の種類
+ * @details 処理の系統毎に独立した乱数列を用いることで、ある系統の乱数の消費が他の系統の結果を変えないようにする.
+ */
+enum class RngStream : int {
+    GENERAL = 0, //!< 以下のいずれにも当てはまらない処理
+    FLOOR_GENERATION = 1, //!< フロアの生成
+    MONSTER_AI = 2, //!< モンスターの行動
+    ITEM_GENERATION = 3, //!< アイテムの生成
+    COMBAT = 4, //!< 近接攻撃と射撃
+    MAX,
+};
+
 class AngbandSystem {
 public:
     AngbandSystem(const AngbandSystem &) = delete;
@@ -27,15 +41,41 @@ public:
     void set_seed_flavor(const uint32_t seed);
     uint32_t get_seed_town() const;
     void set_seed_town(const uint32_t seed);
+    using RngSnapshot = std::array<Xoshiro128StarStar, static_cast<int>(RngStream::MAX)>;
+
     Xoshiro128StarStar &get_rng();
+    Xoshiro128StarStar &get_rng(RngStream stream);
     void set_rng(const Xoshiro128StarStar &rng_);
+    void reset_rngs(const Xoshiro128StarStar &rng_);
+    RngStream get_rng_stream() const;
+    void select_rng_stream(RngStream stream);
+    RngSnapshot snapshot_rngs() const;
+    void restore_rngs(const RngSnapshot &snapshot);
 
 private:
     AngbandSystem() = default;
 
     static AngbandSystem instance;
     bool phase_out_stat = false; // カジノ闘技場の観戦状態等に利用。NPCの処理の対象にならず自身もほとんどの行動ができない.
-    Xoshiro128StarStar rng; //!< Uniform random bit generator for <random>
+    RngSnapshot rngs; //!< 乱数列の種類毎の Uniform random bit generator for <random>
+    RngStream rng_stream = RngStream::GENERAL; //!< 現在用いている乱数列
     uint32_t seed_flavor{}; /* アイテム未鑑定名をシャッフルするための乱数シード */
     uint32_t seed_town{}; /* ランダム生成される町をレイアウトするための乱数シード */
 };
+
+/*!
+ * @brief 用いる乱数列をスコープの間だけ切り替える
+ * @details 処理の系統の入口で作る. 入れ子になった場合は内側の系統の乱数列を用い、スコープを抜けると元の乱数列に戻す.
+ */
+class RngStreamSelector {
+public:
+    explicit RngStreamSelector(RngStream stream);
+    ~RngStreamSelector();
+    RngStreamSelector(const RngStreamSelector &) = delete;
+    RngStreamSelector(RngStreamSelector &&) = delete;
+    RngStreamSelector &operator=(const RngStreamSelector &) = delete;
+    RngStreamSelector &operator=(RngStreamSelector &&) = delete;
+
+private:
+    RngStream previous_stream;
+};
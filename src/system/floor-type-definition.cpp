@@ -17,12 +17,12 @@ FloorType::FloorType()
 
 Grid &FloorType::get_grid(const Pos2D pos)
 {
-    return this->grid_array[pos.y][pos.x];
+    return this->grid_array.get(pos);
 }
 
 const Grid &FloorType::get_grid(const Pos2D pos) const
 {
-    return this->grid_array[pos.y][pos.x];
+    return this->grid_array.get(pos);
 }
 
 bool FloorType::is_in_underground() const
@@ -2,7 +2,10 @@
 
 #include "floor/floor-base-definitions.h"
 #include "monster/monster-timed-effect-types.h"
+#include "system/active-monster-index.h"
 #include "system/angband.h"
+#include "system/pathing-layer.h"
+#include "util/bordered-array-2d.h"
 #include "util/point-2d.h"
 #include <array>
 #include <optional>
@@ -43,7 +46,8 @@ class FloorType {
 public:
     FloorType();
     short dungeon_idx = 0;
-    std::vector<std::vector<Grid>> grid_array;
+    BorderedArray2D<Grid> grid_array; /*!< 外周に番兵を持つ連続領域上のグリッド配列 */
+    PathingLayer pathing_layer; /*!< モンスターの経路探索用情報 (流れ・臭い) */
     DEPTH dun_level = 0; /*!< 現在の実ダンジョン階層 base_level の参照元となる / Current dungeon level */
     DEPTH base_level = 0; /*!< 基本生成レベル、後述のobject_level, monster_levelの参照元となる / Base dungeon level */
     DEPTH object_level = 0; /*!< アイテムの生成レベル、 base_level を起点に一時変更する時に参照 / Current object creation level */
@@ -61,6 +65,7 @@ public:
     std::vector<MonsterEntity> m_list; /*!< The array of dungeon monsters [max_m_idx] */
     MONSTER_IDX m_max = 0; /* Number of allocated monsters */
     MONSTER_IDX m_cnt = 0; /* Number of live monsters */
+    ActiveMonsterIndex active_monster_index; /*!< 生存しているモンスターの索引 */
 
     std::vector<int16_t> mproc_list[MAX_MTIMED]{}; /*!< The array to process dungeon monsters[max_m_idx] */
     int16_t mproc_max[MAX_MTIMED]{}; /*!< Number of monsters to be processed */
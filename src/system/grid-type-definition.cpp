@@ -2,7 +2,6 @@
 #include "monster/monster-util.h"
 #include "room/door-definition.h"
 #include "system/angband-system.h"
-#include "system/monster-race-info.h"
 #include "system/terrain-type-definition.h"
 #include "util/bit-flags-calculator.h"
 
@@ -98,21 +97,6 @@ bool Grid::has_monster() const
     return is_monster(this->m_idx);
 }
 
-byte Grid::get_cost(const MonsterRaceInfo *r_ptr) const
-{
-    return this->costs[get_grid_flow_type(r_ptr)];
-}
-
-byte Grid::get_distance(const MonsterRaceInfo *r_ptr) const
-{
-    return this->dists[get_grid_flow_type(r_ptr)];
-}
-
-flow_type Grid::get_grid_flow_type(const MonsterRaceInfo *r_ptr) const
-{
-    return r_ptr->feature_flags.has(MonsterFeatureType::CAN_FLY) ? FLOW_CAN_FLY : FLOW_NORMAL;
-}
-
 /*
  * @brief グリッドのミミック特性地形を返す
  * @param g_ptr グリッドへの参照ポインタ
@@ -138,20 +122,6 @@ bool Grid::is_symbol(const int ch) const
     return this->get_terrain().symbol_configs.at(F_LIT_STANDARD).character == ch;
 }
 
-void Grid::reset_costs()
-{
-    for (auto &cost : this->costs) {
-        cost = 0;
-    }
-}
-
-void Grid::reset_dists()
-{
-    for (auto &dist : this->dists) {
-        dist = 0;
-    }
-}
-
 bool Grid::has_los() const
 {
     return any_bits(this->info, CAVE_VIEW) || AngbandSystem::get_instance().is_phase_out();
@@ -38,13 +38,6 @@
 
 // clang-format on
 
-enum flow_type {
-    FLOW_NORMAL = 0,
-    FLOW_CAN_FLY = 1,
-    FLOW_MAX = 2,
-};
-
-class MonsterRaceInfo;
 class TerrainType;
 enum class TerrainCharacteristics;
 class Grid {
@@ -64,10 +57,6 @@ public:
 
     FEAT_IDX mimic{}; /* Feature to mimic */
 
-    byte costs[FLOW_MAX]{}; /* Hack -- cost of flowing */
-    byte dists[FLOW_MAX]{}; /* Hack -- distance from player */
-    byte when{}; /* Hack -- when cost was computed */
-
     bool is_floor() const;
     bool is_room() const;
     bool is_extra() const;
@@ -84,13 +73,9 @@ public:
     bool is_rune_protection() const;
     bool is_rune_explosion() const;
     bool has_monster() const;
-    byte get_cost(const MonsterRaceInfo *r_ptr) const;
-    byte get_distance(const MonsterRaceInfo *r_ptr) const;
     FEAT_IDX get_feat_mimic() const;
     bool cave_has_flag(TerrainCharacteristics feature_flags) const;
     bool is_symbol(const int ch) const;
-    void reset_costs();
-    void reset_dists();
     bool has_los() const;
     TerrainType &get_terrain();
     const TerrainType &get_terrain() const;
@@ -100,7 +85,4 @@ public:
     const TerrainType &get_terrain_mimic_raw() const;
     void place_closed_curtain();
     void add_info(int grid_info);
-
-private:
-    flow_type get_grid_flow_type(const MonsterRaceInfo *r_ptr) const;
 };
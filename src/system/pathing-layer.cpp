@@ -0,0 +1,132 @@
+#include "system/pathing-layer.h"
+#include "floor/floor-base-definitions.h"
+#include "monster-race/race-feature-flags.h"
+#include "system/monster-race-info.h"
+#include <algorithm>
+#include <limits>
+
+PathingLayer::PathingLayer()
+{
+    for (auto i = 0; i < FLOW_MAX; i++) {
+        this->costs[i].assign(MAX_HGT, MAX_WID);
+        this->dists[i].assign(MAX_HGT, MAX_WID);
+    }
+
+    this->whens.assign(MAX_HGT, MAX_WID);
+    this->generations.assign(MAX_HGT, MAX_WID);
+}
+
+flow_type PathingLayer::get_flow_type(const MonsterRaceInfo *r_ptr)
+{
+    return r_ptr->feature_flags.has(MonsterFeatureType::CAN_FLY) ? FLOW_CAN_FLY : FLOW_NORMAL;
+}
+
+byte PathingLayer::get_cost(const Pos2D &pos, const MonsterRaceInfo *r_ptr) const
+{
+    return this->costs[get_flow_type(r_ptr)].get(pos);
+}
+
+byte PathingLayer::get_distance(const Pos2D &pos, const MonsterRaceInfo *r_ptr) const
+{
+    return this->dists[get_flow_type(r_ptr)].get(pos);
+}
+
+byte PathingLayer::get_when(const Pos2D &pos) const
+{
+    return this->whens.get(pos);
+}
+
+void PathingLayer::set_when(const Pos2D &pos, byte when)
+{
+    this->whens.get(pos) = when;
+}
+
+/*!
+ * @brief 指定したマスの流れ情報が現在の世代で書き込まれたものかを返す
+ * @param index マスの配列上の位置
+ * @return 現在の世代で書き込まれたものならtrue
+ */
+bool PathingLayer::is_stamped(int index) const
+{
+    return this->generations.elements()[index] == this->generation;
+}
+
+/*!
+ * @brief 流れ情報の更新を開始し、世代番号を進める
+ * @details 世代番号が一巡した時のみ全マスの世代番号を消去する.
+ */
+void PathingLayer::begin_flow_update()
+{
+    if (this->generation == std::numeric_limits<byte>::max()) {
+        std::ranges::fill(this->generations.elements(), byte(0));
+        this->generation = 0;
+    }
+
+    this->generation++;
+    this->stamped_indices_next.clear();
+}
+
+/*!
+ * @brief 指定したマスの流れ情報を消去し、現在の世代で書き込むことを記録する
+ * @param index マスの配列上の位置
+ */
+void PathingLayer::stamp(int index)
+{
+    for (auto i = 0; i < FLOW_MAX; i++) {
+        this->costs[i].elements()[index] = 0;
+        this->dists[i].elements()[index] = 0;
+    }
+
+    this->generations.elements()[index] = this->generation;
+    this->stamped_indices_next.push_back(index);
+}
+
+/*!
+ * @brief 流れ情報の更新を終了する
+ * @return 前回の更新で書き込まれ、今回は到達しなかったため消去したマスの数
+ */
+int PathingLayer::end_flow_update()
+{
+    auto cleared_count = 0;
+    for (const auto index : this->stamped_indices) {
+        if (this->is_stamped(index)) {
+            continue;
+        }
+
+        for (auto i = 0; i < FLOW_MAX; i++) {
+            this->costs[i].elements()[index] = 0;
+            this->dists[i].elements()[index] = 0;
+        }
+
+        cleared_count++;
+    }
+
+    this->stamped_indices.swap(this->stamped_indices_next);
+    return cleared_count;
+}
+
+int PathingLayer::get_stamped_count() const
+{
+    return static_cast<int>(this->stamped_indices.size());
+}
+
+/*!
+ * @brief 全マスの流れ情報を消去する
+ */
+void PathingLayer::reset_flow()
+{
+    for (auto i = 0; i < FLOW_MAX; i++) {
+        std::ranges::fill(this->costs[i].elements(), byte(0));
+        std::ranges::fill(this->dists[i].elements(), byte(0));
+    }
+
+    this->stamped_indices.clear();
+}
+
+/*!
+ * @brief 全マスの臭い情報を消去する
+ */
+void PathingLayer::reset_whens()
+{
+    std::ranges::fill(this->whens.elements(), byte(0));
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "system/angband.h"
+#include "util/bordered-array-2d.h"
+#include "util/point-2d.h"
+#include <array>
+#include <vector>
+
+enum flow_type {
+    FLOW_NORMAL = 0,
+    FLOW_CAN_FLY = 1,
+    FLOW_MAX = 2,
+};
+
+class MonsterRaceInfo;
+
+/*!
+ * @brief モンスターの経路探索用情報 (流れ・臭い) をフロア単位で保持するクラス
+ * @details グリッド情報 (Grid) から分離し、情報の種類ごとに連続した配列として保持する.
+ * 配列は外周に1マス分の余白を持つ行優先の並びであり、フロア端の隣接マスも範囲外チェックなしで参照できる.
+ * 流れ情報は世代番号によって管理され、現在の世代で書き込まれていないマスの costs/dists は常に0である.
+ */
+class PathingLayer {
+public:
+    PathingLayer();
+
+    std::array<BorderedArray2D<byte>, FLOW_MAX> costs; /* Hack -- cost of flowing */
+    std::array<BorderedArray2D<byte>, FLOW_MAX> dists; /* Hack -- distance from player */
+    BorderedArray2D<byte> whens; /* Hack -- when cost was computed */
+    BorderedArray2D<byte> generations; /* Hack -- generation of costs and dists */
+
+    static flow_type get_flow_type(const MonsterRaceInfo *r_ptr);
+
+    int get_index(const Pos2D &pos) const
+    {
+        return this->generations.get_index(pos);
+    }
+
+    byte get_cost(const Pos2D &pos, const MonsterRaceInfo *r_ptr) const;
+    byte get_distance(const Pos2D &pos, const MonsterRaceInfo *r_ptr) const;
+    byte get_when(const Pos2D &pos) const;
+    void set_when(const Pos2D &pos, byte when);
+
+    bool is_stamped(int index) const;
+    void begin_flow_update();
+    void stamp(int index);
+    int end_flow_update();
+    int get_stamped_count() const;
+
+    void reset_flow();
+    void reset_whens();
+
+private:
+    byte generation = 0; //!< 現在の流れ情報の世代番号 (0は「未計算」を表す)
+    std::vector<int> stamped_indices; //!< 直前の更新で流れ情報を書き込んだマスの一覧
+    std::vector<int> stamped_indices_next; //!< 更新中に流れ情報を書き込んだマスの一覧
+};
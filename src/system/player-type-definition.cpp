@@ -1,6 +1,7 @@
 #include "system/player-type-definition.h"
 #include "floor/geometry.h"
 #include "market/arena-info-table.h"
+#include "player/equipment-flags-cache.h"
 #include "system/angband-exceptions.h"
 #include "system/redrawing-flags-updater.h"
 #include "timed-effect/timed-effects.h"
@@ -18,6 +19,7 @@ PlayerType *p_ptr = &p_body;
 
 PlayerType::PlayerType()
     : timed_effects(std::make_shared<TimedEffects>())
+    , equipment_flags_cache(std::make_shared<EquipmentFlagsCache>())
 {
 }
 
@@ -31,6 +33,15 @@ std::shared_ptr<TimedEffects> PlayerType::effects() const
     return this->timed_effects;
 }
 
+/*!
+ * @brief 装備品の特性フラグのキャッシュを取得する
+ * @return 特性フラグのキャッシュ
+ */
+std::shared_ptr<EquipmentFlagsCache> PlayerType::equipment_flags() const
+{
+    return this->equipment_flags_cache;
+}
+
 /*!
  * @brief 自身の状態が全快で、かつフロアに影響を与えないかを検証する
  * @return 上記の通りか
@@ -23,6 +23,7 @@ enum class MonsterAbilityType;
 enum class MonsterRaceId : int16_t;
 enum class Virtue : short;
 
+class EquipmentFlagsCache;
 class FloorType;
 class ItemEntity;
 class TimedEffects;
@@ -399,6 +400,7 @@ public:
     char base_name[32]{}; /*!< Stripped version of "player_name" */
 
     std::shared_ptr<TimedEffects> effects() const;
+    std::shared_ptr<EquipmentFlagsCache> equipment_flags() const;
     bool is_fully_healthy() const;
     std::string decrease_ability_random();
     std::string decrease_ability_all();
@@ -410,6 +412,7 @@ public:
 
 private:
     std::shared_ptr<TimedEffects> timed_effects;
+    std::shared_ptr<EquipmentFlagsCache> equipment_flags_cache;
 };
 
 extern PlayerType *p_ptr;
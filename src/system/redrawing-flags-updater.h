@@ -52,6 +52,7 @@ enum class SubWindowRedrawingFlag {
 
 enum class StatusRecalculatingFlag {
     BONUS, /*!< 能力値修正 */
+    SKILL_EXP, /*!< 技能経験値に依存する能力値修正 */
     TORCH, /*!< 光源半径 */
     HP,
     MP,
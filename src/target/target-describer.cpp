@@ -483,7 +483,7 @@ static std::string decide_target_floor(PlayerType *player_ptr, GridExamination *
     return ge_ptr->terrain_ptr->name;
 }
 
-static void describe_grid_monster_all(GridExamination *ge_ptr)
+static void describe_grid_monster_all(const FloorType &floor, GridExamination *ge_ptr)
 {
     if (!w_ptr->wizard) {
 #ifdef JP
@@ -501,13 +501,20 @@ static void describe_grid_monster_all(GridExamination *ge_ptr)
         f_idx_str = std::to_string(ge_ptr->g_ptr->feat);
     }
 
+    const auto &pathing_layer = floor.pathing_layer;
+    const Pos2D pos(ge_ptr->y, ge_ptr->x);
+    const auto dist = pathing_layer.dists[FLOW_NORMAL].get(pos);
+    const auto cost = pathing_layer.costs[FLOW_NORMAL].get(pos);
+    const auto when = pathing_layer.whens.get(pos);
+    const auto &flow_statistics = get_flow_update_statistics();
 #ifdef JP
-    strnfmt(ge_ptr->out_val, sizeof(ge_ptr->out_val), "%s%s%s%s[%s] %x %s %d %d %d (%d,%d) %d", ge_ptr->s1, ge_ptr->name.data(), ge_ptr->s2, ge_ptr->s3, ge_ptr->info,
-        (uint)ge_ptr->g_ptr->info, f_idx_str.data(), ge_ptr->g_ptr->dists[FLOW_NORMAL], ge_ptr->g_ptr->costs[FLOW_NORMAL], ge_ptr->g_ptr->when, (int)ge_ptr->y,
-        (int)ge_ptr->x, travel.cost[ge_ptr->y][ge_ptr->x]);
+    strnfmt(ge_ptr->out_val, sizeof(ge_ptr->out_val), "%s%s%s%s[%s] %x %s %d %d %d (%d,%d) %d [%d/%d]", ge_ptr->s1, ge_ptr->name.data(), ge_ptr->s2, ge_ptr->s3, ge_ptr->info,
+        (uint)ge_ptr->g_ptr->info, f_idx_str.data(), dist, cost, when, (int)ge_ptr->y,
+        (int)ge_ptr->x, travel.cost[ge_ptr->y][ge_ptr->x], flow_statistics.stamped_grids, flow_statistics.cleared_grids);
 #else
-    strnfmt(ge_ptr->out_val, sizeof(ge_ptr->out_val), "%s%s%s%s [%s] %x %s %d %d %d (%d,%d)", ge_ptr->s1, ge_ptr->s2, ge_ptr->s3, ge_ptr->name.data(), ge_ptr->info, ge_ptr->g_ptr->info,
-        f_idx_str.data(), ge_ptr->g_ptr->dists[FLOW_NORMAL], ge_ptr->g_ptr->costs[FLOW_NORMAL], ge_ptr->g_ptr->when, (int)ge_ptr->y, (int)ge_ptr->x);
+    strnfmt(ge_ptr->out_val, sizeof(ge_ptr->out_val), "%s%s%s%s [%s] %x %s %d %d %d (%d,%d) [%d/%d]", ge_ptr->s1, ge_ptr->s2, ge_ptr->s3, ge_ptr->name.data(), ge_ptr->info, ge_ptr->g_ptr->info,
+        f_idx_str.data(), dist, cost, when, (int)ge_ptr->y, (int)ge_ptr->x,
+        flow_statistics.stamped_grids, flow_statistics.cleared_grids);
 #endif
 }
 
@@ -596,7 +603,7 @@ char examine_grid(PlayerType *player_ptr, const POSITION y, const POSITION x, ta
     }
 #endif
 
-    describe_grid_monster_all(ge_ptr);
+    describe_grid_monster_all(*player_ptr->current_floor_ptr, ge_ptr);
     prt(ge_ptr->out_val, 0, 0);
     move_cursor_relative(y, x);
     ge_ptr->query = inkey();
@@ -64,16 +64,38 @@ void Rand_state_init(void)
         std::generate(state.begin(), state.end(), [&dist, &rd] { return dist(rd); });
     } while (std::all_of(state.begin(), state.end(), [](auto s) { return s == 0; }));
 
-    AngbandSystem::get_instance().get_rng().set_state(state);
+    Xoshiro128StarStar rng;
+    rng.set_state(state);
+    AngbandSystem::get_instance().reset_rngs(rng);
 }
 
+/*!
+ * @brief 乱数の状態を固定の種から初期化する
+ * @param seed 乱数の種
+ * @details 同じ種からは同じゲームが進むため、シミュレーションの再現に用いる.
+ */
+void Rand_state_init(uint32_t seed)
+{
+    AngbandSystem::get_instance().reset_rngs(Xoshiro128StarStar(seed));
+}
+
+/*!
+ * @brief a以上b以下の一様乱数を返す
+ * @details 呼び出しの度に std::uniform_int_distribution を作らず、乱数生成器から直接求める.
+ */
 int rand_range(int a, int b)
 {
     if (a >= b) {
         return a;
     }
-    std::uniform_int_distribution<> d(a, b);
-    return d(AngbandSystem::get_instance().get_rng());
+
+    auto &rng = AngbandSystem::get_instance().get_rng();
+    const auto bound = static_cast<uint32_t>(b) - static_cast<uint32_t>(a) + 1;
+    if (bound == 0) {
+        return static_cast<int>(rng());
+    }
+
+    return static_cast<int>(static_cast<uint32_t>(a) + rng.bounded(bound));
 }
 
 /*
@@ -94,11 +116,22 @@ int16_t randnor(int mean, int stand)
  */
 int16_t damroll(DICE_NUMBER num, DICE_SID sides)
 {
-    int i, sum = 0;
-    for (i = 0; i < num; i++) {
-        sum += randint1(sides);
+    if (sides <= 1) {
+        int i, sum = 0;
+        for (i = 0; i < num; i++) {
+            sum += randint1(sides);
+        }
+        return (int16_t)(sum);
     }
-    return (int16_t)(sum);
+
+    auto &rng = AngbandSystem::get_instance().get_rng();
+    const auto bound = static_cast<uint32_t>(sides);
+    auto sum = 0;
+    for (auto i = 0; i < num; i++) {
+        sum += 1 + static_cast<int>(rng.bounded(bound));
+    }
+
+    return static_cast<int16_t>(sum);
 }
 
 /*
@@ -0,0 +1,131 @@
+/*!
+ * @brief グリッド配列の全フロア走査のベンチマークプログラム
+ *
+ * srcディレクトリで以下のコマンドでコンパイルして実行する
+ *
+ * g++ -std=c++20 -O2 -I. test/benchmark-grid-array.cpp
+ *
+ * 従来の std::vector<std::vector<Grid>> と、外周に番兵を持つ連続領域の BorderedArray2D<Grid> について、
+ * フロア全体のフラグ消去 (forget_view() 相当) と隣接8マスの参照 (update_flow() や los() 相当) の所要時間を比較する.
+ * 引数を指定した場合は、その回数だけ各走査を繰り返す.
+ */
+
+#include "floor/floor-base-definitions.h"
+#include "system/grid-type-definition.h"
+#include "util/bordered-array-2d.h"
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr std::array<int, 8> ddx = { { 0, 0, 1, -1, 1, -1, 1, -1 } };
+constexpr std::array<int, 8> ddy = { { 1, -1, 0, 0, 1, 1, -1, -1 } };
+
+template <typename Func>
+void measure(const std::string &name, int repeat, Func func)
+{
+    const auto start = std::chrono::steady_clock::now();
+    long long checksum = 0;
+    for (auto i = 0; i < repeat; i++) {
+        checksum += func(i);
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << name << ": " << elapsed.count() / 1000.0 << " ms (checksum " << checksum << ")" << std::endl;
+}
+
+template <typename GetGrid>
+void setup_floor(GetGrid get_grid)
+{
+    for (auto y = 0; y < MAX_HGT; y++) {
+        for (auto x = 0; x < MAX_WID; x++) {
+            get_grid(y, x).info = ((y * 31 + x * 17) % 5 == 0) ? CAVE_GLOW : CAVE_VIEW;
+        }
+    }
+}
+}
+
+int main(int argc, char *argv[])
+{
+    const auto repeat = (argc > 1) ? std::atoi(argv[1]) : 1000;
+
+    std::vector<std::vector<Grid>> nested(MAX_HGT, std::vector<Grid>(MAX_WID));
+    BorderedArray2D<Grid> bordered;
+    bordered.assign(MAX_HGT, MAX_WID);
+    setup_floor([&](int y, int x) -> Grid & { return nested[y][x]; });
+    setup_floor([&](int y, int x) -> Grid & { return bordered[y][x]; });
+
+    measure("vector<vector<Grid>> flag sweep", repeat, [&](int i) {
+        long long count = 0;
+        for (auto y = 0; y < MAX_HGT; y++) {
+            for (auto x = 0; x < MAX_WID; x++) {
+                auto &grid = nested[y][x];
+                grid.info ^= (i & 1) ? CAVE_XTRA : 0;
+                count += grid.info & CAVE_GLOW;
+            }
+        }
+
+        return count;
+    });
+
+    measure("BorderedArray2D<Grid> flag sweep", repeat, [&](int i) {
+        long long count = 0;
+        for (auto y = 0; y < MAX_HGT; y++) {
+            for (auto &grid : bordered.row(y)) {
+                grid.info ^= (i & 1) ? CAVE_XTRA : 0;
+                count += grid.info & CAVE_GLOW;
+            }
+        }
+
+        return count;
+    });
+
+    measure("vector<vector<Grid>> neighbour sweep (bounds checked)", repeat, [&](int) {
+        long long count = 0;
+        for (auto y = 0; y < MAX_HGT; y++) {
+            for (auto x = 0; x < MAX_WID; x++) {
+                for (auto d = 0; d < 8; d++) {
+                    const auto ny = y + ddy[d];
+                    const auto nx = x + ddx[d];
+                    if ((ny < 0) || (ny >= MAX_HGT) || (nx < 0) || (nx >= MAX_WID)) {
+                        continue;
+                    }
+
+                    count += (nested[ny][nx].info & CAVE_GLOW) ? 1 : 0;
+                }
+            }
+        }
+
+        return count;
+    });
+
+    measure("BorderedArray2D<Grid> neighbour sweep (sentinel)", repeat, [&](int) {
+        long long count = 0;
+        const auto elements = bordered.elements();
+        const auto stride = bordered.stride();
+        for (auto y = 0; y < MAX_HGT; y++) {
+            auto index = bordered.get_index({ y, 0 });
+            for (auto x = 0; x < MAX_WID; x++, index++) {
+                for (auto d = 0; d < 8; d++) {
+                    count += (elements[index + ddy[d] * stride + ddx[d]].info & CAVE_GLOW) ? 1 : 0;
+                }
+            }
+        }
+
+        return count;
+    });
+
+    measure("BorderedArray2D<Grid> column sweep", repeat, [&](int) {
+        long long count = 0;
+        for (auto x = 0; x < MAX_WID; x++) {
+            for (const auto &grid : bordered.column(x)) {
+                count += grid.info & CAVE_GLOW;
+            }
+        }
+
+        return count;
+    });
+}
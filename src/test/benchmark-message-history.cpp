@@ -0,0 +1,187 @@
+/*!
+ * @brief メッセージ履歴のベンチマーク兼検証プログラム
+ *
+ * srcディレクトリで以下のコマンドでコンパイルして実行する
+ *
+ * g++ -std=c++20 -O2 -I. view/message-history.cpp test/benchmark-message-history.cpp
+ *
+ * 戦闘中のメッセージを模した乱数のメッセージを100万個追加する.
+ * std::deque と std::map で共有した std::shared_ptr の列に保持する方式と、MessageHistory を用いる方式とで
+ * 同じメッセージの列を追加して所要時間を比較するとともに、保持しているメッセージが1つずつ全て一致することを検証する.
+ * 引数を指定した場合は、追加するメッセージの数とする.
+ */
+
+#include "view/message-history.h"
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+constexpr auto CAPACITY = 81920 - 1;
+
+/*!
+ * @brief std::deque と std::map によるメッセージ履歴 (比較用)
+ */
+class DequeMessageHistory {
+public:
+    int size() const
+    {
+        return static_cast<int>(this->history.size());
+    }
+
+    void add(std::string str)
+    {
+        if (!this->history.empty()) {
+            std::string_view last_message = *this->history.front();
+            const auto pos = last_message.find('<');
+            auto j = 1;
+            if ((pos != std::string_view::npos) && (pos != 0) && (last_message.length() >= 5)) {
+                j = std::atoi(last_message.data() + pos + 2);
+                last_message = last_message.substr(0, pos - 1);
+            }
+
+            if ((str == last_message) && (j < 1000)) {
+                str = str + " <x" + std::to_string(j + 1) + ">";
+                this->history.pop_front();
+            }
+        }
+
+        std::shared_ptr<const std::string> msg;
+        if (const auto it = this->pool.find(&str); it != this->pool.end()) {
+            msg = it->second.lock();
+        } else {
+            auto deleter = [this](std::string *s) {
+                this->pool.erase(s);
+                delete s;
+            };
+            msg = std::shared_ptr<const std::string>(new std::string(std::move(str)), std::move(deleter));
+            this->pool.emplace(msg.get(), msg);
+        }
+
+        this->history.push_front(std::move(msg));
+        if (this->size() == CAPACITY + 1) {
+            this->history.pop_back();
+        }
+    }
+
+    std::string get(int age) const
+    {
+        return *this->history[age];
+    }
+
+private:
+    struct StringPtrLess {
+        bool operator()(const std::string *a, const std::string *b) const
+        {
+            return *a < *b;
+        }
+    };
+
+    std::map<const std::string *, std::weak_ptr<const std::string>, StringPtrLess> pool;
+    std::deque<std::shared_ptr<const std::string>> history;
+};
+
+std::vector<std::string> make_messages(int num_messages)
+{
+    static constexpr std::array<std::string_view, 8> monsters{ "The cave orc", "The snaga", "The black orc", "Grip, Farmer Maggot's Dog",
+        "The cave spider", "The wolf", "The hill giant", "The dark elven priest" };
+    static constexpr std::array<std::string_view, 6> verbs{ "hits you.", "misses you.", "bites you.", "is hit hard.", "dies.", "flees in terror!" };
+
+    std::mt19937 rng(12345);
+    std::vector<std::string> messages;
+    messages.reserve(num_messages);
+    while (std::ssize(messages) < num_messages) {
+        const auto &monster = monsters[std::uniform_int_distribution<int>(0, monsters.size() - 1)(rng)];
+        std::string msg;
+        switch (std::uniform_int_distribution<int>(0, 3)(rng)) {
+        case 0:
+            msg = std::string(monster).append(" takes ").append(std::to_string(std::uniform_int_distribution<int>(1, 300)(rng))).append(" damage.");
+            break;
+        case 1:
+            msg = std::string("You have ").append(std::to_string(std::uniform_int_distribution<int>(1, 999)(rng))).append(" hit points left.");
+            break;
+        default:
+            msg = std::string(monster).append(" ").append(verbs[std::uniform_int_distribution<int>(0, verbs.size() - 1)(rng)]);
+            break;
+        }
+
+        // 同じメッセージが連続することもあり、まれにまとめられる最大数を超える
+        auto repeat = 1;
+        if (const auto dice = std::uniform_int_distribution<int>(0, 9999)(rng); dice < 5) {
+            repeat = std::uniform_int_distribution<int>(900, 2100)(rng);
+        } else if (dice < 1000) {
+            repeat = std::uniform_int_distribution<int>(2, 20)(rng);
+        }
+
+        for (auto i = 0; (i < repeat) && (std::ssize(messages) < num_messages); i++) {
+            messages.push_back(msg);
+        }
+    }
+
+    return messages;
+}
+
+template <typename T>
+double measure(T &history, const std::vector<std::string> &messages)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto &msg : messages) {
+        history.add(msg);
+    }
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+}
+
+int main(int argc, char *argv[])
+{
+    const auto num_messages = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+    auto messages = make_messages(num_messages);
+
+    // セーブファイルから読み込んだ「～ <xN>」形式のメッセージを混ぜる
+    {
+        DequeMessageHistory history;
+        for (auto i = 0; i < std::ssize(messages); i++) {
+            history.add(messages[i]);
+            if ((i % 1000 == 999) && (i + 1 < std::ssize(messages))) {
+                messages[i + 1] = history.get(0);
+            }
+        }
+    }
+
+    DequeMessageHistory deque_history;
+    MessageHistory ring_history(CAPACITY);
+    const auto deque_time = measure(deque_history, messages);
+    const auto ring_time = measure(ring_history, messages);
+    std::cout << num_messages << " messages" << std::endl;
+    std::cout << "deque + map:    " << deque_time << " ms" << std::endl;
+    std::cout << "MessageHistory: " << ring_time << " ms" << std::endl;
+
+    auto failures = 0;
+    if (deque_history.size() != ring_history.size()) {
+        std::cout << "size mismatch: " << deque_history.size() << " / " << ring_history.size() << std::endl;
+        failures++;
+    }
+
+    for (auto age = 0; (age < deque_history.size()) && (age < ring_history.size()); age++) {
+        if (deque_history.get(age) != ring_history.get(age)) {
+            std::cout << "mismatch at age " << age << ": \"" << deque_history.get(age) << "\" / \"" << ring_history.get(age) << "\"" << std::endl;
+            failures++;
+        }
+    }
+
+    if (!ring_history.get(ring_history.size()).empty()) {
+        std::cout << "out of range message is not empty" << std::endl;
+        failures++;
+    }
+
+    std::cout << failures << " failures" << std::endl;
+    return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
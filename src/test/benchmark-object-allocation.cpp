@@ -0,0 +1,164 @@
+/*!
+ * @brief ベースアイテム生成テーブルの抽選のベンチマーク兼検証プログラム
+ *
+ * srcディレクトリで以下のコマンドでコンパイルして実行する
+ *
+ * g++ -std=c++20 -O2 -I. term/z-rand.cpp system/angband-system.cpp util/rng-xoshiro.cpp test/benchmark-object-allocation.cpp
+ *
+ * 生成階順に並んだ擬似的な生成テーブルを作り、いくつかの生成階でそれぞれ100万個のアイテムを選択する.
+ * 従来の get_obj_index() と同じく抽選のたびに ProbabilityTable を作り直す方式と、
+ * PrefixProbabilityTable を使い回す方式を同じ乱数の状態から実行し、所要時間を比較するとともに
+ * 選択結果が1個ずつすべて一致すること (従って分布も一致すること) を検証する.
+ * 引数を指定した場合は、各生成階で選択するアイテムの数とする.
+ */
+
+#include "system/angband-system.h"
+#include "term/z-rand.h"
+#include "util/prefix-probability-table.h"
+#include "util/probability-table.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+namespace {
+constexpr auto MAX_DEPTH = 128;
+
+struct Entry {
+    int level;
+    int prob;
+    bool is_chest;
+};
+
+/*!
+ * @brief 生成階順に並んだ擬似的な生成テーブルを作る
+ * @details 実際の alloc_kind_table と同程度の数 (約800) の候補を持つ
+ */
+std::vector<Entry> make_table()
+{
+    std::vector<Entry> table;
+    for (auto level = 0; level < MAX_DEPTH; level++) {
+        const auto num = (level < 20) ? 12 : ((level < 60) ? 6 : 3);
+        for (auto i = 0; i < num; i++) {
+            const auto chance = 1 + (level * 7 + i * 13) % 8;
+            table.push_back({ level, 100 / chance, (level + i) % 17 == 0 });
+        }
+    }
+
+    return table;
+}
+
+int get_draw_count()
+{
+    const int p = randint0(100);
+    return 1 + ((p < 60) ? 1 : 0) + ((p < 10) ? 1 : 0);
+}
+
+/*!
+ * @brief 従来の get_obj_index() と同じく、抽選のたびに確率テーブルを作る
+ */
+int pick_by_probability_table(const std::vector<Entry> &table, int level, bool forbid_chest)
+{
+    ProbabilityTable<int> prob_table;
+    for (auto i = 0U; i < table.size(); i++) {
+        const auto &entry = table[i];
+        if (entry.level > level) {
+            break;
+        }
+
+        if (forbid_chest && entry.is_chest) {
+            continue;
+        }
+
+        prob_table.entry_item(i, entry.prob);
+    }
+
+    if (prob_table.empty()) {
+        return -1;
+    }
+
+    const auto n = get_draw_count();
+    std::vector<int> result;
+    ProbabilityTable<int>::lottery(std::back_inserter(result), prob_table, n);
+    return *std::max_element(result.begin(), result.end(), [&table](int a, int b) { return table[a].level < table[b].level; });
+}
+
+/*!
+ * @brief 生成階によらない累積確率テーブルを使い回して抽選する
+ */
+int pick_by_prefix_table(const std::vector<Entry> &table, const PrefixProbabilityTable &prob_table, int level)
+{
+    const auto end = std::partition_point(table.begin(), table.end(), [level](const auto &entry) { return entry.level <= level; });
+    const auto count = static_cast<size_t>(std::distance(table.begin(), end));
+    if (prob_table.total_prob(count) == 0) {
+        return -1;
+    }
+
+    const auto n = get_draw_count();
+    auto result = static_cast<int>(prob_table.pick_one_at_random(count));
+    for (auto i = 1; i < n; i++) {
+        const auto candidate = static_cast<int>(prob_table.pick_one_at_random(count));
+        if (table[result].level < table[candidate].level) {
+            result = candidate;
+        }
+    }
+
+    return result;
+}
+
+template <typename Func>
+std::vector<int> measure(const char *name, int level, int repeat, Func func)
+{
+    std::vector<int> result(repeat);
+    const auto start = std::chrono::steady_clock::now();
+    for (auto i = 0; i < repeat; i++) {
+        result[i] = func();
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << name << " (level " << level << "): " << elapsed.count() / 1000.0 << " ms" << std::endl;
+    return result;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    const auto repeat = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+    const auto table = make_table();
+    std::array<PrefixProbabilityTable, 2> prob_tables;
+    for (const auto &entry : table) {
+        prob_tables[0].entry_item(entry.prob);
+        prob_tables[1].entry_item(entry.is_chest ? 0 : entry.prob);
+    }
+
+    Rand_state_init();
+    auto &system = AngbandSystem::get_instance();
+    for (const auto level : { 0, 5, 20, 50, 100 }) {
+        for (const auto forbid_chest : { false, true }) {
+            const auto rng = system.get_rng();
+            const auto expected = measure("ProbabilityTable", level, repeat, [&] { return pick_by_probability_table(table, level, forbid_chest); });
+            system.set_rng(rng);
+            const auto actual = measure("PrefixProbabilityTable", level, repeat, [&] { return pick_by_prefix_table(table, prob_tables[forbid_chest ? 1 : 0], level); });
+
+            std::vector<int> expected_hist(table.size() + 1);
+            std::vector<int> actual_hist(table.size() + 1);
+            auto mismatch = 0;
+            for (auto i = 0; i < repeat; i++) {
+                expected_hist[expected[i] + 1]++;
+                actual_hist[actual[i] + 1]++;
+                mismatch += (expected[i] != actual[i]) ? 1 : 0;
+            }
+
+            std::cout << "  forbid_chest=" << forbid_chest << ", mismatches: " << mismatch
+                      << ", distribution " << ((expected_hist == actual_hist) ? "matches" : "DIFFERS") << std::endl;
+            if ((mismatch != 0) || (expected_hist != actual_hist)) {
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
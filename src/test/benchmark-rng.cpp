@@ -0,0 +1,209 @@
+/*!
+ * @brief 乱数生成のベンチマーク兼検証プログラム
+ *
+ * srcディレクトリで以下のコマンドでコンパイルして実行する
+ *
+ * g++ -std=c++20 -O2 -I. term/z-rand.cpp system/angband-system.cpp util/rng-xoshiro.cpp test/benchmark-rng.cpp
+ *
+ * 従来の rand_range() と同じく呼び出しの度に std::uniform_int_distribution を作る方式と、
+ * 現在の randint0() / damroll() とで同じ回数の乱数を生成し、所要時間を比較する.
+ * また、一様乱数の範囲と分布、乱数を消費しない場合の扱い、乱数列の切り替えと退避・復元を検証する.
+ * 引数を指定した場合は、各方式で生成する乱数の数とする.
+ */
+
+#include "system/angband-system.h"
+#include "term/z-rand.h"
+#include <array>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+/*!
+ * @brief 従来の rand_range() と同じく、呼び出しの度に分布を作る
+ * @details 従来の rand_range() は別の翻訳単位にありインライン展開されなかったため、同じ条件になるよう関数ポインタ経由で呼ぶ
+ */
+int (*volatile rand_range_by_distribution)(int, int) = [](int a, int b) {
+    if (a >= b) {
+        return a;
+    }
+
+    std::uniform_int_distribution<> d(a, b);
+    return d(AngbandSystem::get_instance().get_rng());
+};
+
+/*!
+ * @brief 従来の damroll() と同じく、ダイス1個毎に分布を作る
+ */
+int damroll_by_distribution(int num, int sides)
+{
+    auto sum = 0;
+    for (auto i = 0; i < num; i++) {
+        sum += rand_range_by_distribution(1, sides);
+    }
+
+    return sum;
+}
+
+template <typename Func>
+void measure(const char *name, int repeat, Func func)
+{
+    const auto start = std::chrono::steady_clock::now();
+    long long checksum = 0;
+    for (auto i = 0; i < repeat; i++) {
+        checksum += func(i);
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << name << ": " << elapsed.count() / 1000.0 << " ms (checksum " << checksum << ")" << std::endl;
+}
+
+/*!
+ * @brief 一様乱数の度数が期待値から外れすぎていないかを調べる
+ * @param bound 上限
+ * @param repeat 生成する乱数の数
+ * @return 全ての値の度数が期待値の標準偏差の6倍以内なら真
+ */
+bool check_distribution(int bound, int repeat)
+{
+    std::vector<int> hist(bound);
+    for (auto i = 0; i < repeat; i++) {
+        const auto value = randint0(bound);
+        if ((value < 0) || (value >= bound)) {
+            std::cout << "randint0(" << bound << ") returned " << value << std::endl;
+            return false;
+        }
+
+        hist[value]++;
+    }
+
+    const auto expected = static_cast<double>(repeat) / bound;
+    const auto limit = 6.0 * std::sqrt(expected * (1.0 - 1.0 / bound));
+    for (auto value = 0; value < bound; value++) {
+        if (std::abs(hist[value] - expected) > limit) {
+            std::cout << "randint0(" << bound << "): " << value << " appeared " << hist[value] << " times (expected " << expected << ")" << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*!
+ * @brief 範囲の端や乱数を消費しない場合の扱いを調べる
+ */
+bool check_edge_cases()
+{
+    auto &system = AngbandSystem::get_instance();
+    for (auto i = 0; i < 1000; i++) {
+        const auto value = rand_range(-5, 5);
+        if ((value < -5) || (value > 5)) {
+            std::cout << "rand_range(-5, 5) returned " << value << std::endl;
+            return false;
+        }
+
+        rand_range(INT_MIN, INT_MAX);
+        const auto negative = randint0(-10);
+        if ((negative > 0) || (negative <= -10)) {
+            std::cout << "randint0(-10) returned " << negative << std::endl;
+            return false;
+        }
+    }
+
+    const auto state = system.get_rng().get_state();
+    const auto no_consumption = (randint1(1) == 1) && (rand_range(7, 7) == 7) && (damroll(3, 1) == 3) && (randint0(0) == 0);
+    if (!no_consumption || (state != system.get_rng().get_state())) {
+        std::cout << "trivial ranges consumed the RNG" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/*!
+ * @brief 乱数列の切り替えと退避・復元を調べる
+ * @details ある乱数列の消費が他の乱数列を進めないこと、退避した状態から同じ乱数列が再現されることを確かめる.
+ */
+bool check_streams()
+{
+    auto &system = AngbandSystem::get_instance();
+    Rand_state_init(12345);
+    const auto snapshot = system.snapshot_rngs();
+    std::array<int, 16> general_values{};
+    for (auto &value : general_values) {
+        value = randint0(1000000);
+    }
+
+    system.restore_rngs(snapshot);
+    std::array<int, 16> interleaved_values{};
+    for (auto &value : interleaved_values) {
+        {
+            RngStreamSelector rng_selector(RngStream::COMBAT);
+            damroll(4, 6);
+        }
+
+        value = randint0(1000000);
+    }
+
+    if (general_values != interleaved_values) {
+        std::cout << "drawing from the combat stream changed the general stream" << std::endl;
+        return false;
+    }
+
+    if (system.get_rng_stream() != RngStream::GENERAL) {
+        std::cout << "RngStreamSelector did not restore the stream" << std::endl;
+        return false;
+    }
+
+    system.restore_rngs(snapshot);
+    for (auto i = 0; i < 2; i++) {
+        const auto first = system.get_rng(static_cast<RngStream>(i)).get_state();
+        const auto second = system.get_rng(static_cast<RngStream>(i + 1)).get_state();
+        if (first == second) {
+            std::cout << "streams share the same state" << std::endl;
+            return false;
+        }
+    }
+
+    auto parent = system.get_rng();
+    auto child = parent.fork();
+    if ((child.get_state() != system.get_rng().get_state()) || (parent.get_state() == child.get_state())) {
+        std::cout << "fork() did not split the stream" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    const auto repeat = (argc > 1) ? std::atoi(argv[1]) : 10000000;
+    Rand_state_init(0);
+    measure("randint0(100) by uniform_int_distribution", repeat, [](int) { return rand_range_by_distribution(0, 99); });
+    measure("randint0(100)", repeat, [](int) { return randint0(100); });
+    measure("randint0(n) by uniform_int_distribution", repeat, [](int i) { return rand_range_by_distribution(0, i % 1000); });
+    measure("randint0(n)", repeat, [](int i) { return randint0(i % 1000 + 1); });
+    measure("damroll(4, 6) by uniform_int_distribution", repeat / 4, [](int) { return damroll_by_distribution(4, 6); });
+    measure("damroll(4, 6)", repeat / 4, [](int) { return damroll(4, 6); });
+    measure("snapshot_rngs() and restore_rngs()", repeat / 4, [](int) {
+        auto &system = AngbandSystem::get_instance();
+        const auto snapshot = system.snapshot_rngs();
+        const auto value = randint0(100);
+        system.restore_rngs(snapshot);
+        return value;
+    });
+
+    auto ok = check_edge_cases();
+    for (const auto bound : { 2, 3, 6, 100, 1000, 65537 }) {
+        ok &= check_distribution(bound, 2000000);
+    }
+
+    ok &= check_streams();
+    std::cout << (ok ? "all checks passed" : "CHECK FAILED") << std::endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
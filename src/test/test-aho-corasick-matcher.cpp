@@ -0,0 +1,90 @@
+/*!
+ * @brief 複数パターン検索クラスのテストプログラム
+ *
+ * srcディレクトリで以下のコマンドでコンパイルして実行する
+ *
+ * g++ -std=c++20 -O2 -I. util/aho-corasick-matcher.cpp test/test-aho-corasick-matcher.cpp
+ *
+ * 少ない種類の文字からなる乱数の文字列とパターンを作り、AhoCorasickMatcher が報告する出現の集合が
+ * std::string_view::find() で全ての位置を調べた結果と一致することを検証する.
+ * 引数を指定した場合は、それを乱数の種とする.
+ */
+
+#include "util/aho-corasick-matcher.h"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+std::string make_random_string(std::mt19937 &rng, int min_length, int max_length)
+{
+    static constexpr std::string_view chars = "ab c\x88";
+    const auto length = std::uniform_int_distribution<int>(min_length, max_length)(rng);
+    std::string str;
+    for (auto i = 0; i < length; i++) {
+        str += chars[std::uniform_int_distribution<int>(0, chars.length() - 1)(rng)];
+    }
+
+    return str;
+}
+
+std::set<std::pair<int, int>> search_naive(const std::vector<std::string> &patterns, std::string_view text)
+{
+    std::set<std::pair<int, int>> found;
+    for (auto id = 0; id < static_cast<int>(patterns.size()); id++) {
+        const auto &pattern = patterns[id];
+        if (pattern.empty()) {
+            continue;
+        }
+
+        for (auto pos = text.find(pattern); pos != std::string_view::npos; pos = text.find(pattern, pos + 1)) {
+            found.emplace(id, static_cast<int>(pos));
+        }
+    }
+
+    return found;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    const auto seed = (argc > 1) ? static_cast<unsigned int>(std::strtoul(argv[1], nullptr, 10)) : std::random_device{}();
+    std::cout << "seed: " << seed << std::endl;
+
+    std::mt19937 rng(seed);
+    auto failures = 0;
+    constexpr auto num_trials = 2000;
+    for (auto trial = 0; trial < num_trials; trial++) {
+        AhoCorasickMatcher matcher;
+        std::vector<std::string> patterns;
+        const auto num_patterns = std::uniform_int_distribution<int>(1, 40)(rng);
+        for (auto i = 0; i < num_patterns; i++) {
+            const auto pattern = make_random_string(rng, 0, 6);
+            const auto id = matcher.add(pattern);
+            if (id == static_cast<int>(patterns.size())) {
+                patterns.push_back(pattern);
+            } else if (patterns[id] != pattern) {
+                std::cout << "wrong id for a duplicated pattern: \"" << pattern << "\"" << std::endl;
+                failures++;
+            }
+        }
+
+        matcher.build();
+        for (auto i = 0; i < 10; i++) {
+            const auto text = make_random_string(rng, 0, 60);
+            std::set<std::pair<int, int>> found;
+            matcher.for_each_match(text, [&](int id, int pos) { found.emplace(id, pos); });
+            if (found != search_naive(patterns, text)) {
+                std::cout << "mismatch: trial " << trial << ", text \"" << text << "\"" << std::endl;
+                failures++;
+            }
+        }
+    }
+
+    std::cout << num_trials << " trials, " << failures << " failures" << std::endl;
+    return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
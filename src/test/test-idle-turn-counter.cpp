@@ -0,0 +1,192 @@
+/*!
+ * @brief 誰も行動しないゲームターンの一括処理のテストプログラム
+ *
+ * srcディレクトリで以下のコマンドでコンパイルして実行する
+ *
+ * g++ -std=c++20 -O2 -I. core/speed-table.cpp world/idle-turn-counter.cpp test/test-idle-turn-counter.cpp
+ *
+ * 行動エネルギーを持つもの (プレイヤー及びモンスター) と10ゲームターン毎の処理を模したモデルで、
+ * 1ゲームターンずつ処理した場合と、IdleTurnCounter で数えたゲームターンを一括で進めた場合とで、
+ * 行動の順序、乱数を呼び出す順序及び最終的な行動エネルギーが完全に一致することを検証する.
+ * 行動や10ゲームターン毎の処理では乱数を使い、加速・減速による速度の変化、処理対象か否かの変化
+ * (プレイヤーから離れたモンスター等) 及び行動エネルギーの増減を起こす.
+ * 引数を指定した場合は、それを乱数の種とする.
+ */
+
+#include "core/speed-table.h"
+#include "world/idle-turn-counter.h"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+constexpr auto TURNS_PER_TICK = 10;
+
+struct Actor {
+    int energy_need;
+    int speed;
+    bool is_processed; //!< 行動エネルギーが溜まるか (モンスターがプレイヤーから遠い等ならfalse)
+};
+
+struct Action {
+    int turn;
+    int actor_index;
+
+    bool operator==(const Action &other) const = default;
+};
+
+class Simulation {
+public:
+    Simulation(unsigned int seed, int num_actors)
+        : rng(seed)
+    {
+        for (auto i = 0; i < num_actors; i++) {
+            this->actors.push_back({ this->random(1, 200), this->random(100, 140), this->random(0, 3) != 0 });
+        }
+    }
+
+    std::vector<Actor> actors;
+    std::vector<Action> actions;
+    std::mt19937 rng;
+    int turn = 1;
+
+    int random(int min, int max)
+    {
+        return std::uniform_int_distribution<int>(min, max)(this->rng);
+    }
+
+    int get_energy_gain(const Actor &actor) const
+    {
+        return speed_to_energy(static_cast<byte>(actor.speed));
+    }
+
+    /*!
+     * @brief 1ゲームターン分の処理を行う (dungeon-processor の1周に相当する)
+     */
+    void process_turn()
+    {
+        for (auto i = 0; i < std::ssize(this->actors); i++) {
+            auto &actor = this->actors[i];
+            if (!actor.is_processed) {
+                continue;
+            }
+
+            actor.energy_need -= this->get_energy_gain(actor);
+            if (actor.energy_need > 0) {
+                continue;
+            }
+
+            actor.energy_need += this->random(75, 125);
+            this->actions.push_back({ this->turn, i });
+            this->act();
+        }
+
+        if (this->turn % TURNS_PER_TICK == 0) {
+            this->act();
+        }
+
+        this->turn++;
+    }
+
+    /*!
+     * @brief 行動または10ゲームターン毎の処理で起こる状態の変化
+     */
+    void act()
+    {
+        auto &target = this->actors[this->random(0, std::ssize(this->actors) - 1)];
+        switch (this->random(0, 5)) {
+        case 0:
+            target.speed = this->random(90, 150);
+            return;
+        case 1:
+            target.is_processed = !target.is_processed;
+            return;
+        case 2:
+            target.energy_need += this->random(-50, 100);
+            return;
+        default:
+            return;
+        }
+    }
+
+    /*!
+     * @brief 誰も行動しないゲームターンを一括で進める (dungeon-processor の skip_idle_game_turns() に相当する)
+     * @param end_turn シミュレーションを終えるゲームターン
+     */
+    void skip_idle_turns(int end_turn)
+    {
+        IdleTurnCounter counter(end_turn - this->turn);
+        for (const auto &actor : this->actors) {
+            if (actor.is_processed) {
+                counter.add_energy(actor.energy_need, this->get_energy_gain(actor));
+            }
+        }
+
+        const auto turns_in_tick = this->turn % TURNS_PER_TICK;
+        counter.limit((turns_in_tick == 0) ? 0 : TURNS_PER_TICK - turns_in_tick);
+        const auto turns = counter.get_turns();
+        for (auto &actor : this->actors) {
+            if (actor.is_processed) {
+                actor.energy_need -= turns * this->get_energy_gain(actor);
+            }
+        }
+
+        this->turn += turns;
+        this->skipped_turns += turns;
+    }
+
+    int skipped_turns = 0;
+};
+
+bool is_same(const Simulation &legacy, const Simulation &skipping)
+{
+    if ((legacy.actions != skipping.actions) || (legacy.rng != skipping.rng) || (legacy.turn != skipping.turn)) {
+        return false;
+    }
+
+    for (auto i = 0; i < std::ssize(legacy.actors); i++) {
+        if (legacy.actors[i].energy_need != skipping.actors[i].energy_need) {
+            return false;
+        }
+    }
+
+    return true;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    const auto seed = (argc > 1) ? static_cast<unsigned int>(std::strtoul(argv[1], nullptr, 10)) : std::random_device{}();
+    std::cout << "seed: " << seed << std::endl;
+
+    constexpr auto end_turn = 100000;
+    auto failures = 0;
+    auto total_skipped_turns = 0;
+    auto total_turns = 0;
+    for (const auto num_actors : { 1, 2, 5, 20, 100 }) {
+        Simulation legacy(seed + num_actors, num_actors);
+        Simulation skipping(seed + num_actors, num_actors);
+        while (legacy.turn < end_turn) {
+            legacy.process_turn();
+        }
+
+        while (skipping.turn < end_turn) {
+            skipping.skip_idle_turns(end_turn);
+            if (skipping.turn < end_turn) {
+                skipping.process_turn();
+            }
+        }
+
+        if (!is_same(legacy, skipping)) {
+            std::cout << "mismatch: " << num_actors << " actors" << std::endl;
+            failures++;
+        }
+
+        total_skipped_turns += skipping.skipped_turns;
+        total_turns += end_turn - 1;
+    }
+
+    std::cout << total_skipped_turns << " of " << total_turns << " game turns skipped, " << failures << " failures" << std::endl;
+    return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,391 @@
+/*!
+ * @brief 視線・射線の経路表のテストプログラム
+ *
+ * srcディレクトリで以下のコマンドでコンパイルして実行する
+ *
+ * g++ -std=c++20 -O2 -I. floor/ray-table.cpp test/test-ray-table.cpp
+ *
+ * 乱数で壁を配置したマップ上で、RayTable による視線の判定及び射線の経路が、
+ * 経路表の導入前の los() 及び ProjectionPath のアルゴリズムで求めたものと完全に一致することを検証する.
+ * 射線の停止条件は地形 (PROJECT) 、マップの外周、終点 (PROJECT_THRU 無し) のみとする.
+ * 引数を指定した場合は、それを乱数の種とする.
+ */
+
+#include "floor/ray-table.h"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+constexpr auto MAP_HGT = 66;
+constexpr auto MAP_WID = 198;
+
+class TestMap {
+public:
+    TestMap(std::mt19937 &rng, int wall_percent)
+        : is_open(MAP_HGT * MAP_WID)
+    {
+        std::uniform_int_distribution<int> dist(0, 99);
+        for (auto y = 0; y < MAP_HGT; y++) {
+            for (auto x = 0; x < MAP_WID; x++) {
+                const auto is_border = (y == 0) || (y == MAP_HGT - 1) || (x == 0) || (x == MAP_WID - 1);
+                this->is_open[y * MAP_WID + x] = !is_border && (dist(rng) >= wall_percent);
+            }
+        }
+    }
+
+    bool is_transparent(int y, int x) const
+    {
+        return this->is_open[y * MAP_WID + x];
+    }
+
+    bool in_bounds(int y, int x) const
+    {
+        return (y > 0) && (x > 0) && (y < MAP_HGT - 1) && (x < MAP_WID - 1);
+    }
+
+private:
+    std::vector<bool> is_open;
+};
+
+/*!
+ * @brief 経路表の導入前の los() (地形の参照先のみ TestMap に置き換えたもの)
+ */
+bool legacy_los(const TestMap &map, int y1, int x1, int y2, int x2)
+{
+    int dy = y2 - y1;
+    int dx = x2 - x1;
+    int ay = std::abs(dy);
+    int ax = std::abs(dx);
+    if ((ax < 2) && (ay < 2)) {
+        return true;
+    }
+
+    int tx, ty;
+    if (!dx) {
+        if (dy > 0) {
+            for (ty = y1 + 1; ty < y2; ty++) {
+                if (!map.is_transparent(ty, x1)) {
+                    return false;
+                }
+            }
+        } else {
+            for (ty = y1 - 1; ty > y2; ty--) {
+                if (!map.is_transparent(ty, x1)) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    if (!dy) {
+        if (dx > 0) {
+            for (tx = x1 + 1; tx < x2; tx++) {
+                if (!map.is_transparent(y1, tx)) {
+                    return false;
+                }
+            }
+        } else {
+            for (tx = x1 - 1; tx > x2; tx--) {
+                if (!map.is_transparent(y1, tx)) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    int sx = (dx < 0) ? -1 : 1;
+    int sy = (dy < 0) ? -1 : 1;
+    if (ax == 1) {
+        if (ay == 2) {
+            if (map.is_transparent(y1 + sy, x1)) {
+                return true;
+            }
+        }
+    } else if (ay == 1) {
+        if (ax == 2) {
+            if (map.is_transparent(y1, x1 + sx)) {
+                return true;
+            }
+        }
+    }
+
+    int f2 = (ax * ay);
+    int f1 = f2 << 1;
+    int qy;
+    int m;
+    if (ax >= ay) {
+        qy = ay * ay;
+        m = qy << 1;
+        tx = x1 + sx;
+        if (qy == f2) {
+            ty = y1 + sy;
+            qy -= f1;
+        } else {
+            ty = y1;
+        }
+
+        while (x2 - tx) {
+            if (!map.is_transparent(ty, tx)) {
+                return false;
+            }
+
+            qy += m;
+            if (qy < f2) {
+                tx += sx;
+                continue;
+            }
+
+            if (qy > f2) {
+                ty += sy;
+                if (!map.is_transparent(ty, tx)) {
+                    return false;
+                }
+                qy -= f1;
+                tx += sx;
+                continue;
+            }
+
+            ty += sy;
+            qy -= f1;
+            tx += sx;
+        }
+
+        return true;
+    }
+
+    int qx = ax * ax;
+    m = qx << 1;
+    ty = y1 + sy;
+    if (qx == f2) {
+        tx = x1 + sx;
+        qx -= f1;
+    } else {
+        tx = x1;
+    }
+
+    while (y2 - ty) {
+        if (!map.is_transparent(ty, tx)) {
+            return false;
+        }
+
+        qx += m;
+        if (qx < f2) {
+            ty += sy;
+            continue;
+        }
+
+        if (qx > f2) {
+            tx += sx;
+            if (!map.is_transparent(ty, tx)) {
+                return false;
+            }
+            qx -= f1;
+            ty += sy;
+            continue;
+        }
+
+        tx += sx;
+        qx -= f1;
+        ty += sy;
+    }
+
+    return true;
+}
+
+/*!
+ * @brief 射線の停止条件 (地形、マップの外周及び終点のみに簡略化した project_stop())
+ */
+bool should_stop(const TestMap &map, bool is_thru, const Pos2D &pos, const Pos2D &pos_dst)
+{
+    if (!is_thru && (pos == pos_dst)) {
+        return true;
+    }
+
+    if (!map.is_transparent(pos.y, pos.x)) {
+        return true;
+    }
+
+    return !map.in_bounds(pos.y, pos.x);
+}
+
+int sign(int num)
+{
+    if (num > 0) {
+        return 1;
+    }
+    if (num < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+/*!
+ * @brief 経路表の導入前の ProjectionPath の計算 (停止条件のみ should_stop() に置き換えたもの)
+ */
+std::vector<Pos2D> legacy_projection_path(const TestMap &map, int range, const Pos2D &pos_src, const Pos2D &pos_dst, bool is_thru)
+{
+    std::vector<Pos2D> position;
+    if (pos_src == pos_dst) {
+        return position;
+    }
+
+    const auto pos_diff = pos_dst - pos_src;
+    const auto half = std::abs(pos_diff.y) * std::abs(pos_diff.x);
+    const auto full = half * 2;
+    Pos2D pos(0, 0);
+    auto frac = 0;
+    auto m = 0;
+    auto k = 0;
+    const auto calc_frac = [&](bool is_vertical) {
+        if (m == 0) {
+            return;
+        }
+
+        frac += m;
+        if (frac <= half) {
+            return;
+        }
+
+        if (is_vertical) {
+            pos.x += sign(pos_diff.x);
+        } else {
+            pos.y += sign(pos_diff.y);
+        }
+
+        frac -= full;
+        k++;
+    };
+    const auto calc_projection_to_target = [&](bool is_vertical) {
+        while (true) {
+            position.push_back(pos);
+            if (static_cast<int>(position.size()) + k / 2 >= range) {
+                break;
+            }
+
+            if (should_stop(map, is_thru, pos, pos_dst)) {
+                break;
+            }
+
+            calc_frac(is_vertical);
+            if (is_vertical) {
+                pos.y += sign(pos_diff.y);
+            } else {
+                pos.x += sign(pos_diff.x);
+            }
+        }
+    };
+
+    if (std::abs(pos_diff.y) > std::abs(pos_diff.x)) {
+        m = pos_diff.x * pos_diff.x * 2;
+        pos = { pos_src.y + sign(pos_diff.y), pos_src.x };
+        frac = m;
+        if (frac > half) {
+            pos.x += sign(pos_diff.x);
+            frac -= full;
+            k++;
+        }
+
+        calc_projection_to_target(true);
+        return position;
+    }
+
+    if (std::abs(pos_diff.x) > std::abs(pos_diff.y)) {
+        m = pos_diff.y * pos_diff.y * 2;
+        pos = { pos_src.y, pos_src.x + sign(pos_diff.x) };
+        frac = m;
+        if (frac > half) {
+            pos.y += sign(pos_diff.y);
+            frac -= full;
+            k++;
+        }
+
+        calc_projection_to_target(false);
+        return position;
+    }
+
+    pos = { pos_src.y + sign(pos_diff.y), pos_src.x + sign(pos_diff.x) };
+    while (true) {
+        position.push_back(pos);
+        if (static_cast<int>(position.size()) * 3 / 2 >= range) {
+            break;
+        }
+
+        if (should_stop(map, is_thru, pos, pos_dst)) {
+            break;
+        }
+
+        pos.y += sign(pos_diff.y);
+        pos.x += sign(pos_diff.x);
+    }
+
+    return position;
+}
+
+bool table_los(const TestMap &map, const Pos2D &pos_src, const Pos2D &pos_dst)
+{
+    return RayTable::get_instance().trace_los(pos_dst - pos_src, [&map, &pos_src](const Pos2DVec &vec) {
+        const auto pos = pos_src + vec;
+        return map.is_transparent(pos.y, pos.x);
+    });
+}
+
+std::vector<Pos2D> table_projection_path(const TestMap &map, int range, const Pos2D &pos_src, const Pos2D &pos_dst, bool is_thru)
+{
+    std::vector<Pos2D> position;
+    if (pos_src == pos_dst) {
+        return position;
+    }
+
+    RayTable::get_instance().trace_projection(pos_dst - pos_src, range, [&](const Pos2DVec &vec) {
+        const auto pos = pos_src + vec;
+        position.push_back(pos);
+        return !should_stop(map, is_thru, pos, pos_dst);
+    });
+    return position;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    const auto seed = (argc > 1) ? static_cast<unsigned int>(std::strtoul(argv[1], nullptr, 10)) : std::random_device{}();
+    std::mt19937 rng(seed);
+    std::cout << "seed: " << seed << std::endl;
+
+    auto los_count = 0;
+    auto path_count = 0;
+    auto failures = 0;
+    for (const auto wall_percent : { 0, 10, 30, 60 }) {
+        const TestMap map(rng, wall_percent);
+        std::uniform_int_distribution<int> dist_y(1, MAP_HGT - 2);
+        std::uniform_int_distribution<int> dist_x(1, MAP_WID - 2);
+        std::uniform_int_distribution<int> dist_offset(-30, 30);
+        std::uniform_int_distribution<int> dist_range(-1, 40);
+        for (auto i = 0; i < 200000; i++) {
+            const Pos2D pos_src(dist_y(rng), dist_x(rng));
+            const Pos2D pos_dst(std::clamp(pos_src.y + dist_offset(rng), 1, MAP_HGT - 2), std::clamp(pos_src.x + dist_offset(rng), 1, MAP_WID - 2));
+            if (table_los(map, pos_src, pos_dst) != legacy_los(map, pos_src.y, pos_src.x, pos_dst.y, pos_dst.x)) {
+                std::cout << "los mismatch: (" << pos_src.y << "," << pos_src.x << ") -> (" << pos_dst.y << "," << pos_dst.x << ")" << std::endl;
+                failures++;
+            }
+
+            los_count++;
+            const auto range = dist_range(rng);
+            const auto is_thru = (rng() % 2) == 0;
+            if (table_projection_path(map, range, pos_src, pos_dst, is_thru) != legacy_projection_path(map, range, pos_src, pos_dst, is_thru)) {
+                std::cout << "path mismatch: (" << pos_src.y << "," << pos_src.x << ") -> (" << pos_dst.y << "," << pos_dst.x << ") range " << range << std::endl;
+                failures++;
+            }
+
+            path_count++;
+        }
+    }
+
+    std::cout << los_count << " los checks, " << path_count << " projection paths, " << failures << " failures" << std::endl;
+    return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,218 @@
+/*!
+ * @brief セーブファイルの読み書きのラウンドトリップテストプログラム
+ *
+ * srcディレクトリで以下のコマンドでコンパイルして実行する
+ *
+ * g++ -std=c++20 -I. save/save-util.cpp load/load-util.cpp test/test-savefile-stream.cpp
+ *
+ * 乱数で決めた値の列を wr_*() で一時ファイルに書き込み、
+ * 1バイトずつ符号化する従来の方式で求めたバイト列及びチェックサムと完全に一致することと、
+ * rd_*() で読み戻した値及びチェックサムが書き込んだものと一致することを検証する.
+ * 途中で暗号化バイトを0に戻す処理 (セーブファイルのヘッダ部分に相当) も乱数で挟む.
+ * 引数を指定した場合は、それを乱数の種とする.
+ */
+
+#include "load/load-util.h"
+#include "save/save-util.h"
+#include "term/screen-processor.h"
+#include "term/z-term.h"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <variant>
+#include <vector>
+
+/* load_note() が参照する画面出力関数のダミー */
+void prt(std::string_view, TERM_LEN, TERM_LEN)
+{
+}
+
+errr term_fresh()
+{
+    return 0;
+}
+
+namespace {
+struct ResetXor {
+};
+
+using Value = std::variant<byte, uint16_t, uint32_t, std::string, ResetXor>;
+
+/*!
+ * @brief 従来の sf_put() と同じく1バイトずつ符号化する参照実装
+ */
+class ReferenceEncoder {
+public:
+    std::vector<byte> bytes;
+    byte xor_byte = 0;
+    uint32_t v_stamp = 0;
+    uint32_t x_stamp = 0;
+
+    void put(byte v)
+    {
+        xor_byte ^= v;
+        bytes.push_back(xor_byte);
+        v_stamp += v;
+        x_stamp += xor_byte;
+    }
+};
+
+std::vector<Value> make_values(std::mt19937 &rng)
+{
+    std::vector<Value> values;
+    const auto count = std::uniform_int_distribution<int>(0, 60000)(rng);
+    for (auto i = 0; i < count; i++) {
+        switch (std::uniform_int_distribution<int>(0, 20)(rng)) {
+        case 0: {
+            std::string str(std::uniform_int_distribution<int>(0, 300)(rng), ' ');
+            for (auto &c : str) {
+                c = static_cast<char>(std::uniform_int_distribution<int>(1, 255)(rng));
+            }
+
+            values.emplace_back(std::move(str));
+            break;
+        }
+        case 1:
+            values.emplace_back(ResetXor{});
+            break;
+        case 2:
+        case 3:
+        case 4:
+        case 5:
+            values.emplace_back(static_cast<uint32_t>(rng()));
+            break;
+        case 6:
+        case 7:
+        case 8:
+        case 9:
+        case 10:
+            values.emplace_back(static_cast<uint16_t>(rng()));
+            break;
+        default:
+            values.emplace_back(static_cast<byte>(rng()));
+            break;
+        }
+    }
+
+    return values;
+}
+
+ReferenceEncoder encode_reference(const std::vector<Value> &values)
+{
+    ReferenceEncoder encoder;
+    for (const auto &value : values) {
+        if (std::holds_alternative<ResetXor>(value)) {
+            encoder.xor_byte = 0;
+        } else if (const auto *v8 = std::get_if<byte>(&value)) {
+            encoder.put(*v8);
+        } else if (const auto *v16 = std::get_if<uint16_t>(&value)) {
+            encoder.put(static_cast<byte>(*v16 & 0xFF));
+            encoder.put(static_cast<byte>(*v16 >> 8));
+        } else if (const auto *v32 = std::get_if<uint32_t>(&value)) {
+            for (auto shift = 0; shift < 32; shift += 8) {
+                encoder.put(static_cast<byte>((*v32 >> shift) & 0xFF));
+            }
+        } else {
+            for (const auto c : std::get<std::string>(value)) {
+                encoder.put(static_cast<byte>(c));
+            }
+
+            encoder.put(0);
+        }
+    }
+
+    return encoder;
+}
+
+bool write_values(FILE *fp, const std::vector<Value> &values)
+{
+    saving_savefile = fp;
+    saving_savefile_buffer.clear();
+    save_xor_byte = 0;
+    v_stamp = 0;
+    x_stamp = 0;
+    for (const auto &value : values) {
+        if (std::holds_alternative<ResetXor>(value)) {
+            save_xor_byte = 0;
+        } else if (const auto *v8 = std::get_if<byte>(&value)) {
+            wr_byte(*v8);
+        } else if (const auto *v16 = std::get_if<uint16_t>(&value)) {
+            wr_u16b(*v16);
+        } else if (const auto *v32 = std::get_if<uint32_t>(&value)) {
+            wr_u32b(*v32);
+        } else {
+            wr_string(std::get<std::string>(value));
+        }
+    }
+
+    return flush_savefile_buffer() && !ferror(fp) && (fflush(fp) != EOF);
+}
+
+bool read_values(FILE *fp, const std::vector<Value> &values)
+{
+    loading_savefile = fp;
+    loading_savefile_buffer = {};
+    load_xor_byte = 0;
+    v_check = 0;
+    x_check = 0;
+    for (const auto &value : values) {
+        if (std::holds_alternative<ResetXor>(value)) {
+            load_xor_byte = 0;
+        } else if (const auto *v8 = std::get_if<byte>(&value)) {
+            if (rd_byte() != *v8) {
+                return false;
+            }
+        } else if (const auto *v16 = std::get_if<uint16_t>(&value)) {
+            if (rd_u16b() != *v16) {
+                return false;
+            }
+        } else if (const auto *v32 = std::get_if<uint32_t>(&value)) {
+            if (rd_u32b() != *v32) {
+                return false;
+            }
+        } else if (rd_string() != std::get<std::string>(value)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    const auto seed = (argc > 1) ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : 20240601U;
+    std::mt19937 rng(seed);
+    constexpr auto rounds = 50;
+    for (auto round = 0; round < rounds; round++) {
+        const auto values = make_values(rng);
+        const auto expected = encode_reference(values);
+
+        auto *fp = std::tmpfile();
+        if ((fp == nullptr) || !write_values(fp, values)) {
+            std::cerr << "round " << round << ": write failed" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::rewind(fp);
+        std::vector<byte> actual(expected.bytes.size() + 1);
+        actual.resize(std::fread(actual.data(), 1, actual.size(), fp));
+        if ((actual != expected.bytes) || (v_stamp != expected.v_stamp) || (x_stamp != expected.x_stamp)) {
+            std::cerr << "round " << round << ": encoded bytes differ from the reference" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::rewind(fp);
+        const auto is_read = read_values(fp, values);
+        std::fclose(fp);
+        if (!is_read || (v_check != v_stamp) || (x_check != x_stamp)) {
+            std::cerr << "round " << round << ": read back values differ" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::cout << rounds << " rounds passed (seed " << seed << ")" << std::endl;
+    return EXIT_SUCCESS;
+}
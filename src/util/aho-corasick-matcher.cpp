@@ -0,0 +1,104 @@
+#include "util/aho-corasick-matcher.h"
+#include <queue>
+
+AhoCorasickMatcher::AhoCorasickMatcher()
+{
+    this->clear();
+}
+
+/*!
+ * @brief パターンを登録する
+ * @param pattern パターン
+ * @return パターン番号 (既に同じパターンが登録されていればその番号)
+ * @details 登録した後は build() を呼ぶまで検索できない.
+ */
+int AhoCorasickMatcher::add(std::string_view pattern)
+{
+    auto state = 0;
+    for (const auto c : pattern) {
+        const auto it = this->nodes[state].children.find(c);
+        if (it != this->nodes[state].children.end()) {
+            state = it->second;
+            continue;
+        }
+
+        const auto next = static_cast<int>(this->nodes.size());
+        const auto depth = this->nodes[state].depth + 1;
+        this->nodes[state].children.emplace(c, next);
+        this->nodes.push_back({});
+        this->nodes[next].depth = depth;
+        state = next;
+    }
+
+    auto &node = this->nodes[state];
+    if (node.pattern_id < 0) {
+        node.pattern_id = static_cast<int>(this->pattern_nodes.size());
+        this->pattern_nodes.push_back(state);
+    }
+
+    return node.pattern_id;
+}
+
+/*!
+ * @brief 登録したパターンから失敗時の遷移先を求める
+ */
+void AhoCorasickMatcher::build()
+{
+    std::queue<int> que;
+    for (const auto &[c, child] : this->nodes[0].children) {
+        this->nodes[child].failure_link = 0;
+        this->nodes[child].output_link = 0;
+        que.push(child);
+    }
+
+    while (!que.empty()) {
+        const auto state = que.front();
+        que.pop();
+        for (const auto &[c, child] : this->nodes[state].children) {
+            const auto failure = this->next_state(this->nodes[state].failure_link, c);
+            this->nodes[child].failure_link = failure;
+            this->nodes[child].output_link = (this->nodes[failure].pattern_id >= 0) ? failure : this->nodes[failure].output_link;
+            que.push(child);
+        }
+    }
+}
+
+/*!
+ * @brief 登録したパターンを全て消去する
+ */
+void AhoCorasickMatcher::clear()
+{
+    this->nodes.assign(1, {});
+    this->pattern_nodes.clear();
+}
+
+/*!
+ * @brief 登録されているパターンの数を返す
+ */
+int AhoCorasickMatcher::size() const
+{
+    return static_cast<int>(this->pattern_nodes.size());
+}
+
+/*!
+ * @brief 1文字読み進めた時の遷移先を求める
+ * @param state 現在の節点
+ * @param c 次の文字
+ * @return 遷移先の節点
+ */
+int AhoCorasickMatcher::next_state(int state, char c) const
+{
+    while (true) {
+        const auto &children = this->nodes[state].children;
+        const auto it = children.find(c);
+        if (it != children.end()) {
+            return it->second;
+        }
+
+        if (state == 0) {
+            return 0;
+        }
+
+        state = this->nodes[state].failure_link;
+    }
+}
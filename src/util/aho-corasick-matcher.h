@@ -0,0 +1,56 @@
+#pragma once
+
+#include <map>
+#include <string_view>
+#include <vector>
+
+/*!
+ * @brief 複数の文字列パターンを一度の走査で検索するクラス (Aho-Corasick法)
+ * @details add() でパターンを登録し、build() の後に for_each_match() で検索する.
+ * 文字列はバイト列として扱うため、マルチバイト文字の途中から始まる出現も報告する.
+ * 文字の境界に揃っているかの判定は呼び出し側で行うこと.
+ */
+class AhoCorasickMatcher {
+public:
+    AhoCorasickMatcher();
+
+    int add(std::string_view pattern);
+    void build();
+    void clear();
+    int size() const;
+
+    /*!
+     * @brief 文字列中の全てのパターンの出現を報告する
+     * @param text 検索対象の文字列
+     * @param on_match 出現毎に (パターン番号, 出現位置の先頭のバイト位置) を引数として呼び出す関数
+     * @details 空文字列のパターンは報告しない.
+     */
+    template <typename F>
+    void for_each_match(std::string_view text, F &&on_match) const
+    {
+        auto state = 0;
+        for (auto i = 0; i < static_cast<int>(text.length()); i++) {
+            state = this->next_state(state, text[i]);
+            for (auto output = state; output > 0; output = this->nodes[output].output_link) {
+                const auto &node = this->nodes[output];
+                if (node.pattern_id >= 0) {
+                    on_match(node.pattern_id, i + 1 - node.depth);
+                }
+            }
+        }
+    }
+
+private:
+    struct Node {
+        std::map<char, int> children{}; //!< 次の文字毎の遷移先
+        int failure_link = 0; //!< 一致に失敗した時の遷移先 (この節点の最長の真の接尾辞に当たる節点)
+        int output_link = 0; //!< 接尾辞のうちパターンの末尾に当たる最長の節点 (なければ0)
+        int pattern_id = -1; //!< この節点で終わるパターンの番号 (なければ-1)
+        int depth = 0; //!< 根からの文字数
+    };
+
+    std::vector<Node> nodes;
+    std::vector<int> pattern_nodes; //!< パターン番号毎の末尾の節点
+
+    int next_state(int state, char c) const;
+};
@@ -0,0 +1,226 @@
+#pragma once
+
+#include "util/point-2d.h"
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief 外周に番兵を持つ2次元配列クラス
+ *
+ * 要素を外周1マス分の番兵を含めて1つの連続した領域に行優先で格納する。
+ * 番兵は (-1, -1) から (height, width) までの座標で参照でき、
+ * 内部の要素の隣接要素を範囲外チェックなしで参照できる。
+ *
+ * @tparam T 要素の型
+ */
+template <typename T>
+class BorderedArray2D {
+public:
+    /**
+     * @brief 1列分の要素を上から順に走査するためのビュー
+     */
+    template <typename U>
+    class ColumnView {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::remove_const_t<U>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = U *;
+            using reference = U &;
+
+            iterator() = default;
+            iterator(U *ptr, std::ptrdiff_t stride)
+                : ptr_(ptr)
+                , stride_(stride)
+            {
+            }
+
+            reference operator*() const
+            {
+                return *ptr_;
+            }
+
+            pointer operator->() const
+            {
+                return ptr_;
+            }
+
+            iterator &operator++()
+            {
+                ptr_ += stride_;
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                auto it = *this;
+                ++*this;
+                return it;
+            }
+
+            bool operator==(const iterator &other) const
+            {
+                return ptr_ == other.ptr_;
+            }
+
+        private:
+            U *ptr_ = nullptr;
+            std::ptrdiff_t stride_ = 0;
+        };
+
+        ColumnView(U *top, std::ptrdiff_t stride, std::ptrdiff_t length)
+            : top_(top)
+            , stride_(stride)
+            , length_(length)
+        {
+        }
+
+        iterator begin() const
+        {
+            return iterator(top_, stride_);
+        }
+
+        iterator end() const
+        {
+            return iterator(top_ + stride_ * length_, stride_);
+        }
+
+        U &operator[](int y) const
+        {
+            return top_[stride_ * y];
+        }
+
+    private:
+        U *top_;
+        std::ptrdiff_t stride_;
+        std::ptrdiff_t length_;
+    };
+
+    /**
+     * @brief コンストラクタ
+     *
+     * 空の2次元配列を生成する
+     */
+    BorderedArray2D() = default;
+
+    /**
+     * @brief 2次元配列の大きさを変更し、全要素 (番兵を含む) をデフォルト値で初期化する
+     *
+     * @param height 高さ (番兵を含まない)
+     * @param width 幅 (番兵を含まない)
+     */
+    void assign(int height, int width)
+    {
+        height_ = height;
+        width_ = width;
+        stride_ = width + 2;
+        elements_.assign(static_cast<size_t>(stride_) * (height + 2), T{});
+    }
+
+    int height() const
+    {
+        return height_;
+    }
+
+    int width() const
+    {
+        return width_;
+    }
+
+    /**
+     * @brief 1行あたりの要素数 (左右の番兵を含む) を取得する
+     */
+    int stride() const
+    {
+        return stride_;
+    }
+
+    /**
+     * @brief 座標に対応する連続領域上の位置を取得する
+     *
+     * @param pos 座標 (番兵の座標も指定できる)
+     * @return 連続領域上の位置
+     */
+    int get_index(const Pos2D &pos) const
+    {
+        return (pos.y + 1) * stride_ + (pos.x + 1);
+    }
+
+    T &get(const Pos2D &pos)
+    {
+        return elements_[this->get_index(pos)];
+    }
+
+    const T &get(const Pos2D &pos) const
+    {
+        return elements_[this->get_index(pos)];
+    }
+
+    /**
+     * @brief 指定した行の要素 (番兵を含まない) を取得する
+     *
+     * 従来の grid_array[y][x] 形式での参照と互換性を保つ。
+     *
+     * @param y 行
+     * @return 行の要素のspan
+     */
+    std::span<T> operator[](int y)
+    {
+        return this->row(y);
+    }
+
+    std::span<const T> operator[](int y) const
+    {
+        return this->row(y);
+    }
+
+    std::span<T> row(int y)
+    {
+        return std::span<T>(elements_.data() + (y + 1) * stride_ + 1, width_);
+    }
+
+    std::span<const T> row(int y) const
+    {
+        return std::span<const T>(elements_.data() + (y + 1) * stride_ + 1, width_);
+    }
+
+    /**
+     * @brief 指定した列の要素 (番兵を含まない) を上から順に走査するビューを取得する
+     *
+     * @param x 列
+     * @return 列のビュー
+     */
+    ColumnView<T> column(int x)
+    {
+        return ColumnView<T>(elements_.data() + stride_ + x + 1, stride_, height_);
+    }
+
+    ColumnView<const T> column(int x) const
+    {
+        return ColumnView<const T>(elements_.data() + stride_ + x + 1, stride_, height_);
+    }
+
+    /**
+     * @brief 番兵を含む全要素を連続領域として取得する
+     */
+    std::span<T> elements()
+    {
+        return elements_;
+    }
+
+    std::span<const T> elements() const
+    {
+        return elements_;
+    }
+
+private:
+    int height_ = 0;
+    int width_ = 0;
+    int stride_ = 0;
+    std::vector<T> elements_;
+};
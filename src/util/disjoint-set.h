@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 素集合 (Union-Find) クラス
+ *
+ * 0 から size - 1 までの要素を互いに素な集合に分けて保持する。
+ * 集合の併合と代表元の探索をいずれもほぼ定数時間で行う。
+ */
+class DisjointSet {
+public:
+    /**
+     * @brief コンストラクタ
+     *
+     * 要素を持たない素集合を生成する
+     */
+    DisjointSet() = default;
+
+    /**
+     * @brief 要素数を変更し、全ての要素をそれぞれ1つだけからなる集合にする
+     *
+     * @param size 要素数
+     */
+    void assign(size_t size)
+    {
+        parents_.resize(size);
+        std::iota(parents_.begin(), parents_.end(), size_t{ 0 });
+        sizes_.assign(size, 1);
+    }
+
+    /**
+     * @brief 要素が属する集合の代表元を取得する
+     *
+     * @param index 要素
+     * @return 代表元
+     */
+    size_t find(size_t index)
+    {
+        while (parents_[index] != index) {
+            parents_[index] = parents_[parents_[index]];
+            index = parents_[index];
+        }
+
+        return index;
+    }
+
+    /**
+     * @brief 2つの要素が属する集合を併合する
+     *
+     * @return 別の集合だったため併合したか
+     */
+    bool unite(size_t index1, size_t index2)
+    {
+        auto root1 = find(index1);
+        auto root2 = find(index2);
+        if (root1 == root2) {
+            return false;
+        }
+
+        if (sizes_[root1] < sizes_[root2]) {
+            std::swap(root1, root2);
+        }
+
+        parents_[root2] = root1;
+        sizes_[root1] += sizes_[root2];
+        return true;
+    }
+
+    /**
+     * @brief 要素が属する集合の要素数を取得する
+     */
+    size_t size_of(size_t index)
+    {
+        return sizes_[find(index)];
+    }
+
+private:
+    std::vector<size_t> parents_; //!< 親の要素 (代表元は自分自身)
+    std::vector<size_t> sizes_; //!< 代表元についてのみ有効な、集合の要素数
+};
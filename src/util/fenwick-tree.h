@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief 重み付き抽選用のフェニック木 (Binary Indexed Tree) クラス
+ *
+ * 各要素の重みを保持し、重みの更新と累積和の探索をいずれも O(log n) で行う。
+ * 累積和の探索は ProbabilityTable と同じく「累積和が key を超える最初の要素」を返すため、
+ * 同じ乱数値に対して同じ要素が選択される。
+ *
+ * @tparam T 重みの型
+ */
+template <typename T>
+class FenwickTree {
+public:
+    /**
+     * @brief コンストラクタ
+     *
+     * 空のフェニック木を生成する
+     */
+    FenwickTree() = default;
+
+    /**
+     * @brief 要素数を変更し、全要素の重みを0にする
+     *
+     * @param size 要素数
+     */
+    void assign(size_t size)
+    {
+        tree_.assign(size + 1, T{});
+        weights_.assign(size, T{});
+        total_ = T{};
+        mask_ = 1;
+        while (mask_ <= size) {
+            mask_ <<= 1;
+        }
+
+        mask_ >>= 1;
+    }
+
+    size_t size() const
+    {
+        return weights_.size();
+    }
+
+    T total() const
+    {
+        return total_;
+    }
+
+    T get(size_t index) const
+    {
+        return weights_[index];
+    }
+
+    /**
+     * @brief 要素の重みを変更する
+     *
+     * @param index 要素の位置
+     * @param weight 新しい重み
+     */
+    void set(size_t index, T weight)
+    {
+        const auto delta = weight - weights_[index];
+        if (delta == T{}) {
+            return;
+        }
+
+        weights_[index] = weight;
+        total_ += delta;
+        for (auto i = index + 1; i < tree_.size(); i += i & (~i + 1)) {
+            tree_[i] += delta;
+        }
+    }
+
+    /**
+     * @brief 累積和が key を超える最初の要素の位置を取得する
+     *
+     * @param key 0以上 total() 未満の値
+     * @return 要素の位置
+     */
+    size_t find(T key) const
+    {
+        size_t pos = 0;
+        for (auto step = mask_; step > 0; step >>= 1) {
+            const auto next = pos + step;
+            if ((next < tree_.size()) && (tree_[next] <= key)) {
+                pos = next;
+                key -= tree_[next];
+            }
+        }
+
+        return pos;
+    }
+
+private:
+    std::vector<T> tree_{ T{} }; //!< 1始まりの部分和
+    std::vector<T> weights_; //!< 各要素の重み
+    T total_{};
+    size_t mask_ = 0; //!< 探索開始時の刻み幅 (要素数以下の最大の2の冪)
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "system/angband-exceptions.h"
+#include "term/z-rand.h"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief 累積確率テーブルクラス
+ *
+ * 項目を順に登録しておき、先頭から指定した個数までの項目を対象として確率に従った抽選を行うクラス。
+ * 生成階順に並んだ生成テーブルのように抽選対象が常に先頭からの連続区間となる場合に、
+ * テーブルを作り直すことなく O(log n) で抽選できる。
+ * 同じ乱数値に対しては、対象の項目だけを ProbabilityTable に登録した場合と同じ項目が選択される。
+ */
+class PrefixProbabilityTable {
+public:
+    /**
+     * @brief コンストラクタ
+     *
+     * 空の累積確率テーブルを生成する
+     */
+    PrefixProbabilityTable() = default;
+
+    /**
+     * @brief 累積確率テーブルを空にする
+     */
+    void clear()
+    {
+        cumulative_probs_.clear();
+    }
+
+    /**
+     * @brief 累積確率テーブルに項目を登録する
+     *
+     * 項目は登録順に 0, 1, 2... の番号を持つ。
+     * probが0もしくは負数の場合は、選択されることのない項目として登録する。
+     *
+     * @param prob 項目の選択確率
+     */
+    void entry_item(int prob)
+    {
+        const auto cumulative_prob = cumulative_probs_.empty() ? 0 : cumulative_probs_.back();
+        cumulative_probs_.push_back(cumulative_prob + std::max(prob, 0));
+    }
+
+    /**
+     * @brief 登録されている項目の数を取得する
+     */
+    size_t size() const
+    {
+        return cumulative_probs_.size();
+    }
+
+    /**
+     * @brief 先頭から count 個の項目の選択確率の合計を取得する
+     *
+     * @param count 対象とする項目の数
+     * @return int 選択確率の合計
+     */
+    int total_prob(size_t count) const
+    {
+        if (count == 0) {
+            return 0;
+        }
+
+        return cumulative_probs_[count - 1];
+    }
+
+    /**
+     * @brief 先頭から count 個の項目から、確率に従って項目を1つ選択する
+     *
+     * 抽選は独立試行で行われ、選択された項目がテーブルから取り除かれる事はない。
+     * 対象の項目の選択確率の合計が0の場合、std::runtime_error例外を送出する。
+     *
+     * @param count 対象とする項目の数
+     * @return size_t 選択された項目の番号
+     */
+    size_t pick_one_at_random(size_t count) const
+    {
+        const auto total = total_prob(count);
+        if (total <= 0) {
+            THROW_EXCEPTION(std::runtime_error, "There is no entry in the probability table.");
+        }
+
+        const int key = randint0(total);
+        const auto end = cumulative_probs_.begin() + count;
+        return std::distance(cumulative_probs_.begin(), std::upper_bound(cumulative_probs_.begin(), end, key));
+    }
+
+private:
+    /** 先頭から各項目までの選択確率の累積値を格納する配列 */
+    std::vector<int> cumulative_probs_;
+};
@@ -1,21 +1,5 @@
 #include "util/rng-xoshiro.h"
 
-namespace {
-
-/*!
- * @brief 32ビットデータを右ローテートする
- *
- * @param x 右ローテートする32ビットデータ
- * @param k 右ローテートするビット数
- * @return xを右にkビットローテートした32ビットデータを返す
- */
-uint32_t u32b_rotl(uint32_t x, int k)
-{
-    return (x << k) | (x >> (32 - k));
-}
-
-}
-
 /*!
  * @brief デフォルトシードで乱数の内部状態を初期化したXoshiro128StarStarクラスのオブジェクトを生成する
  */
@@ -41,28 +25,40 @@ Xoshiro128StarStar::Xoshiro128StarStar(uint32_t seed)
 }
 
 /*!
- * @brief 次の乱数を生成し、内部状態を更新する
- *
- * @return 生成した乱数を返す
+ * @brief 内部状態を 2^64 回分の乱数生成に相当するだけ先へ進める
+ * @details 元の乱数列と重ならない独立した乱数列を得るために用いる.
+ * 係数は xoshiro128** の作者による jump() の実装 (https://prng.di.unimi.it/xoshiro128starstar.c) に従う.
  */
-Xoshiro128StarStar::result_type Xoshiro128StarStar::operator()()
+void Xoshiro128StarStar::jump()
 {
-    auto &s = this->rng_state;
+    static constexpr state_type jump_table{ { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b } };
+    state_type state{};
+    for (const auto jump_bits : jump_table) {
+        for (auto b = 0; b < 32; b++) {
+            if (jump_bits & (1U << b)) {
+                for (auto i = 0U; i < state.size(); i++) {
+                    state[i] ^= this->rng_state[i];
+                }
+            }
 
-    const uint32_t result = u32b_rotl(s[1] * 5, 7) * 9;
-
-    const uint32_t t = s[1] << 9;
-
-    s[2] ^= s[0];
-    s[3] ^= s[1];
-    s[1] ^= s[2];
-    s[0] ^= s[3];
-
-    s[2] ^= t;
+            (*this)();
+        }
+    }
 
-    s[3] = u32b_rotl(s[3], 11);
+    this->rng_state = state;
+}
 
-    return result;
+/*!
+ * @brief 独立した乱数列を分岐させる
+ * @return これまでの乱数列の続きを生成する乱数生成器
+ * @details 自身は jump() で 2^64 回分先へ進むため、分岐させた乱数列と自身のその後の乱数列は重ならない.
+ * 繰り返し呼ぶと互いに重ならない乱数列を次々に得られる.
+ */
+Xoshiro128StarStar Xoshiro128StarStar::fork()
+{
+    const auto forked = *this;
+    this->jump();
+    return forked;
 }
 
 /*!
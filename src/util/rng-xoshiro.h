@@ -33,6 +33,9 @@ public:
     }
 
     result_type operator()();
+    result_type bounded(result_type bound);
+    void jump();
+    Xoshiro128StarStar fork();
 
     void set_state(uint32_t seed);
 
@@ -41,4 +44,69 @@ public:
 
 private:
     state_type rng_state; //!< RNG state
+
+    static uint32_t rotl(uint32_t x, int k);
 };
+
+/*
+ * 以下は randint0() や damroll() から乱数1個毎に呼ばれるため、インライン展開できるようヘッダで定義する.
+ */
+
+/*!
+ * @brief 32ビットデータを左ローテートする
+ *
+ * @param x 左ローテートする32ビットデータ
+ * @param k 左ローテートするビット数
+ * @return xを左にkビットローテートした32ビットデータを返す
+ */
+inline uint32_t Xoshiro128StarStar::rotl(uint32_t x, int k)
+{
+    return (x << k) | (x >> (32 - k));
+}
+
+/*!
+ * @brief 次の乱数を生成し、内部状態を更新する
+ *
+ * @return 生成した乱数を返す
+ */
+inline Xoshiro128StarStar::result_type Xoshiro128StarStar::operator()()
+{
+    auto &s = this->rng_state;
+
+    const uint32_t result = rotl(s[1] * 5, 7) * 9;
+
+    const uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+
+    s[2] ^= t;
+
+    s[3] = rotl(s[3], 11);
+
+    return result;
+}
+
+/*!
+ * @brief 0以上bound未満の一様乱数を生成する
+ * @param bound 上限 (0より大きいこと)
+ * @return 生成した乱数
+ * @details 乱数と上限の積の上位32ビットを用いる Lemire の方法で、偏りを生む一部の乱数だけを捨てて引き直す.
+ * 剰余を求めるのは下位32ビットが上限未満の時だけなので、ほとんどの場合は乗算1回で済む.
+ */
+inline Xoshiro128StarStar::result_type Xoshiro128StarStar::bounded(result_type bound)
+{
+    auto product = static_cast<uint64_t>((*this)()) * bound;
+    auto low = static_cast<uint32_t>(product);
+    if (low < bound) {
+        const auto threshold = (0U - bound) % bound;
+        while (low < threshold) {
+            product = static_cast<uint64_t>((*this)()) * bound;
+            low = static_cast<uint32_t>(product);
+        }
+    }
+
+    return static_cast<result_type>(product >> 32);
+}
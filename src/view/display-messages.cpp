@@ -11,11 +11,11 @@
 #include "term/gameterm.h"
 #include "term/term-color-types.h"
 #include "util/int-char-converter.h"
+#include "view/message-history.h"
 #include "world/world.h"
-#include <deque>
-#include <map>
 #include <memory>
 #include <string>
+#include <utility>
 
 /* Used in msg_print() for "buffering" */
 bool msg_flag;
@@ -27,43 +27,11 @@ namespace {
 /*! 表示するメッセージの先頭位置 */
 static int msg_head_pos = 0;
 
-using msg_sp = std::shared_ptr<const std::string>;
-using msg_wp = std::weak_ptr<const std::string>;
-
-/** メッセージが同一かどうかを比較するためのラムダ式 */
-auto string_ptr_cmp = [](const std::string *a, const std::string *b) { return *a < *b; };
-
-/** 同一メッセージの検索に使用するmapオブジェクト。
- * 同一メッセージがあるかどうかを検索し、ヒットしたらweak_ptrからshared_ptrを作成しメッセージを共有する。
- * message_historyのカスタムデリータの中で参照するので、message_historyより先に宣言しなければならない事に注意。
- */
-std::map<const std::string *, msg_wp, decltype(string_ptr_cmp)> message_map(string_ptr_cmp);
-
 /** メッセージ履歴 */
-std::deque<msg_sp> message_history;
-
-/**
- * @brief メッセージを保持する msg_sp オブジェクトを生成する
- *
- * @tparam T メッセージの型。std::string / std::string_view / const char* 等
- * @param str メッセージ
- * @return 生成した msg_sp オブジェクト
- */
-template <typename T>
-msg_sp make_message(T &&str)
-{
-    /** std::stringオブジェクトと同時にmessage_mapのエントリも削除するカスタムデリータ */
-    auto deleter = [](std::string *s) {
-        message_map.erase(s);
-        delete s;
-    };
+MessageHistory message_history(MESSAGE_MAX - 1);
 
-    // 新たにメッセージを保持する msg_sp オブジェクトを生成し、検索用mapオブジェクトにも追加する
-    auto new_msg = msg_sp(new std::string(std::forward<T>(str)), std::move(deleter));
-    message_map.emplace(new_msg.get(), msg_wp(new_msg));
-
-    return new_msg;
-}
+/*! 表示せずに溜めておくメッセージの格納先 (溜めていなければnullptr) */
+thread_local std::vector<std::string> *captured_messages = nullptr;
 }
 
 /*!
@@ -82,81 +50,37 @@ int32_t message_num(void)
  */
 std::shared_ptr<const std::string> message_str(int age)
 {
-    if ((age < 0) || (age >= message_num())) {
-        return std::make_shared<const std::string>("");
-    }
-
-    return message_history[age];
+    return std::make_shared<const std::string>(message_history.get(age));
 }
 
-static void message_add_aux(std::string str)
+/*!
+ * @brief ゲームメッセージをログに追加する。 / Add a new message, with great efficiency
+ * @param msg 保存したいメッセージ
+ * @details 直前と同じメッセージの場合、「～ <xNN>」と表示する
+ */
+void message_add(std::string_view msg)
 {
-    if (str.empty()) {
+    if (msg.empty()) {
         return;
     }
 
-    // 直前と同じメッセージの場合、「～ <xNN>」と表示する
-    if (!message_history.empty()) {
-        const char *t;
-        std::string_view last_message = *message_history.front();
-#ifdef JP
-        for (t = last_message.data(); *t && (*t != '<' || (*(t + 1) != 'x')); t++) {
-            if (iskanji(*t)) {
-                t++;
-            }
-        }
-#else
-        for (t = last_message.data(); *t && (*t != '<'); t++) {
-            ;
-        }
-#endif
-        int j = 1;
-        if (*t && t != last_message.data()) {
-            if (last_message.length() >= sizeof(" <xN>") - 1) {
-                last_message = last_message.substr(0, t - last_message.data() - 1);
-                j = atoi(t + 2);
-            }
-        }
+    const auto is_first = message_history.size() == 0;
+    const auto is_repeated = message_history.add(msg);
+    if (is_first) {
+        return;
+    }
 
-        if (str == last_message && (j < 1000)) {
-            str = format("%s <x%d>", str.data(), j + 1);
-            message_history.pop_front();
-            if (!now_message) {
-                now_message++;
-            }
-        } else {
-            /*流れた行の数を数えておく */
-            num_more++;
+    if (is_repeated) {
+        if (!now_message) {
             now_message++;
         }
-    }
-
-    msg_sp add_msg;
-
-    // メッセージ履歴から同一のメッセージを探す
-    if (const auto &it = message_map.find(&str); it != message_map.end()) {
-        // 同一のメッセージが見つかったならそのメッセージの msg_sp オブジェクトを複製
-        add_msg = it->second.lock();
-    } else {
-        // 見つからなかった場合は新たに msg_sp オブジェクトを作成
-        add_msg = make_message(std::move(str));
-    }
 
-    // メッセージ履歴に追加
-    message_history.push_front(std::move(add_msg));
-
-    if (message_history.size() == MESSAGE_MAX) {
-        message_history.pop_back();
+        return;
     }
-}
 
-/*!
- * @brief ゲームメッセージをログに追加する。 / Add a new message, with great efficiency
- * @param msg 保存したいメッセージ
- */
-void message_add(std::string_view msg)
-{
-    message_add_aux(std::string(msg));
+    /*流れた行の数を数えておく */
+    num_more++;
+    now_message++;
 }
 
 bool is_msg_window_flowed(void)
@@ -292,6 +216,11 @@ static int split_length(std::string_view sv, int max)
  */
 void msg_print(std::string_view msg)
 {
+    if (captured_messages != nullptr) {
+        captured_messages->emplace_back(msg);
+        return;
+    }
+
     if (w_ptr->timewalk_m_idx) {
         return;
     }
@@ -344,7 +273,7 @@ void msg_print(std::string_view msg)
 
 void msg_print(std::nullptr_t)
 {
-    if (w_ptr->timewalk_m_idx) {
+    if ((captured_messages != nullptr) || w_ptr->timewalk_m_idx) {
         return;
     }
 
@@ -369,3 +298,23 @@ void msg_format(const char *fmt, ...)
     va_end(vp);
     msg_print(buf);
 }
+
+MessageCapture::MessageCapture()
+    : previous_messages(captured_messages)
+{
+    captured_messages = &this->messages;
+}
+
+MessageCapture::~MessageCapture()
+{
+    captured_messages = this->previous_messages;
+}
+
+/*!
+ * @brief 溜めたメッセージを取り出す
+ * @return 溜めたメッセージのリスト
+ */
+std::vector<std::string> MessageCapture::take_messages()
+{
+    return std::exchange(this->messages, {});
+}
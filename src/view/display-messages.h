@@ -5,6 +5,7 @@
 #include <memory>
 #include <string>
 #include <string_view>
+#include <vector>
 
 /*
  * OPTION: Maximum number of messages to remember (see "io.c")
@@ -22,3 +23,23 @@ void msg_erase();
 void msg_print(std::string_view msg);
 void msg_print(std::nullptr_t);
 void msg_format(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+/*!
+ * @brief 作ったスレッドで表示しようとしたメッセージを、端末に出さずに溜めておくスコープ
+ * @details メインスレッド以外で動く処理から端末を操作しないために用いる. 溜めたメッセージはメインスレッドで表示し直す.
+ */
+class MessageCapture {
+public:
+    MessageCapture();
+    ~MessageCapture();
+    MessageCapture(const MessageCapture &) = delete;
+    MessageCapture(MessageCapture &&) = delete;
+    MessageCapture &operator=(const MessageCapture &) = delete;
+    MessageCapture &operator=(MessageCapture &&) = delete;
+
+    std::vector<std::string> take_messages();
+
+private:
+    std::vector<std::string> messages;
+    std::vector<std::string> *previous_messages;
+};
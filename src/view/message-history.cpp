@@ -0,0 +1,195 @@
+#include "view/message-history.h"
+#include <charconv>
+#include <functional>
+#include <utility>
+
+namespace {
+constexpr auto MAX_REPEAT_COUNT = 1000; //!< 1つにまとめる連続したメッセージの最大数
+constexpr size_t MIN_COMPACTION_LENGTH = 64 * 1024; //!< 詰め直しを行う格納領域の最小の長さ
+constexpr std::string_view REPEAT_PREFIX = " <x";
+
+/*!
+ * @brief 「～ <xN>」形式のメッセージを本文と回数に分ける
+ * @param msg メッセージ
+ * @return 本文と回数
+ * @details セーブファイルから読み込んだメッセージのためのもの. MessageHistory::get() で元の文字列に戻せる場合だけ分ける.
+ */
+std::pair<std::string_view, int> split_repeat_count(std::string_view msg)
+{
+    if (!msg.ends_with('>')) {
+        return { msg, 1 };
+    }
+
+    const auto pos = msg.rfind(REPEAT_PREFIX);
+    if (pos == std::string_view::npos) {
+        return { msg, 1 };
+    }
+
+    const auto digits = msg.substr(pos + REPEAT_PREFIX.length(), msg.length() - pos - REPEAT_PREFIX.length() - 1);
+    if (digits.empty() || (digits.length() > 9) || (digits.front() == '0')) {
+        return { msg, 1 };
+    }
+
+    auto count = 0;
+    const auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.length(), count);
+    if ((ec != std::errc{}) || (ptr != digits.data() + digits.length()) || (count < 2)) {
+        return { msg, 1 };
+    }
+
+    return { msg.substr(0, pos), count };
+}
+}
+
+/*!
+ * @brief メッセージ履歴を作る
+ * @param capacity 保持するメッセージの最大数
+ */
+MessageHistory::MessageHistory(int capacity)
+    : capacity(capacity)
+{
+}
+
+/*!
+ * @brief 保持しているメッセージの数を返す
+ */
+int MessageHistory::size() const
+{
+    return static_cast<int>(this->entries.size());
+}
+
+/*!
+ * @brief メッセージを追加する
+ * @param msg メッセージ
+ * @return 直前のメッセージと同じで、それにまとめたか
+ * @details 最大数に達していたら最も古いメッセージを捨てる.
+ */
+bool MessageHistory::add(std::string_view msg)
+{
+    const auto [text, count] = split_repeat_count(msg);
+    if ((count == 1) && (this->newest >= 0)) {
+        auto &newest_entry = this->entries[this->newest];
+        if ((newest_entry.count < MAX_REPEAT_COUNT) && (this->text_of(newest_entry.text_id) == text)) {
+            newest_entry.count++;
+            return true;
+        }
+    }
+
+    const Entry entry{ this->intern(text), count };
+    if (this->size() < this->capacity) {
+        this->entries.push_back(entry);
+        this->newest = this->size() - 1;
+        return false;
+    }
+
+    this->newest = (this->newest + 1) % this->capacity;
+    this->release(this->entries[this->newest].text_id);
+    this->entries[this->newest] = entry;
+    return false;
+}
+
+/*!
+ * @brief メッセージを返す
+ * @param age メッセージの世代 (0が最新)
+ * @return メッセージ (範囲外なら空文字列)
+ */
+std::string MessageHistory::get(int age) const
+{
+    if ((age < 0) || (age >= this->size())) {
+        return "";
+    }
+
+    const auto &entry = this->entries[(this->newest - age + this->capacity) % this->capacity];
+    std::string msg(this->text_of(entry.text_id));
+    if (entry.count > 1) {
+        msg.append(REPEAT_PREFIX).append(std::to_string(entry.count)).append(">");
+    }
+
+    return msg;
+}
+
+std::string_view MessageHistory::text_of(int text_id) const
+{
+    const auto &text = this->texts[text_id];
+    return std::string_view(this->arena).substr(text.offset, text.length);
+}
+
+/*!
+ * @brief 文字列をプールに登録する
+ * @param text 文字列
+ * @return プール中の文字列の番号
+ * @details 同じ文字列が登録済ならその参照数を増やす.
+ */
+int MessageHistory::intern(std::string_view text)
+{
+    const auto hash = std::hash<std::string_view>{}(text);
+    const auto [first, last] = this->text_ids.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+        if (this->text_of(it->second) == text) {
+            this->texts[it->second].refs++;
+            return it->second;
+        }
+    }
+
+    const PooledText pooled{ this->arena.length(), text.length(), hash, 1 };
+    this->arena.append(text);
+    this->live_length += text.length();
+    auto text_id = static_cast<int>(this->texts.size());
+    if (this->free_text_ids.empty()) {
+        this->texts.push_back(pooled);
+    } else {
+        text_id = this->free_text_ids.back();
+        this->free_text_ids.pop_back();
+        this->texts[text_id] = pooled;
+    }
+
+    this->text_ids.emplace(hash, text_id);
+    return text_id;
+}
+
+/*!
+ * @brief プール中の文字列の参照数を減らす
+ * @param text_id プール中の文字列の番号
+ * @details 参照されなくなった文字列は索引から外し、番号を再利用する.
+ * 参照されていない文字列の分が格納領域の半分を超えたら詰め直す.
+ */
+void MessageHistory::release(int text_id)
+{
+    auto &text = this->texts[text_id];
+    if (--text.refs > 0) {
+        return;
+    }
+
+    const auto [first, last] = this->text_ids.equal_range(text.hash);
+    for (auto it = first; it != last; ++it) {
+        if (it->second == text_id) {
+            this->text_ids.erase(it);
+            break;
+        }
+    }
+
+    this->live_length -= text.length;
+    this->free_text_ids.push_back(text_id);
+    if ((this->arena.length() >= MIN_COMPACTION_LENGTH) && (this->arena.length() - this->live_length > this->live_length)) {
+        this->compact();
+    }
+}
+
+/*!
+ * @brief 参照されている文字列だけを格納領域に詰め直す
+ */
+void MessageHistory::compact()
+{
+    std::string compacted;
+    compacted.reserve(this->live_length * 2);
+    for (auto &text : this->texts) {
+        if (text.refs == 0) {
+            continue;
+        }
+
+        const auto offset = compacted.length();
+        compacted.append(this->arena, text.offset, text.length);
+        text.offset = offset;
+    }
+
+    this->arena = std::move(compacted);
+}
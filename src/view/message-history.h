@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/*!
+ * @brief メッセージ履歴
+ * @details 固定長のリングバッファに、文字列プール中の文字列の番号と連続して追加された回数を保持する.
+ * 同じ文字列はプール中で1つにまとめ、ハッシュ値で検索する.
+ * プールの文字列は1つの領域に詰めて格納し、どのメッセージからも参照されなくなった文字列の分が増えたら詰め直す.
+ * 連続した回数が2以上のメッセージは「～ <xN>」として返す.
+ */
+class MessageHistory {
+public:
+    explicit MessageHistory(int capacity);
+
+    int size() const;
+    bool add(std::string_view msg);
+    std::string get(int age) const;
+
+private:
+    /*!
+     * @brief プール中の文字列
+     */
+    struct PooledText {
+        size_t offset; //!< 格納領域中の位置
+        size_t length; //!< 長さ
+        size_t hash; //!< ハッシュ値
+        int refs; //!< この文字列を参照しているメッセージの数 (0なら空き番号)
+    };
+
+    /*!
+     * @brief リングバッファ中のメッセージ
+     */
+    struct Entry {
+        int text_id; //!< プール中の文字列の番号
+        int count; //!< 連続して追加された回数
+    };
+
+    int capacity;
+    std::vector<Entry> entries; //!< リングバッファ
+    int newest = -1; //!< 最も新しいメッセージの位置
+
+    std::string arena; //!< プールの文字列を詰めて格納する領域
+    size_t live_length = 0; //!< 参照されている文字列の長さの合計
+    std::vector<PooledText> texts;
+    std::vector<int> free_text_ids;
+    std::unordered_multimap<size_t, int> text_ids; //!< ハッシュ値からプール中の文字列の番号への索引
+
+    std::string_view text_of(int text_id) const;
+    int intern(std::string_view text);
+    void release(int text_id);
+    void compact();
+};
@@ -44,7 +44,7 @@
 /*!
  * @brief デバグコマンド一覧表
  * @details
- * 空き: A,B,E,I,J,k,K,L,M,q,Q,R,T,U,V,W,y,Y
+ * 空き: A,B,E,I,J,k,K,L,M,q,Q,R,T,U,W,y,Y
  */
 constexpr std::array debug_menu_table = {
     std::make_tuple('a', _("全状態回復", "Restore all status")),
@@ -76,6 +76,7 @@ constexpr std::array debug_menu_table = {
     std::make_tuple('S', _("フロア相当のモンスター召喚", "Summon monster which be in target depth")),
     std::make_tuple('t', _("テレポート", "Teleport self")),
     std::make_tuple('u', _("啓蒙(忍者以外)", "Wiz-lite all floor except Ninja")),
+    std::make_tuple('V', _("アイテム表記キャッシュの統計を表示", "Show item description cache statistics")),
     std::make_tuple('w', _("啓蒙(忍者配慮)", "Wiz-lite all floor")),
     std::make_tuple('x', _("経験値を得る(指定可)", "Get experience")),
     std::make_tuple('X', _("所持品を初期状態に戻す", "Return inventory to initial")),
@@ -248,6 +249,9 @@ bool exe_cmd_debug(PlayerType *player_ptr, char cmd)
 
         wiz_lite(player_ptr, false);
         return true;
+    case 'V':
+        wiz_show_item_description_cache_stats();
+        return true;
     case 'w':
         wiz_lite(player_ptr, PlayerClass(player_ptr).equals(PlayerClassType::NINJA));
         return true;
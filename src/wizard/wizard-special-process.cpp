@@ -22,6 +22,7 @@
 #include "core/window-redrawer.h"
 #include "dungeon/quest.h"
 #include "flavor/flavor-describer.h"
+#include "flavor/item-description-cache.h"
 #include "flavor/object-flavor-types.h"
 #include "floor/floor-leaver.h"
 #include "floor/floor-mode-changer.h"
@@ -697,6 +698,23 @@ void wiz_dump_options(void)
     msg_format(_("オプションbit使用状況をファイル %s に書き出しました。", "Option bits usage dump saved to file %s."), filename.data());
 }
 
+/*!
+ * @brief アイテム表記キャッシュの統計を表示し、カウンタを0に戻す
+ */
+void wiz_show_item_description_cache_stats()
+{
+    auto &cache = ItemDescriptionCache::get_instance();
+    const auto hits = static_cast<unsigned long long>(cache.get_hit_count());
+    const auto misses = static_cast<unsigned long long>(cache.get_miss_count());
+    const auto uncacheables = static_cast<unsigned long long>(cache.get_uncacheable_count());
+    const auto total = hits + misses + uncacheables;
+    const auto rate = (total > 0) ? 100.0 * hits / total : 0.0;
+    msg_format(_("アイテム表記: %llu/%llu回をキャッシュから返した (%.1f%%, 未登録 %llu回, キャッシュ不可 %llu回)",
+                   "Item descriptions: %llu of %llu from cache (%.1f%%, %llu misses, %llu uncacheable)"),
+        hits, total, rate, misses, uncacheables);
+    cache.reset_counts();
+}
+
 /*!
  * @brief プレイ日数を変更する / Set gametime.
  * @return 実際に変更を行ったらTRUEを返す
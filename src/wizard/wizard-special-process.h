@@ -14,6 +14,7 @@ void wiz_reset_race(PlayerType *player_ptr);
 void wiz_reset_class(PlayerType *player_ptr);
 void wiz_reset_realms(PlayerType *player_ptr);
 void wiz_dump_options();
+void wiz_show_item_description_cache_stats();
 void set_gametime();
 void wiz_zap_surrounding_monsters(PlayerType *player_ptr);
 void wiz_zap_floor_monsters(PlayerType *player_ptr);
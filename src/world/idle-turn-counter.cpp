@@ -0,0 +1,55 @@
+#include "world/idle-turn-counter.h"
+#include <algorithm>
+#include <limits>
+
+/*!
+ * @brief コンストラクタ
+ * @param max_turns 数えるゲームターン数の上限
+ */
+IdleTurnCounter::IdleTurnCounter(int max_turns)
+    : turns(std::max(max_turns, 0))
+{
+}
+
+/*!
+ * @brief 行動エネルギーを登録する
+ * @param energy_need 行動までに必要なエネルギー
+ * @param energy_gain 1ゲームターン毎に減るエネルギー
+ */
+void IdleTurnCounter::add_energy(int energy_need, int energy_gain)
+{
+    this->limit(calc_idle_turns(energy_need, energy_gain));
+}
+
+/*!
+ * @brief 何かが起こるまでのゲームターン数を登録する
+ * @param turns 何も起こらずに経過するゲームターン数
+ */
+void IdleTurnCounter::limit(int turns)
+{
+    this->turns = std::clamp(turns, 0, this->turns);
+}
+
+int IdleTurnCounter::get_turns() const
+{
+    return this->turns;
+}
+
+/*!
+ * @brief 行動エネルギーが0以下にならずに経過するゲームターン数を求める
+ * @param energy_need 行動までに必要なエネルギー
+ * @param energy_gain 1ゲームターン毎に減るエネルギー
+ * @return ゲームターン数 (エネルギーが減らないなら int の最大値)
+ */
+int IdleTurnCounter::calc_idle_turns(int energy_need, int energy_gain)
+{
+    if (energy_need <= 0) {
+        return 0;
+    }
+
+    if (energy_gain <= 0) {
+        return std::numeric_limits<int>::max();
+    }
+
+    return (energy_need - 1) / energy_gain;
+}
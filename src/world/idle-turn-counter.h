@@ -0,0 +1,21 @@
+#pragma once
+
+/*!
+ * @brief 誰も行動せずに経過するゲームターンの数を数えるクラス
+ * @details 行動エネルギーはゲームターン毎に一定量ずつ減り、0以下になったゲームターンに行動する.
+ * プレイヤーやモンスター等の行動エネルギーと、その他の処理が起こるまでのゲームターン数を登録し、
+ * そのいずれも起こらないまま経過するゲームターンの数を求める.
+ */
+class IdleTurnCounter {
+public:
+    IdleTurnCounter(int max_turns);
+
+    void add_energy(int energy_need, int energy_gain);
+    void limit(int turns);
+    int get_turns() const;
+
+    static int calc_idle_turns(int energy_need, int energy_gain);
+
+private:
+    int turns; //!< 誰も行動せずに経過するゲームターンの数
+};
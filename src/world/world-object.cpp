@@ -8,10 +8,47 @@
 #include "system/floor-type-definition.h"
 #include "system/item-entity.h"
 #include "system/player-type-definition.h"
-#include "util/probability-table.h"
+#include "system/system-variables.h"
+#include "util/bit-flags-calculator.h"
+#include "util/prefix-probability-table.h"
 #include "view/display-messages.h"
 #include "world/world.h"
-#include <iterator>
+#include <algorithm>
+#include <map>
+#include <utility>
+
+namespace {
+using ObjIndexHook = bool (*)(short bi_id);
+
+/*!
+ * @brief 直前の get_obj_index_prep() で適用された生成制約関数
+ * @details alloc_kind_table の prob2 はこの関数のみによって決まる
+ */
+ObjIndexHook prepared_hook = nullptr;
+
+/*!
+ * @brief 生成制約関数と宝箱の生成禁止の有無ごとの、alloc_kind_table 全体の累積確率テーブル
+ * @details alloc_kind_table は生成階順に並んでいるため、生成階以下の候補は常に先頭からの連続区間となる.
+ * そのため生成階ごとにテーブルを作る必要はなく、区間の長さを変えるだけで抽選できる.
+ */
+std::map<std::pair<ObjIndexHook, bool>, PrefixProbabilityTable> prob_tables;
+
+const PrefixProbabilityTable &get_obj_index_table(bool forbid_chest)
+{
+    auto [it, is_inserted] = prob_tables.try_emplace({ prepared_hook, forbid_chest });
+    auto &prob_table = it->second;
+    if (!is_inserted) {
+        return prob_table;
+    }
+
+    for (const auto &entry : alloc_kind_table) {
+        const auto is_chest = entry.get_baseitem().bi_key.tval() == ItemKindType::CHEST;
+        prob_table.entry_item((forbid_chest && is_chest) ? 0 : entry.prob2);
+    }
+
+    return prob_table;
+}
+}
 
 /*!
  * @brief グローバルオブジェクト配列から空きを取得する /
@@ -47,6 +84,26 @@ OBJECT_IDX o_pop(FloorType *floor_ptr)
     return 0;
 }
 
+/*!
+ * @brief オブジェクト生成テーブルに生成制約を加える /
+ * Apply a "object restriction function" to the "object allocation table"
+ * @return 常に0を返す。
+ * @details 生成の制約はグローバルのget_obj_index_hook関数ポインタで加える
+ */
+errr get_obj_index_prep()
+{
+    for (auto &entry : alloc_kind_table) {
+        if (!get_obj_index_hook || (*get_obj_index_hook)(entry.index)) {
+            entry.prob2 = entry.prob1;
+        } else {
+            entry.prob2 = 0;
+        }
+    }
+
+    prepared_hook = get_obj_index_hook;
+    return 0;
+}
+
 /*!
  * @brief オブジェクト生成テーブルからアイテムを取得する /
  * Choose an object kind that seems "appropriate" to the given level
@@ -78,24 +135,13 @@ OBJECT_IDX get_obj_index(const FloorType *floor_ptr, DEPTH level, BIT_FLAGS mode
         }
     }
 
-    // 候補の確率テーブル生成
-    ProbabilityTable<int> prob_table;
-    for (auto i = 0U; i < alloc_kind_table.size(); i++) {
-        const auto &entry = alloc_kind_table[i];
-        if (entry.level > level) {
-            break;
-        }
-
-        const auto &baseitem = entry.get_baseitem();
-        if ((mode & AM_FORBID_CHEST) && (baseitem.bi_key.tval() == ItemKindType::CHEST)) {
-            continue;
-        }
-
-        prob_table.entry_item(i, entry.prob2);
-    }
+    // 候補の確率テーブル取得 (生成階以下の候補は先頭からの連続区間)
+    const auto &prob_table = get_obj_index_table(any_bits(mode, AM_FORBID_CHEST));
+    const auto end = std::partition_point(alloc_kind_table.begin(), alloc_kind_table.end(), [level](const auto &entry) { return entry.level <= level; });
+    const auto count = static_cast<size_t>(std::distance(alloc_kind_table.begin(), end));
 
     // 候補なし
-    if (prob_table.empty()) {
+    if (prob_table.total_prob(count) == 0) {
         return 0;
     }
 
@@ -110,10 +156,13 @@ OBJECT_IDX get_obj_index(const FloorType *floor_ptr, DEPTH level, BIT_FLAGS mode
         n++;
     }
 
-    std::vector<int> result;
-    ProbabilityTable<int>::lottery(std::back_inserter(result), prob_table, n);
-
-    auto it = std::max_element(result.begin(), result.end(), [](int a, int b) { return alloc_kind_table[a].level < alloc_kind_table[b].level; });
+    auto result = prob_table.pick_one_at_random(count);
+    for (auto i = 1; i < n; i++) {
+        const auto candidate = prob_table.pick_one_at_random(count);
+        if (alloc_kind_table[result].level < alloc_kind_table[candidate].level) {
+            result = candidate;
+        }
+    }
 
-    return alloc_kind_table[*it].index;
+    return alloc_kind_table[result].index;
 }
@@ -4,4 +4,5 @@
 
 class FloorType;
 OBJECT_IDX o_pop(FloorType *floor_ptr);
+errr get_obj_index_prep();
 OBJECT_IDX get_obj_index(const FloorType *floor_ptr, DEPTH level, BIT_FLAGS mode);
@@ -42,6 +42,7 @@
 #include "util/bit-flags-calculator.h"
 #include "view/display-messages.h"
 #include "window/main-window-row-column.h"
+#include "world/idle-turn-counter.h"
 #include "world/world-movement-processor.h"
 #include "world/world.h"
 
@@ -97,6 +98,26 @@ void WorldTurnProcessor::process_world()
     execute_floor_reset(this->player_ptr);
 }
 
+/*!
+ * @brief ゲーム世界全体の処理が何もせずに経過するゲームターン数を数える
+ * @param counter ゲームターン数を数えるカウンタ
+ * @details 10ゲームターン毎の処理の他、ダンジョンの雰囲気の更新等、毎ゲームターン判定する処理が起こるまでを数える.
+ */
+void WorldTurnProcessor::count_idle_turns(IdleTurnCounter &counter) const
+{
+    const auto *floor_ptr = this->player_ptr->current_floor_ptr;
+    auto is_idle = !AngbandSystem::get_instance().is_phase_out();
+    is_idle &= !ironman_downward || (floor_ptr->dungeon_idx == DUNGEON_ANGBAND) || (floor_ptr->dungeon_idx == 0);
+    if (!is_idle) {
+        counter.limit(0);
+        return;
+    }
+
+    const int turns_in_tick = w_ptr->game_turn % TURNS_PER_TICK;
+    counter.limit((turns_in_tick == 0) ? 0 : TURNS_PER_TICK - turns_in_tick);
+    counter.limit(count_turns_before_dungeon_feeling(this->player_ptr));
+}
+
 /*!
  * @brief ゲーム時刻を表示する /
  * Print time
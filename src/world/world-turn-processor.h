@@ -1,5 +1,6 @@
 #pragma once
 
+class IdleTurnCounter;
 class PlayerType;
 class WorldTurnProcessor {
 public:
@@ -7,6 +8,7 @@ public:
     virtual ~WorldTurnProcessor() = default;
     void process_world();
     void print_time();
+    void count_idle_turns(IdleTurnCounter &counter) const;
 
 private:
     PlayerType *player_ptr;